@@ -274,6 +274,17 @@ cleanup:
     return mod;
 }
 
+/**
+ * @brief Callback for comparing two module hash table records.
+ */
+static ly_bool
+ly_ctx_ht_mod_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lys_module *mod1 = *(struct lys_module **)val1_p, *mod2 = *(struct lys_module **)val2_p;
+
+    return mod1 == mod2;
+}
+
 LIBYANG_API_DEF LY_ERR
 ly_ctx_new(const char *search_dir, uint32_t options, struct ly_ctx **new_ctx)
 {
@@ -295,6 +306,12 @@ ly_ctx_new(const char *search_dir, uint32_t options, struct ly_ctx **new_ctx)
     /* dictionary */
     lydict_init(&ctx->dict);
 
+    /* module hash tables */
+    ctx->mod_name_ht = lyht_new(LYHT_MIN_SIZE, sizeof(struct lys_module *), ly_ctx_ht_mod_equal_cb, NULL, 1);
+    LY_CHECK_ERR_GOTO(!ctx->mod_name_ht, rc = LY_EMEM, cleanup);
+    ctx->mod_ns_ht = lyht_new(LYHT_MIN_SIZE, sizeof(struct lys_module *), ly_ctx_ht_mod_equal_cb, NULL, 1);
+    LY_CHECK_ERR_GOTO(!ctx->mod_ns_ht, rc = LY_EMEM, cleanup);
+
     /* plugins */
     builtin_plugins_only = (options & LY_CTX_BUILTIN_PLUGINS_ONLY) ? 1 : 0;
     static_plugins_only = (options & LY_CTX_STATIC_PLUGINS_ONLY) ? 1 : 0;
@@ -655,6 +672,13 @@ ly_ctx_set_options(struct ly_ctx *ctx, uint32_t option)
         LY_CHECK_ERR_RET(!ctx_data->leafref_links_ht, LOGARG(ctx, option), LY_EMEM);
     }
 
+    if (!(ctx->opts & LY_CTX_XPATH_DESC_INDEX) && (option & LY_CTX_XPATH_DESC_INDEX)) {
+        ctx_data = ly_ctx_shared_data_get(ctx);
+        ctx_data->desc_index_ht = lyht_new(LYHT_MIN_SIZE, sizeof(struct lyd_desc_index_rec),
+                ly_ctx_ht_desc_index_equal_cb, NULL, 1);
+        LY_CHECK_ERR_RET(!ctx_data->desc_index_ht, LOGMEM(ctx), LY_EMEM);
+    }
+
     if (!(ctx->opts & LY_CTX_LYB_HASHES) && (option & LY_CTX_LYB_HASHES)) {
         for (i = 0; i < ctx->modules.count; ++i) {
             mod = ctx->modules.objs[i];
@@ -718,6 +742,14 @@ ly_ctx_unset_options(struct ly_ctx *ctx, uint32_t option)
         ctx_data->leafref_links_ht = NULL;
     }
 
+    if ((ctx->opts & LY_CTX_XPATH_DESC_INDEX) && (option & LY_CTX_XPATH_DESC_INDEX)) {
+        /* the indexes are not used without the option, so drop them all */
+        ctx_data = ly_ctx_shared_data_get(ctx);
+        lyht_free(ctx_data->desc_index_ht, lyd_desc_index_rec_free);
+        ctx_data->desc_index_ht = NULL;
+        ATOMIC_STORE_RELAXED(ctx_data->desc_index_count, 0);
+    }
+
     if ((ctx->opts & LY_CTX_SET_PRIV_PARSED) && (option & LY_CTX_SET_PRIV_PARSED)) {
         struct lys_module *mod;
         uint32_t index;
@@ -767,6 +799,37 @@ ly_ctx_get_modules_hash(const struct ly_ctx *ctx)
     return ctx->mod_hash;
 }
 
+LY_ERR
+ly_ctx_mod_ht_add(struct ly_ctx *ctx, struct lys_module *mod)
+{
+    LY_ERR rc;
+
+    rc = lyht_insert(ctx->mod_name_ht, &mod, lyht_hash(mod->name, strlen(mod->name)), NULL);
+    LY_CHECK_RET(rc);
+
+    rc = lyht_insert(ctx->mod_ns_ht, &mod, lyht_hash(mod->ns, strlen(mod->ns)), NULL);
+    if (rc) {
+        lyht_remove(ctx->mod_name_ht, &mod, lyht_hash(mod->name, strlen(mod->name)));
+    }
+    return rc;
+}
+
+void
+ly_ctx_mod_ht_remove(struct ly_ctx *ctx, struct lys_module *mod)
+{
+    uint32_t hash;
+
+    /* the module may not have been added on error */
+    hash = lyht_hash(mod->name, strlen(mod->name));
+    if (!lyht_find(ctx->mod_name_ht, &mod, hash, NULL)) {
+        lyht_remove(ctx->mod_name_ht, &mod, hash);
+    }
+    hash = lyht_hash(mod->ns, strlen(mod->ns));
+    if (!lyht_find(ctx->mod_ns_ht, &mod, hash, NULL)) {
+        lyht_remove(ctx->mod_ns_ht, &mod, hash);
+    }
+}
+
 void
 ly_ctx_new_change(struct ly_ctx *ctx)
 {
@@ -872,30 +935,54 @@ ly_ctx_get_module_iter(const struct ly_ctx *ctx, uint32_t *index)
  * @brief Iterate over the modules in the given context. Returned modules must match the given key at the offset of
  * lysp_module and lysc_module structures (they are supposed to be placed at the same offset in both structures).
  *
+ * Only the modules with the same key hash are examined using the module hash tables of the context.
+ *
  * @param[in] ctx Context where to iterate.
  * @param[in] key Key value to search for.
  * @param[in] key_size Optional length of the @p key. If zero, NULL-terminated key is expected.
- * @param[in] key_offset Key's offset in struct lys_module to get value from the context's modules to match with the key.
+ * @param[in] key_offset Key's offset in struct lys_module to get value from the context's modules to match with the key,
+ * only name and namespace are supported.
  * @param[in,out] Iterator to pass between the function calls. On the first call, the variable is supposed to be
- * initiated to 0. After each call returning a module, the value is greater by 1 than the index of the returned
- * module in the context.
+ * initiated to 0. After each call returning a module, the value is the number of the modules returned so far.
  * @return Module matching the given key, NULL if no such module found.
  */
 static struct lys_module *
 ly_ctx_get_module_by_iter(const struct ly_ctx *ctx, const char *key, size_t key_size, size_t key_offset, uint32_t *index)
 {
+    const struct ly_ht *ht;
+    struct ly_ht_rec *rec;
     struct lys_module *mod;
     const char *value;
+    uint32_t hash, hlist_idx, rec_idx, match_idx = 0;
 
-    for ( ; *index < ctx->modules.count; ++(*index)) {
-        mod = ctx->modules.objs[*index];
+    assert((key_offset == offsetof(struct lys_module, name)) || (key_offset == offsetof(struct lys_module, ns)));
+    ht = (key_offset == offsetof(struct lys_module, name)) ? ctx->mod_name_ht : ctx->mod_ns_ht;
+
+    if (!key_size) {
+        key_size = strlen(key);
+    }
+    hash = lyht_hash(key, key_size);
+
+    /* colliding records are kept in the order they were inserted, which is the order of the modules */
+    hlist_idx = hash & (ht->size - 1);
+    LYHT_ITER_HLIST_RECS(ht, hlist_idx, rec_idx, rec) {
+        if (rec->hash != hash) {
+            continue;
+        }
+
+        mod = *(struct lys_module **)&rec->val;
         value = *(const char **)(((int8_t *)(mod)) + key_offset);
-        if ((!key_size && !strcmp(key, value)) || (key_size && !strncmp(key, value, key_size) && (value[key_size] == '\0'))) {
+        if (strncmp(key, value, key_size) || (value[key_size] != '\0')) {
+            continue;
+        }
+
+        if (match_idx++ == *index) {
             /* increment index for the next run */
             ++(*index);
             return mod;
         }
     }
+
     /* done */
     return NULL;
 }
@@ -1403,6 +1490,53 @@ ly_ctx_compiled_size(const struct ly_ctx *ctx)
     return size;
 }
 
+LIBYANG_API_DEF LY_ERR
+ly_ctx_mem_usage(const struct ly_ctx *ctx, struct ly_ctx_mem_usage *usage)
+{
+    struct ly_ctx_shared_data *ctx_data;
+    struct ly_ht_rec *rec;
+    uint32_t hlist_idx, rec_idx;
+    int size;
+
+    LY_CHECK_ARG_RET(ctx, ctx, usage, LY_EINVAL);
+
+    memset(usage, 0, sizeof *usage);
+
+    size = ly_ctx_compiled_size(ctx);
+    LY_CHECK_RET(size < 0, LY_EMEM);
+    usage->compiled = size;
+
+    if (!(ctx->opts & LY_CTX_INT_IMMUTABLE)) {
+        usage->dict = lydict_mem_usage((struct ly_dict *)&ctx->dict);
+    }
+    usage->data_dict = lydict_mem_usage(ly_ctx_data_dict_get(ctx));
+
+    ctx_data = ly_ctx_shared_data_get(ctx);
+    pthread_mutex_lock(&ctx_data->leafref_links_lock);
+    if (ctx_data->leafref_links_ht) {
+        usage->leafref_links = lyht_mem_usage(ctx_data->leafref_links_ht);
+        LYHT_ITER_ALL_RECS(ctx_data->leafref_links_ht, hlist_idx, rec_idx, rec) {
+            usage->leafref_links += lyd_leafref_links_rec_mem_usage(*(struct lyd_leafref_links_rec **)rec->val);
+        }
+    }
+    pthread_mutex_unlock(&ctx_data->leafref_links_lock);
+
+    /* DIGEST LOCK */
+    pthread_mutex_lock(&ctx_data->digest_lock);
+    usage->data_digests = lyht_mem_usage(ctx_data->digest_ht);
+    if (ctx_data->desc_index_ht) {
+        usage->data_desc_index = lyht_mem_usage(ctx_data->desc_index_ht);
+        LYHT_ITER_ALL_RECS(ctx_data->desc_index_ht, hlist_idx, rec_idx, rec) {
+            usage->data_desc_index += lyd_desc_index_rec_mem_usage((struct lyd_desc_index_rec *)rec->val);
+        }
+    }
+
+    /* DIGEST UNLOCK */
+    pthread_mutex_unlock(&ctx_data->digest_lock);
+
+    return LY_SUCCESS;
+}
+
 static ly_bool
 ctxp_ptr_val_equal(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
 {
@@ -1550,6 +1684,8 @@ ly_ctx_destroy(struct ly_ctx *ctx)
         lys_module_free(ctx, mod, 0);
     }
     free(ctx->modules.objs);
+    lyht_free(ctx->mod_name_ht, NULL);
+    lyht_free(ctx->mod_ns_ht, NULL);
 
     /* search paths list */
     ly_set_erase(&ctx->search_paths, free);
@@ -147,6 +147,7 @@ struct lys_module;
  *
  * - ::ly_ctx_get_change_count()
  * - ::ly_ctx_internal_modules_count()
+ * - ::ly_ctx_mem_usage()
  *
  * - ::lys_search_localfile()
  * - ::lys_set_implemented()
@@ -238,6 +239,10 @@ struct ly_ctx;
                                         `LIBYANG_EXTENSIONS_PLUGINS_DIR`. This option has a global effect: the global plugin array
                                         is initialized only when no contexts exist. If any context was created without this flag
                                         and is still alive, creating a new context with this flag will not have the intended effect. */
+#define LY_CTX_XPATH_DESC_INDEX 0x8000 /**< Evaluate XPath descendant steps (`//name`) from a single context node using an index
+                                        of the data node instances of every schema node. A single index of a whole data
+                                        tree is built when first needed and dropped on any change of the tree, so it pays
+                                        off for repeated queries on data trees that do not change often. */
 
 /* 0x80000000 reserved for internal use */
 
@@ -702,6 +707,29 @@ LIBYANG_API_DECL void ly_ctx_free_parsed(struct ly_ctx *ctx);
  */
 LIBYANG_API_DECL int ly_ctx_compiled_size(const struct ly_ctx *ctx);
 
+/**
+ * @brief Memory used by a context, in bytes.
+ */
+struct ly_ctx_mem_usage {
+    uint64_t compiled;      /**< compiled modules, as returned by ::ly_ctx_compiled_size() */
+    uint64_t dict;          /**< dictionary of the schema strings, 0 for printed contexts */
+    uint64_t data_dict;     /**< dictionary of the data strings shared by all the data trees */
+    uint64_t leafref_links; /**< leafref links between data nodes, see ::LY_CTX_LEAFREF_LINKING */
+    uint64_t data_digests;  /**< cached subtree digests of data nodes, see ::lyd_digest() */
+    uint64_t data_desc_index;   /**< cached descendant indexes of data trees, see ::LY_CTX_XPATH_DESC_INDEX */
+};
+
+/**
+ * @brief Get the memory used by a context.
+ *
+ * Memory used by the data trees themselves can be learned using ::lyd_mem_usage().
+ *
+ * @param[in] ctx Context to use.
+ * @param[out] usage Memory used by @p ctx.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR ly_ctx_mem_usage(const struct ly_ctx *ctx, struct ly_ctx_mem_usage *usage);
+
 /**
  * @brief Print (serialize) a compiled context (without any parsed modules) into a pre-allocated memory chunk.
  *
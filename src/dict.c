@@ -91,6 +91,27 @@ lydict_clean(struct ly_dict *dict)
     pthread_mutex_destroy(&dict->lock);
 }
 
+uint64_t
+lydict_mem_usage(struct ly_dict *dict)
+{
+    struct ly_ht_rec *rec;
+    uint32_t hlist_idx, rec_idx;
+    uint64_t size;
+
+    if (!dict->hash_tab) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&dict->lock);
+    size = lyht_mem_usage(dict->hash_tab);
+    LYHT_ITER_ALL_RECS(dict->hash_tab, hlist_idx, rec_idx, rec) {
+        size += strlen(((struct ly_dict_rec *)rec->val)->value) + 1;
+    }
+    pthread_mutex_unlock(&dict->lock);
+
+    return size;
+}
+
 static ly_bool
 lydict_resize_val_eq(void *val1_p, void *val2_p, ly_bool mod, void *UNUSED(cb_data))
 {
@@ -21,10 +21,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "compat.h"
 #include "context.h"
 #include "dict.h"
+#include "hash_table.h"
 #include "log.h"
 #include "ly_common.h"
 #include "plugins_exts.h"
@@ -35,10 +37,16 @@
 #include "tree.h"
 #include "tree_data.h"
 #include "tree_data_internal.h"
+#include "tree_data_sorted.h"
 #include "tree_edit.h"
 #include "tree_schema.h"
 #include "tree_schema_internal.h"
 
+/**
+ * @brief Number of children of a subtree for it to be split into several parallel diff tasks.
+ */
+#define LYD_DIFF_PAR_SPLIT_CHILDREN 256
+
 #define LOGERR_META(ctx, meta_name, node) \
         { \
             char *__path = lyd_path(node, LYD_PATH_STD, NULL, 0); \
@@ -1180,6 +1188,119 @@ lyd_diff_node_metadata_r(const struct lyd_node *first_subtree, const struct lyd_
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Check whether 2 matching data nodes have equal subtrees based on their cached digests.
+ *
+ * @param[in] first Node from the first tree.
+ * @param[in] second Matching node from the second tree.
+ * @return Whether the subtrees are equal.
+ */
+static ly_bool
+lyd_diff_digest_equal(const struct lyd_node *first, const struct lyd_node *second)
+{
+    uint64_t digest1, digest2;
+
+    if (!(first->schema->nodetype & LYD_NODE_INNER)) {
+        /* nothing to descend into */
+        return 0;
+    }
+
+    if (lyd_digest(first, &digest1) || lyd_digest(second, &digest2)) {
+        return 0;
+    }
+
+    return digest1 == digest2;
+}
+
+/**
+ * @brief Find a successfully finished parallel diff task.
+ *
+ * @param[in] par Parallel diff.
+ * @param[in] first Node from the first tree.
+ * @param[in] second Matching node from the second tree.
+ * @return Found task, NULL if there is none.
+ */
+static struct lyd_diff_par_task *
+lyd_diff_par_task_get(struct lyd_diff_par *par, const struct lyd_node *first, const struct lyd_node *second)
+{
+    struct lyd_diff_par_task rec = {0}, *task_p = &rec, **match_p;
+    uint32_t hash;
+
+    rec.first = first;
+    hash = lyht_hash((const char *)&first, sizeof first);
+    if (lyht_find(par->task_ht, &task_p, hash, (void **)&match_p)) {
+        return NULL;
+    }
+
+    if ((*match_p)->rc || ((*match_p)->second != second)) {
+        /* failed, generate the diff again so that the error is logged properly */
+        return NULL;
+    }
+    return *match_p;
+}
+
+/**
+ * @brief Connect the diff generated by a parallel diff task into the diff.
+ *
+ * The diff of the task is created with all the parents so they are either found in @p diff or connected exactly
+ * as ::lyd_diff_add() would have done it had the diff been generated serially at this point.
+ *
+ * @param[in] task Finished task, its diff is spent.
+ * @param[in,out] diff Diff to connect to.
+ * @return LY_SUCCESS on success.
+ * @return LY_ENOT if the node of the task is already in @p diff so the diff of the task cannot be used.
+ * @return LY_ERR on error.
+ */
+static LY_ERR
+lyd_diff_par_stitch(struct lyd_diff_par_task *task, struct lyd_node **diff)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyd_node *node, *siblings, *match, *diff_parent = NULL;
+    struct lyd_meta *meta;
+
+    node = task->diff;
+    siblings = *diff;
+    while (node) {
+        lyd_find_sibling_first(siblings, node, &match);
+        if (!match) {
+            /* connect the whole subtree */
+            if (node == task->diff) {
+                task->diff = NULL;
+            }
+            lyd_unlink_tree(node);
+            if (diff_parent) {
+                lyd_insert_node(diff_parent, NULL, node, LYD_INSERT_NODE_DEFAULT);
+
+                /* add parent operation, if any */
+                lyd_diff_find_meta(node, "operation", &meta, NULL);
+                if (!meta) {
+                    LY_CHECK_GOTO(rc = lyd_new_meta(NULL, node, NULL, "yang:operation", "none", LYD_NEW_VAL_STORE_ONLY,
+                            NULL), cleanup);
+                }
+            } else {
+                lyd_diff_insert_sibling(*diff, node, diff);
+            }
+            break;
+        }
+
+        if (node->schema == task->first->schema) {
+            /* the node with (some of) its descendants is already in the diff, they would have to be merged */
+            rc = LY_ENOT;
+            break;
+        }
+
+        /* move down in both diffs */
+        diff_parent = match;
+        siblings = lyd_child_no_keys(match);
+        node = lyd_child_no_keys(node);
+    }
+
+cleanup:
+    lyd_free_siblings(task->diff);
+    task->diff = NULL;
+    return rc;
+}
+
 /**
  * @brief Perform diff for all siblings at certain depth, recursively.
  *
@@ -1218,17 +1339,19 @@ lyd_diff_node_metadata_r(const struct lyd_node *first_subtree, const struct lyd_
  * @param[in] second Second tree first sibling.
  * @param[in] options Diff options.
  * @param[in] nosiblings Whether to skip following siblings.
+ * @param[in] par Optional parallel diff with the diffs of some subtrees already generated.
  * @param[in,out] diff Diff to append to.
  * @return LY_ERR value.
  */
 static LY_ERR
 lyd_diff_siblings_r(const struct lyd_node *first, const struct lyd_node *second, uint16_t options, ly_bool nosiblings,
-        struct lyd_node **diff)
+        struct lyd_diff_par *par, struct lyd_node **diff)
 {
     LY_ERR rc = LY_SUCCESS, r;
     const struct lyd_node *iter_first, *iter_second;
     struct lyd_node *match_second, *match_first, *diff_node;
     struct lyd_diff_userord *userord = NULL, *userord_item;
+    struct lyd_diff_par_task *task;
     struct ly_ht *dup_inst_first = NULL, *dup_inst_second = NULL;
     LY_ARRAY_COUNT_TYPE u;
     enum lyd_diff_op op;
@@ -1302,9 +1425,17 @@ lyd_diff_siblings_r(const struct lyd_node *first, const struct lyd_node *second,
                 LY_CHECK_GOTO(rc = lyd_diff_node_metadata_r(iter_first, match_second, 1, diff_node), cleanup);
             }
 
-            /* check descendants, if any, recursively */
-            LY_CHECK_GOTO(rc = lyd_diff_siblings_r(lyd_child_no_keys(iter_first), lyd_child_no_keys(match_second),
-                    options, 0, diff), cleanup);
+            /* check descendants, if any, recursively, unless the subtrees are known to be equal */
+            r = LY_ENOT;
+            if (par && !diff_node && (task = lyd_diff_par_task_get(par, iter_first, match_second))) {
+                /* try to use the descendants diff generated in parallel */
+                r = lyd_diff_par_stitch(task, diff);
+                LY_CHECK_ERR_GOTO(r && (r != LY_ENOT), rc = r, cleanup);
+            }
+            if (r && (!(options & LYD_DIFF_DIGEST) || diff_node || !lyd_diff_digest_equal(iter_first, match_second))) {
+                LY_CHECK_GOTO(rc = lyd_diff_siblings_r(lyd_child_no_keys(iter_first), lyd_child_no_keys(match_second),
+                        options, 0, par, diff), cleanup);
+            }
         } else {
             if ((options & LYD_DIFF_META) && diff_node) {
                 /* create metadata diff for the node and all its descendants */
@@ -1399,11 +1530,222 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Collect subtrees whose descendants diffs can be generated independently in parallel.
+ *
+ * Every matching inner node is a task unless it has many children when its descendants are split into separate
+ * tasks instead. Instances of lists/leaf-lists that allow duplicates are skipped because their diff parents are
+ * never shared.
+ *
+ * @param[in] first First tree first sibling.
+ * @param[in] second Second tree first sibling.
+ * @param[in] options Diff options.
+ * @param[in] nosiblings Whether to skip following siblings.
+ * @param[in,out] par Parallel diff to add the tasks to.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_diff_par_collect(const struct lyd_node *first, const struct lyd_node *second, uint16_t options,
+        ly_bool nosiblings, struct lyd_diff_par *par)
+{
+    LY_ERR rc = LY_SUCCESS;
+    const struct lyd_node *iter_first, *child;
+    struct lyd_node *match_second;
+    struct lyd_diff_par_task *task;
+    struct ly_ht *dup_inst_second = NULL;
+    uint32_t count;
+
+    LY_LIST_FOR(first, iter_first) {
+        if (!iter_first->schema || !(iter_first->schema->nodetype & LYD_NODE_INNER) ||
+                lysc_is_dup_inst_list(iter_first->schema)) {
+            goto next_sibling;
+        }
+        if ((iter_first->flags & LYD_DEFAULT) && !(options & LYD_DIFF_DEFAULTS)) {
+            /* skip default nodes */
+            goto next_sibling;
+        }
+
+        /* find a match in the second tree */
+        LY_CHECK_GOTO(rc = lyd_diff_find_match(second, iter_first, options & LYD_DIFF_DEFAULTS, &dup_inst_second,
+                &match_second), cleanup);
+        if (!match_second || (!lyd_child_no_keys(iter_first) && !lyd_child_no_keys(match_second))) {
+            goto next_sibling;
+        }
+
+        /* count the children */
+        count = 0;
+        LY_LIST_FOR(lyd_child_no_keys(iter_first), child) {
+            if (++count == LYD_DIFF_PAR_SPLIT_CHILDREN) {
+                break;
+            }
+        }
+
+        if (count == LYD_DIFF_PAR_SPLIT_CHILDREN) {
+            /* large subtree, split it */
+            LY_CHECK_GOTO(rc = lyd_diff_par_collect(lyd_child_no_keys(iter_first), lyd_child_no_keys(match_second),
+                    options, 0, par), cleanup);
+        } else {
+            LY_ARRAY_NEW_GOTO(LYD_CTX(iter_first), par->tasks, task, rc, cleanup);
+            task->first = iter_first;
+            task->second = match_second;
+        }
+
+next_sibling:
+        if (nosiblings) {
+            break;
+        }
+    }
+
+cleanup:
+    lyd_dup_inst_free(dup_inst_second);
+    return rc;
+}
+
+/**
+ * @brief Parallel diff thread, processes tasks until there are none left.
+ *
+ * @param[in] arg Parallel diff.
+ * @return NULL.
+ */
+static void *
+lyd_diff_par_thread(void *arg)
+{
+    struct lyd_diff_par *par = arg;
+    struct lyd_diff_par_task *task;
+
+    while (1) {
+        /* PAR LOCK */
+        pthread_mutex_lock(&par->lock);
+
+        task = (par->next < LY_ARRAY_COUNT(par->tasks)) ? &par->tasks[par->next++] : NULL;
+
+        /* PAR UNLOCK */
+        pthread_mutex_unlock(&par->lock);
+
+        if (!task) {
+            break;
+        }
+
+        task->rc = lyd_diff_siblings_r(lyd_child_no_keys(task->first), lyd_child_no_keys(task->second), par->options,
+                0, NULL, &task->diff);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Hash table equal callback for parallel diff tasks.
+ *
+ * Implementation of ::lyht_value_equal_cb.
+ */
+static ly_bool
+lyd_diff_par_task_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyd_diff_par_task *task1 = *(struct lyd_diff_par_task **)val1_p;
+    struct lyd_diff_par_task *task2 = *(struct lyd_diff_par_task **)val2_p;
+
+    return task1->first == task2->first;
+}
+
+/**
+ * @brief Generate diffs of independent subtrees in parallel.
+ *
+ * @param[in] first First tree first sibling.
+ * @param[in] second Second tree first sibling.
+ * @param[in] options Diff options.
+ * @param[in] nosiblings Whether to skip following siblings.
+ * @param[in,out] par Parallel diff to initialize, no tasks are created if it is not worth it.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_diff_par_run(const struct lyd_node *first, const struct lyd_node *second, uint16_t options, ly_bool nosiblings,
+        struct lyd_diff_par *par)
+{
+    LY_ERR rc = LY_SUCCESS;
+    pthread_t *threads = NULL;
+    struct lyd_diff_par_task *task;
+    uint32_t hash, thread_count = 0, i;
+    long cpu_count;
+
+    par->options = options & ~LYD_DIFF_PARALLEL;
+    pthread_mutex_init(&par->lock, NULL);
+
+#ifdef _SC_NPROCESSORS_ONLN
+    cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    cpu_count = 1;
+#endif
+    if (cpu_count < 2) {
+        /* no point */
+        goto cleanup;
+    }
+
+    /* collect the tasks */
+    LY_CHECK_GOTO(rc = lyd_diff_par_collect(first, second, options, nosiblings, par), cleanup);
+    if (LY_ARRAY_COUNT(par->tasks) < 2) {
+        /* no point */
+        goto cleanup;
+    }
+
+    /* start the threads, the current one is used as well */
+    thread_count = LY_ARRAY_COUNT(par->tasks);
+    if ((uint64_t)cpu_count < thread_count) {
+        thread_count = cpu_count;
+    }
+    --thread_count;
+    threads = malloc(thread_count * sizeof *threads);
+    LY_CHECK_ERR_GOTO(!threads, LOGMEM(LYD_CTX(first)); rc = LY_EMEM, cleanup);
+    for (i = 0; i < thread_count; ++i) {
+        if (pthread_create(&threads[i], NULL, lyd_diff_par_thread, par)) {
+            /* use only the threads created so far */
+            thread_count = i;
+            break;
+        }
+    }
+    lyd_diff_par_thread(par);
+    for (i = 0; i < thread_count; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    /* index the tasks */
+    par->task_ht = lyht_new(lyht_get_fixed_size(LY_ARRAY_COUNT(par->tasks)), sizeof task, lyd_diff_par_task_equal_cb,
+            NULL, 0);
+    LY_CHECK_ERR_GOTO(!par->task_ht, LOGMEM(LYD_CTX(first)); rc = LY_EMEM, cleanup);
+    LY_ARRAY_FOR(par->tasks, struct lyd_diff_par_task, task) {
+        hash = lyht_hash((const char *)&task->first, sizeof task->first);
+        LY_CHECK_ERR_GOTO(lyht_insert(par->task_ht, &task, hash, NULL), LOGINT(LYD_CTX(first)); rc = LY_EINT, cleanup);
+    }
+
+cleanup:
+    free(threads);
+    return rc;
+}
+
+/**
+ * @brief Free a parallel diff.
+ *
+ * @param[in] par Parallel diff to free.
+ */
+static void
+lyd_diff_par_free(struct lyd_diff_par *par)
+{
+    LY_ARRAY_COUNT_TYPE u;
+
+    LY_ARRAY_FOR(par->tasks, u) {
+        lyd_free_siblings(par->tasks[u].diff);
+    }
+    LY_ARRAY_FREE(par->tasks);
+    lyht_free(par->task_ht, NULL);
+    pthread_mutex_destroy(&par->lock);
+}
+
 static LY_ERR
 lyd_diff(const struct lyd_node *first, const struct lyd_node *second, uint16_t options, ly_bool nosiblings,
         struct lyd_node **diff)
 {
+    LY_ERR rc;
     const struct ly_ctx *ctx;
+    struct lyd_diff_par par = {0};
 
     LY_CHECK_ARG_RET(NULL, diff, LY_EINVAL);
 
@@ -1422,7 +1764,16 @@ lyd_diff(const struct lyd_node *first, const struct lyd_node *second, uint16_t o
 
     *diff = NULL;
 
-    return lyd_diff_siblings_r(first, second, options, nosiblings, diff);
+    if ((options & LYD_DIFF_PARALLEL) && first && second) {
+        /* generate diffs of independent subtrees in parallel */
+        LY_CHECK_GOTO(rc = lyd_diff_par_run(first, second, options, nosiblings, &par), cleanup);
+    }
+
+    rc = lyd_diff_siblings_r(first, second, options, nosiblings, par.task_ht ? &par : NULL, diff);
+
+cleanup:
+    lyd_diff_par_free(&par);
+    return rc;
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -1784,12 +2135,16 @@ cleanup:
     return rc;
 }
 
+static LY_ERR lyd_diff_apply_siblings_r(struct lyd_node **first_node, struct lyd_node *parent_node,
+        const struct lyd_node *diff_first, const struct lys_module *mod, lyd_diff_cb diff_cb, void *cb_data);
+
 /**
  * @brief Apply diff subtree on data tree nodes, recursively.
  *
  * @param[in,out] first_node First sibling of the subtree.
  * @param[in] parent_node Parent of the first sibling.
  * @param[in] diff_node Current diff node.
+ * @param[in] created Node already created and inserted for a create operation of @p diff_node, if any.
  * @param[in] diff_cb Optional diff callback.
  * @param[in] cb_data User data for @p diff_cb.
  * @param[in,out] dup_inst Duplicate instance cache for all @p diff_node siblings.
@@ -1797,14 +2152,13 @@ cleanup:
  */
 static LY_ERR
 lyd_diff_apply_r(struct lyd_node **first_node, struct lyd_node *parent_node, const struct lyd_node *diff_node,
-        lyd_diff_cb diff_cb, void *cb_data, struct ly_ht **dup_inst)
+        struct lyd_node *created, lyd_diff_cb diff_cb, void *cb_data, struct ly_ht **dup_inst)
 {
-    LY_ERR rc = LY_SUCCESS, r;
-    struct lyd_node *match, *diff_child;
+    LY_ERR r;
+    struct lyd_node *match;
     const char *str_val, *meta_str;
     enum lyd_diff_op op;
     struct lyd_meta *meta;
-    struct ly_ht *child_dup_inst = NULL;
     const struct ly_ctx *ctx = LYD_CTX(diff_node);
 
     /* read all the valid attributes */
@@ -1860,9 +2214,16 @@ lyd_diff_apply_r(struct lyd_node **first_node, struct lyd_node *parent_node, con
                 } else {
                     match->flags &= ~LYD_DEFAULT;
                 }
+                lyd_digest_invalidate(match);
             }
             break;
         case LYD_DIFF_OP_CREATE:
+            if (created) {
+                /* already created with its siblings */
+                match = created;
+                break;
+            }
+
             /* duplicate the node */
             LY_CHECK_RET(lyd_dup_single(diff_node, NULL, LYD_DUP_NO_META, &match));
 
@@ -1916,6 +2277,7 @@ lyd_diff_apply_r(struct lyd_node **first_node, struct lyd_node *parent_node, con
 
             /* with flags */
             match->flags = diff_node->flags;
+            lyd_digest_invalidate(match);
             break;
         default:
             LOGINT_RET(ctx);
@@ -1931,40 +2293,167 @@ lyd_diff_apply_r(struct lyd_node **first_node, struct lyd_node *parent_node, con
     }
 
     /* apply diff recursively */
-    LY_LIST_FOR(lyd_child_no_keys(diff_node), diff_child) {
-        rc = lyd_diff_apply_r(lyd_node_child_p(match), match, diff_child, diff_cb, cb_data, &child_dup_inst);
-        if (rc) {
-            break;
-        }
+    return lyd_diff_apply_siblings_r(lyd_node_child_p(match), match, lyd_child_no_keys(diff_node), NULL, diff_cb,
+            cb_data);
+}
+
+/**
+ * @brief Check whether a diff node operation can be applied in a batch with its siblings.
+ *
+ * User-ordered (leaf-)list instances depend on the order of operations and duplicate instances are matched
+ * in the order of operations so both are always applied in order.
+ *
+ * @param[in] diff_node Diff node.
+ * @param[in] op Operation of @p diff_node.
+ * @return Whether the operation can be batched.
+ */
+static ly_bool
+lyd_diff_apply_is_batched(const struct lyd_node *diff_node, enum lyd_diff_op op)
+{
+    if ((op != LYD_DIFF_OP_CREATE) && (op != LYD_DIFF_OP_DELETE)) {
+        return 0;
     }
 
-    lyd_dup_inst_free(child_dup_inst);
-    return rc;
+    return diff_node->schema && !lysc_is_userordered(diff_node->schema) && !lysc_is_dup_inst_list(diff_node->schema);
 }
 
-LIBYANG_API_DEF LY_ERR
-lyd_diff_apply_module(struct lyd_node **data, const struct lyd_node *diff, const struct lys_module *mod,
-        lyd_diff_cb diff_cb, void *cb_data)
+/**
+ * @brief Apply diff siblings on data tree siblings, recursively.
+ *
+ * Without a callback, the operations are batched. All the deletes are applied first, then all the created nodes
+ * are inserted at once so that sorted (leaf-)lists are merged and the children hash table of the parent is rebuilt
+ * at most once. Only then the rest of the operations are applied in order.
+ *
+ * @param[in,out] first_node First sibling of the data siblings.
+ * @param[in] parent_node Parent of the data siblings.
+ * @param[in] diff_first First diff sibling.
+ * @param[in] mod Optional module whose data only are to be applied.
+ * @param[in] diff_cb Optional diff callback.
+ * @param[in] cb_data User data for @p diff_cb.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_diff_apply_siblings_r(struct lyd_node **first_node, struct lyd_node *parent_node,
+        const struct lyd_node *diff_first, const struct lys_module *mod, lyd_diff_cb diff_cb, void *cb_data)
 {
-    const struct lyd_node *root;
+    LY_ERR rc = LY_SUCCESS;
+    const struct lyd_node *diff_node, *prev_created = NULL;
+    struct lyd_node *created_first = NULL, **created = NULL, **created_p, *match;
     struct ly_ht *dup_inst = NULL;
-    LY_ERR ret = LY_SUCCESS;
+    enum lyd_diff_op op;
+    LY_ARRAY_COUNT_TYPE u = 0, v;
+    ly_bool batch = diff_cb ? 0 : 1, batch_create = 1;
+
+    if (batch) {
+        /* apply all the deletes */
+        LY_LIST_FOR(diff_first, diff_node) {
+            if (mod && (lyd_owner_module(diff_node) != mod)) {
+                /* skip data nodes from different modules */
+                continue;
+            }
+
+            LY_CHECK_GOTO(rc = lyd_diff_get_op(diff_node, &op, NULL), cleanup);
+            if (!lyd_diff_apply_is_batched(diff_node, op)) {
+                continue;
+            }
+
+            if (op == LYD_DIFF_OP_DELETE) {
+                LY_CHECK_GOTO(rc = lyd_diff_apply_r(first_node, parent_node, diff_node, NULL, NULL, NULL, &dup_inst),
+                        cleanup);
+            } else if (prev_created && (prev_created->schema == diff_node->schema) && lyds_is_supported(diff_node) &&
+                    (lyds_compare_single((struct lyd_node *)prev_created, (struct lyd_node *)diff_node) > 0)) {
+                /* unsorted created instances, they would be inserted unsorted */
+                batch_create = 0;
+            } else {
+                prev_created = diff_node;
+            }
+        }
+    }
+
+    if (batch && batch_create && prev_created) {
+        /* duplicate all the created nodes */
+        LY_LIST_FOR(diff_first, diff_node) {
+            if (mod && (lyd_owner_module(diff_node) != mod)) {
+                continue;
+            }
+
+            LY_CHECK_GOTO(rc = lyd_diff_get_op(diff_node, &op, NULL), cleanup);
+            if ((op != LYD_DIFF_OP_CREATE) || !lyd_diff_apply_is_batched(diff_node, op)) {
+                continue;
+            }
+
+            /* check every node the same way its insert would so that nothing fails after the first one is linked */
+            if (!(diff_node->flags & LYD_EXT)) {
+                LY_CHECK_GOTO(rc = lyd_insert_check_schema(parent_node ? parent_node->schema : NULL,
+                        (!parent_node && *first_node) ? (*first_node)->schema : NULL, diff_node->schema), cleanup);
+            }
 
-    LY_LIST_FOR(diff, root) {
-        if (mod && (lyd_owner_module(root) != mod)) {
+            LY_CHECK_GOTO(rc = lyd_dup_single(diff_node, NULL, LYD_DUP_NO_META, &match), cleanup);
+            if (created_first) {
+                lyd_insert_after_node(&created_first, created_first->prev, match);
+            } else {
+                created_first = match;
+            }
+            LY_ARRAY_NEW_GOTO(LYD_CTX(diff_node), created, created_p, rc, cleanup);
+            *created_p = match;
+        }
+
+        /* insert them all at once */
+        LY_CHECK_GOTO(rc = lyd_insert_hash_reserve(parent_node, LY_ARRAY_COUNT(created)), cleanup);
+        if (parent_node) {
+            rc = lyd_insert_child(parent_node, created_first);
+        } else {
+            rc = lyd_insert_sibling(*first_node, created_first, first_node);
+        }
+        created_first = NULL;
+        if (rc) {
+            /* some of the nodes may have already been moved into the data, free each of them wherever it is */
+            LY_ARRAY_FOR(created, v) {
+                lyd_free_tree(created[v]);
+            }
+            goto cleanup;
+        }
+    }
+
+    /* apply the rest of the operations in order */
+    LY_LIST_FOR(diff_first, diff_node) {
+        if (mod && (lyd_owner_module(diff_node) != mod)) {
             /* skip data nodes from different modules */
             continue;
         }
 
-        /* apply relevant nodes from the diff datatree */
-        ret = lyd_diff_apply_r(data, NULL, root, diff_cb, cb_data, &dup_inst);
-        if (ret) {
-            break;
+        match = NULL;
+        if (batch) {
+            LY_CHECK_GOTO(rc = lyd_diff_get_op(diff_node, &op, NULL), cleanup);
+            if (lyd_diff_apply_is_batched(diff_node, op)) {
+                if (op == LYD_DIFF_OP_DELETE) {
+                    /* already applied */
+                    continue;
+                } else if (created) {
+                    match = created[u++];
+                }
+            }
         }
+
+        LY_CHECK_GOTO(rc = lyd_diff_apply_r(first_node, parent_node, diff_node, match, diff_cb, cb_data, &dup_inst),
+                cleanup);
     }
 
+cleanup:
+    lyd_free_siblings(created_first);
+    LY_ARRAY_FREE(created);
     lyd_dup_inst_free(dup_inst);
-    return ret;
+    return rc;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_diff_apply_module(struct lyd_node **data, const struct lyd_node *diff, const struct lys_module *mod,
+        lyd_diff_cb diff_cb, void *cb_data)
+{
+    LY_CHECK_ARG_RET(NULL, data, LY_EINVAL);
+
+    /* apply relevant nodes from the diff datatree */
+    return lyd_diff_apply_siblings_r(data, NULL, diff, mod, diff_cb, cb_data);
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -1992,6 +2481,7 @@ lyd_diff_merge_none(struct lyd_node *diff_match, enum lyd_diff_op cur_op, const
             /* NONE on a term means only its dflt flag was changed */
             diff_match->flags &= ~LYD_DEFAULT;
             diff_match->flags |= src_diff->flags & LYD_DEFAULT;
+            lyd_digest_invalidate(diff_match);
         }
         break;
     default:
@@ -2289,6 +2779,7 @@ lyd_diff_merge_replace(struct lyd_node *diff_match, enum lyd_diff_op cur_op, con
             /* modify the default flag */
             diff_match->flags &= ~LYD_DEFAULT;
             diff_match->flags |= src_diff->flags & LYD_DEFAULT;
+            lyd_digest_invalidate(diff_match);
             break;
         case LYS_ANYXML:
         case LYS_ANYDATA:
@@ -2475,6 +2966,7 @@ lyd_diff_merge_create(struct lyd_node **diff_match, struct lyd_node **diff, enum
             /* update dflt flag itself */
             (*diff_match)->flags &= ~LYD_DEFAULT;
             (*diff_match)->flags |= src_diff->flags & LYD_DEFAULT;
+            lyd_digest_invalidate(*diff_match);
         }
 
         /* but the operation of its children should remain DELETE */
@@ -2551,6 +3043,7 @@ lyd_diff_merge_delete(struct lyd_node *diff_match, enum lyd_diff_op cur_op, cons
             if (meta->value.boolean) {
                 diff_match->flags |= LYD_DEFAULT;
             }
+            lyd_digest_invalidate(diff_match);
             lyd_free_meta_single(meta);
 
             meta_name = "orig-value";
@@ -3116,6 +3609,7 @@ lyd_diff_reverse_default(struct lyd_node *node, const struct lys_module *mod)
     /* switch defaults */
     node->flags &= ~LYD_DEFAULT;
     node->flags |= flag1;
+    lyd_digest_invalidate(node);
     LY_CHECK_RET(lyd_change_meta(meta, flag2 ? "true" : "false"));
 
     return LY_SUCCESS;
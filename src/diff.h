@@ -15,10 +15,13 @@
 #ifndef LY_DIFF_H_
 #define LY_DIFF_H_
 
+#include <pthread.h>
 #include <stdint.h>
 
 #include "log.h"
+#include "tree.h"
 
+struct ly_ht;
 struct lyd_node;
 
 /**
@@ -30,6 +33,27 @@ struct lyd_diff_userord {
     const struct lyd_node **inst;   /**< Sized array of current instance order. */
 };
 
+/**
+ * @brief Internal structure for a subtree diff computed in parallel.
+ */
+struct lyd_diff_par_task {
+    const struct lyd_node *first;   /**< Node from the first tree whose descendants are compared. */
+    const struct lyd_node *second;  /**< Matching node from the second tree. */
+    struct lyd_node *diff;          /**< Diff of the descendants with all the parents, NULL if there are no changes. */
+    LY_ERR rc;                      /**< Result of generating the diff. */
+};
+
+/**
+ * @brief Internal structure for a parallel diff.
+ */
+struct lyd_diff_par {
+    struct lyd_diff_par_task *tasks;    /**< Sized array of all the tasks. */
+    struct ly_ht *task_ht;              /**< Hash table of pointers to @p tasks for finding them by their first node. */
+    LY_ARRAY_COUNT_TYPE next;           /**< Index of the next task to be processed. */
+    pthread_mutex_t lock;               /**< Lock for accessing @p next. */
+    uint16_t options;                   /**< Diff options to use for the tasks. */
+};
+
 /**
  * @brief Diff operations.
  */
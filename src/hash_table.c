@@ -534,6 +534,16 @@ lyht_remove(struct ly_ht *ht, void *val_p, uint32_t hash)
     return lyht_remove_with_resize_cb(ht, val_p, hash, NULL);
 }
 
+uint64_t
+lyht_mem_usage(const struct ly_ht *ht)
+{
+    if (!ht) {
+        return 0;
+    }
+
+    return sizeof *ht + (uint64_t)ht->size * (sizeof *ht->hlists + ht->rec_size);
+}
+
 LIBYANG_API_DEF uint32_t
 lyht_get_fixed_size(uint32_t item_count)
 {
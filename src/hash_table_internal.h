@@ -143,4 +143,20 @@ void lydict_init(struct ly_dict *dict);
  */
 void lydict_clean(struct ly_dict *dict);
 
+/**
+ * @brief Get the memory used by a hash table.
+ *
+ * @param[in] ht Hash table, may be NULL.
+ * @return Memory used by @p ht in bytes, the values stored out of the table are not included.
+ */
+uint64_t lyht_mem_usage(const struct ly_ht *ht);
+
+/**
+ * @brief Get the memory used by a dictionary.
+ *
+ * @param[in] dict Dictionary.
+ * @return Memory used by @p dict in bytes, including the stored strings.
+ */
+uint64_t lydict_mem_usage(struct ly_dict *dict);
+
 #endif /* LY_HASH_TABLE_INTERNAL_H_ */
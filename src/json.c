@@ -88,13 +88,16 @@ lyjson_ctx_depth(struct lyjson_ctx *jsonctx)
 static void
 lyjson_skip_ws(struct lyjson_ctx *jsonctx)
 {
+    const char *in = jsonctx->in->current;
+
     /* skip whitespaces */
-    while (is_jsonws(*jsonctx->in->current)) {
-        if (*jsonctx->in->current == '\n') {
+    while (is_jsonws(*in)) {
+        if (*in == '\n') {
             LY_IN_NEW_LINE(jsonctx->in);
         }
-        ly_in_skip(jsonctx->in, 1);
+        ++in;
     }
+    ly_in_skip(jsonctx->in, in - jsonctx->in->current);
 }
 
 /**
@@ -172,7 +175,7 @@ lyjson_string(struct lyjson_ctx *jsonctx)
                 for (increment = LYJSON_STRING_BUF_STEP; len + offset + 4 >= size + increment; increment += LYJSON_STRING_BUF_STEP) {}
                 buf = ly_realloc(buf, size + increment);
                 LY_CHECK_ERR_RET(!buf, LOGMEM(jsonctx->ctx), LY_EMEM);
-                size += LYJSON_STRING_BUF_STEP;
+                size += increment;
             }
 
             if (offset) {
@@ -271,6 +274,17 @@ lyjson_string(struct lyjson_ctx *jsonctx)
             goto success;
 
         default:
+            if (is_jsonplainchar(in[offset])) {
+                /* a run of plain ASCII characters, no need to decode them */
+                for (c = &in[offset + 1]; is_jsonplainchar(*c); ++c) {}
+                if ((uint64_t)(c - in) > UINT32_MAX) {
+                    LOGVAL(jsonctx->ctx, NULL, LYVE_SYNTAX, "JSON value too long.");
+                    goto error;
+                }
+                offset = c - in;
+                break;
+            }
+
             /* get it as UTF-8 character for check */
             c = &in[offset];
             LY_CHECK_ERR_GOTO(ly_getutf8(&c, &value, &u),
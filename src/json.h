@@ -34,6 +34,9 @@ struct ly_in;
 /* Macro to test if character is valid string character */
 #define is_jsonstrchar(c) (c == 0x20 || c == 0x21 || (c >= 0x23 && c <= 0x5b) || (c >= 0x5d && c <= 0x10ffff))
 
+/* Macro to test if character is a string character in the ASCII range that needs no further processing */
+#define is_jsonplainchar(c) (((uint8_t)(c) >= 0x20) && ((uint8_t)(c) < 0x80) && ((c) != '"') && ((c) != '\\'))
+
 /* Macro to push JSON parser status */
 #define LYJSON_STATUS_PUSH_RET(CTX, STATUS) \
     LY_CHECK_RET(ly_set_add(&CTX->status, (void *)(uintptr_t)(STATUS), 1, NULL))
@@ -162,6 +162,38 @@ extern "C" {
  * Data trees are not internally synchronized so the general safe practice of a single writer **or** several concurrent
  * readers should be followed. Specifically, only the functions with non-const ::lyd_node parameters modify the node(s)
  * and no concurrent execution of such functions should be allowed on a single data tree or subtrees of one.
+ *
+ * While there is no writer, any number of threads may concurrently read a single data tree using the functions taking
+ * only const ::lyd_node parameters, most notably:
+ *
+ * - ::lyd_find_path(), ::lyd_find_sibling_val(), ::lyd_find_sibling_first(), and the other `lyd_find_*()` functions,
+ * - ::lyd_find_xpath(), ::lyd_eval_xpath(), and their variants,
+ * - ::lyd_print_mem(), ::lyd_print_all(), ::lyd_print_tree(), and the other `lyd_print_*()` functions,
+ * - ::lyd_compare_single(), ::lyd_compare_siblings(), and ::lyd_compare_meta(),
+ * - ::lyd_get_value(), ::lyd_get_meta_value(), ::lyd_value_get_canonical(), and ::lyd_path().
+ *
+ * The state these functions build lazily and its protection:
+ *
+ * - canonical values of some types (::lyd_value._canonical) are published atomically by ::lyplg_type_set_canonical()
+ *   and read atomically so that the readers cannot overwrite each other's value. Custom type plugins generating
+ *   the canonical value on demand must use the same function,
+ * - subtree digests (::lyd_digest(), also used by ::lyd_compare_single() with ::LYD_COMPARE_DIGEST and by the diff
+ *   functions with ::LYD_DIFF_DIGEST) are cached in a hash table of the context protected by a context mutex,
+ * - descendant indexes of XPath `//name` steps (::LY_CTX_XPATH_DESC_INDEX) are cached in another hash table of
+ *   the context protected by the same mutex.
+ *
+ * Both the caches are shared by all the data trees of a context so concurrent readers of even unrelated trees contend
+ * on the mutex while building or looking up a digest or an index. Writers use atomic counters of the cached records
+ * to skip the mutex while nothing is cached.
+ *
+ * The following state is not built by the readers:
+ *
+ * - XPath evaluation assigns document positions of the result nodes (`set_assign_pos()`) only in its own node set,
+ *   no data node is modified,
+ * - child hash tables of inner nodes (::lyd_node_inner.children_ht) are created and resized only when inserting
+ *   children, the readers only look them up,
+ * - leafref links (::LY_CTX_LEAFREF_LINKING) are created only by data validation. ::lyd_leafref_get_links() only
+ *   looks them up, with another context mutex held, so concurrent callers contend on it.
  */
 
 /**
@@ -133,6 +133,40 @@ ly_ctx_ht_leafref_links_rec_free(void *val_p)
     free(*rec);
 }
 
+/**
+ * @brief Callback for comparing two data digest records.
+ */
+static ly_bool
+ly_ctx_ht_digest_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyd_digest_rec *rec1 = val1_p, *rec2 = val2_p;
+
+    return rec1->node == rec2->node;
+}
+
+ly_bool
+ly_ctx_ht_desc_index_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyd_desc_index_rec *rec1 = val1_p, *rec2 = val2_p;
+
+    return rec1->node == rec2->node;
+}
+
+/**
+ * @brief Callback for comparing two schema child records.
+ */
+static ly_bool
+ly_ctx_ht_schema_child_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lysc_child_rec *rec1 = val1_p, *rec2 = val2_p;
+
+    if ((rec1->parent != rec2->parent) || (rec1->mod != rec2->mod) || (rec1->output != rec2->output)) {
+        return 0;
+    }
+
+    return (rec1->name_len == rec2->name_len) && !strncmp(rec1->name, rec2->name, rec1->name_len);
+}
+
 /**
  * @brief Callback for comparing two pattern records.
  */
@@ -310,6 +344,9 @@ ly_ctx_shared_data_remove_and_free(struct ly_ctx_shared_data *shared_data)
     lydict_clean(shared_data->data_dict);
     free(shared_data->data_dict);
     lyht_free(shared_data->leafref_links_ht, ly_ctx_ht_leafref_links_rec_free);
+    lyht_free(shared_data->digest_ht, NULL);
+    lyht_free(shared_data->desc_index_ht, lyd_desc_index_rec_free);
+    lyht_free(shared_data->schema_child_ht, NULL);
     free(shared_data);
 
     /* find */
@@ -376,12 +413,32 @@ ly_ctx_shared_data_create(const struct ly_ctx *ctx, struct ly_ctx_shared_data **
         LY_CHECK_ERR_GOTO(!(*shrd_data)->leafref_links_ht, rc = LY_EMEM, cleanup);
     }
 
+    /* data digest hash table */
+    (*shrd_data)->digest_ht = lyht_new(LYHT_MIN_SIZE, sizeof(struct lyd_digest_rec), ly_ctx_ht_digest_equal_cb, NULL, 1);
+    LY_CHECK_ERR_GOTO(!(*shrd_data)->digest_ht, rc = LY_EMEM, cleanup);
+
+    /* data descendant index hash table */
+    if (ctx->opts & LY_CTX_XPATH_DESC_INDEX) {
+        (*shrd_data)->desc_index_ht = lyht_new(LYHT_MIN_SIZE, sizeof(struct lyd_desc_index_rec),
+                ly_ctx_ht_desc_index_equal_cb, NULL, 1);
+        LY_CHECK_ERR_GOTO(!(*shrd_data)->desc_index_ht, rc = LY_EMEM, cleanup);
+    }
+
+    /* schema child index, a printed context is never compiled so index it now */
+    (*shrd_data)->schema_child_ht = lyht_new(LYHT_MIN_SIZE, sizeof(struct lysc_child_rec),
+            ly_ctx_ht_schema_child_equal_cb, NULL, 1);
+    LY_CHECK_ERR_GOTO(!(*shrd_data)->schema_child_ht, rc = LY_EMEM, cleanup);
+    if (ctx->opts & LY_CTX_INT_IMMUTABLE) {
+        LY_CHECK_GOTO(rc = lysc_child_index_build(ctx, (*shrd_data)->schema_child_ht), cleanup);
+    }
+
     /* ext clb and leafref links locks */
     pthread_mutexattr_init(&attr);
     pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
     pthread_mutex_init(&(*shrd_data)->ext_clb_lock, &attr);
     pthread_mutexattr_destroy(&attr);
     pthread_mutex_init(&(*shrd_data)->leafref_links_lock, NULL);
+    pthread_mutex_init(&(*shrd_data)->digest_lock, NULL);
 
     /* refcount */
     ATOMIC_STORE_RELAXED((*shrd_data)->refcount, 1);
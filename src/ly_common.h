@@ -347,6 +347,19 @@ struct ly_ctx_shared_data {
 
     pthread_mutex_t leafref_links_lock; /**< lock for accessing the leafref links hash table */
     struct ly_ht *leafref_links_ht;     /**< hash table of leafref links between term data nodes */
+
+    pthread_mutex_t digest_lock;    /**< lock for accessing the data digest and descendant index hash tables */
+    struct ly_ht *digest_ht;        /**< hash table of cached subtree digests of inner data nodes, see ::lyd_digest() */
+    ATOMIC_T digest_count;          /**< number of records in digest_ht, changed with the lock held, read without it
+                                         to skip the lookups if there are no cached digests */
+    struct ly_ht *desc_index_ht;    /**< hash table of cached descendant indexes of top-level data nodes, exists only
+                                         with ::LY_CTX_XPATH_DESC_INDEX */
+    ATOMIC_T desc_index_count;      /**< number of records in desc_index_ht, changed with the lock held, read without it
+                                         to skip the lookups if there are no cached indexes */
+
+    struct ly_ht *schema_child_ht;  /**< index of compiled schema node children, see ::lysc_child_index_build().
+                                      * This ht is only written to when the context is being compiled or when
+                                      * the shared data of a printed context are created, afterwards, it is read-only. */
 };
 
 #define LY_CTX_INT_IMMUTABLE 0x80000000 /**< marks a context that was printed into a fixed-size memory block and
@@ -372,6 +385,9 @@ struct ly_ctx {
     struct ly_set plugins_types;      /**< context specific set of type plugins */
     struct ly_set plugins_extensions; /**< contets specific set of extension plugins */
     struct ly_ctx *parent_ctx;        /**< pointer to the parent context whose shared and private data to use, if set */
+
+    struct ly_ht *mod_name_ht;        /**< modules from ::ly_ctx.modules hashed by their name */
+    struct ly_ht *mod_ns_ht;          /**< modules from ::ly_ctx.modules hashed by their namespace */
 };
 
 /**
@@ -381,6 +397,23 @@ struct ly_ctx {
  */
 void ly_ctx_new_change(struct ly_ctx *ctx);
 
+/**
+ * @brief Add a new module of a context into its module hash tables.
+ *
+ * @param[in] ctx Context of @p mod.
+ * @param[in] mod Module added into ::ly_ctx.modules.
+ * @return LY_ERR value.
+ */
+LY_ERR ly_ctx_mod_ht_add(struct ly_ctx *ctx, struct lys_module *mod);
+
+/**
+ * @brief Remove a module of a context from its module hash tables.
+ *
+ * @param[in] ctx Context of @p mod.
+ * @param[in] mod Module removed from ::ly_ctx.modules.
+ */
+void ly_ctx_mod_ht_remove(struct ly_ctx *ctx, struct lys_module *mod);
+
 /**
  * @brief Add a ctx data for a new context.
  *
@@ -447,6 +480,11 @@ ly_bool ly_ctx_ht_leafref_links_equal_cb(void *val1_p, void *val2_p, ly_bool mod
  */
 void ly_ctx_ht_leafref_links_rec_free(void *val_p);
 
+/**
+ * @brief Hash table value-equal callback for comparing data descendant index records.
+ */
+ly_bool ly_ctx_ht_desc_index_equal_cb(void *val1_p, void *val2_p, ly_bool mod, void *cb_data);
+
 /**
  * @brief Get the (only) implemented YANG module specified by its name.
  *
@@ -55,6 +55,7 @@
 #include "tree.h"
 #include "tree_data.h"
 #include "tree_data_internal.h"
+#include "tree_data_sorted.h"
 #include "tree_schema.h"
 #include "tree_schema_internal.h"
 #include "validation.h"
@@ -206,11 +207,17 @@ lyd_parser_create_term(struct lyd_ctx *lydctx, const struct lysc_node *schema, c
         const void *value, uint64_t value_size_bits, ly_bool *dynamic, LY_VALUE_FORMAT format, void *prefix_data,
         uint32_t hints, struct lyd_node **node)
 {
-    ly_bool incomplete;
+    ly_bool incomplete, ref_input = 0;
     ly_bool store_only = (lydctx->parse_opts & LYD_PARSE_STORE_ONLY) == LYD_PARSE_STORE_ONLY ? 1 : 0;
 
-    LY_CHECK_RET(lyd_create_term(schema, lnode, value, value_size_bits, 1, store_only, dynamic, format, prefix_data,
-            hints, &incomplete, node));
+    if ((lydctx->parse_opts & LYD_PARSE_REF_INPUT) && ((format == LY_VALUE_XML) || (format == LY_VALUE_JSON)) &&
+            (lydctx->data_ctx->in->type == LY_IN_MEMORY)) {
+        /* the value is in the input data owned by the caller */
+        ref_input = 1;
+    }
+
+    LY_CHECK_RET(lyd_create_term(schema, lnode, value, value_size_bits, 1, store_only, ref_input, dynamic, format,
+            prefix_data, hints, &incomplete, node));
 
     if (incomplete && !(lydctx->parse_opts & LYD_PARSE_ONLY)) {
         LY_CHECK_RET(ly_set_add(&lydctx->node_types, *node, 1, NULL));
@@ -418,7 +425,7 @@ lyd_parser_node_insert(struct lyd_node *parent, struct lyd_node **first_p, struc
         LY_CHECK_RET(lyd_insert_after(insert_anchor, node));
     } else {
         lyd_insert_node(parent, first_p, node,
-                parse_opts & LYD_PARSE_ORDERED ? LYD_INSERT_NODE_LAST : LYD_INSERT_NODE_DEFAULT);
+                parse_opts & LYD_PARSE_ORDERED ? LYD_INSERT_NODE_LAST : LYD_INSERT_NODE_DEFER_SORT);
     }
 
     /* adjust the first sibling pointer */
@@ -430,6 +437,25 @@ lyd_parser_node_insert(struct lyd_node *parent, struct lyd_node **first_p, struc
     return LY_SUCCESS;
 }
 
+LY_ERR
+lyd_parser_siblings_sort(struct lyd_node *parent, struct lyd_node **first_p, uint32_t parse_opts)
+{
+    struct lyd_node **first_sibling;
+
+    if (parse_opts & LYD_PARSE_ORDERED) {
+        /* nodes were inserted in order, BSTs are created only when needed */
+        return LY_SUCCESS;
+    }
+
+    first_sibling = parent ? lyd_node_child_p(parent) : first_p;
+    if (!first_sibling || !*first_sibling) {
+        /* no siblings */
+        return LY_SUCCESS;
+    }
+
+    return lyds_sort_siblings(first_sibling);
+}
+
 LY_ERR
 lys_parser_fill_filepath(struct ly_ctx *ctx, struct ly_in *in, const char **filepath)
 {
@@ -176,6 +176,11 @@ struct ly_in;
                                                 content. By default, unknown elements in anydata are parsed
                                                 as opaque nodes. With this flag, an error is raised for any unknown
                                                 elements within anydata/anyxml subtrees. */
+#define LYD_PARSE_REF_INPUT 0x10000000      /**< [XML](@ref howtoDataParsers) and [JSON](@ref howtoDataParsers) memory
+                                                 inputs only. Values of string-typed terminal nodes that need no unescaping
+                                                 are not inserted into the dictionary, only referenced in the input data.
+                                                 They are inserted once their canonical value is needed. The input data
+                                                 must not be freed or changed before the parsed tree is freed. */
 #define LYD_PARSE_OPTS_MASK 0xFFFF0000      /**< Mask for all the LYD_PARSE_ options. */
 
 /** @} dataparseroptions */
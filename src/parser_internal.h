@@ -92,8 +92,7 @@ struct lyd_ctx {
 
     struct {
         const struct ly_ctx *ctx;  /**< libyang context */
-        uint64_t line;             /**< current line */
-        struct ly_in *in;          /**< input structure */
+        struct ly_in *in;          /**< input structure, only for XML/JSON parser contexts */
     } *data_ctx;                   /**< generic pointer supposed to map to and access (common part of) XML/JSON/... parser contexts */
 };
 
@@ -118,6 +117,7 @@ struct lyd_xml_ctx {
     lyd_ctx_free_clb free;
 
     struct lyxml_ctx *xmlctx;      /**< XML context */
+    const struct lys_module *ns_mod; /**< last implemented module found by its namespace */
 };
 
 /**
@@ -142,6 +142,7 @@ struct lyd_json_ctx {
 
     struct lyjson_ctx *jsonctx;         /**< JSON context */
     const struct lysc_node *any_schema; /**< parent anyxml/anydata schema node if parsing nested data tree */
+    const struct lys_module *name_mod;  /**< last implemented module found by its name */
 };
 
 /**
@@ -449,6 +450,18 @@ void lyd_parser_node_free(struct lyd_node **first_p, struct lyd_node **node);
 LY_ERR lyd_parser_node_insert(struct lyd_node *parent, struct lyd_node **first_p, struct lyd_node *insert_anchor,
         uint32_t parse_opts, struct lyd_node *node);
 
+/**
+ * @brief Finish inserting parsed siblings, sort all the system-ordered (leaf-)list instances.
+ *
+ * Must be called once all the siblings on a level were parsed and inserted by ::lyd_parser_node_insert().
+ *
+ * @param[in] parent Data node parent, if any.
+ * @param[in,out] first_p First sibling on the level, if any.
+ * @param[in] parse_opts Parser options.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_parser_siblings_sort(struct lyd_node *parent, struct lyd_node **first_p, uint32_t parse_opts);
+
 /**
  * @brief Parse an instance extension statement.
  *
@@ -236,6 +236,32 @@ lydjson_data_skip(struct lyjson_ctx *jsonctx)
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Get an implemented module by its name, the last found module is remembered in the parser context.
+ *
+ * @param[in] lydctx JSON data parser context.
+ * @param[in] ctx Context to search in.
+ * @param[in] name Module name.
+ * @param[in] name_len Length of @p name.
+ * @return Found module, NULL if there is none.
+ */
+static struct lys_module *
+lydjson_get_module(struct lyd_json_ctx *lydctx, const struct ly_ctx *ctx, const char *name, uint32_t name_len)
+{
+    struct lys_module *mod = (struct lys_module *)lydctx->name_mod;
+
+    if (mod && (mod->ctx == ctx) && !ly_strncmp(mod->name, name, name_len)) {
+        /* the same module as the last time */
+        return mod;
+    }
+
+    mod = ly_ctx_get_module_implemented2(ctx, name, name_len);
+    if (mod) {
+        lydctx->name_mod = mod;
+    }
+    return mod;
+}
+
 /**
  * @brief Get schema node corresponding to the input parameters.
  *
@@ -275,8 +301,10 @@ lydjson_get_snode(struct lyd_json_ctx *lydctx, ly_bool is_attr, const char *pref
     }
     if (!prefix_len) {
         prefix = NULL;
+    } else {
+        mod = lydjson_get_module(lydctx, parent ? LYD_CTX(parent) : lydctx->jsonctx->ctx, prefix, prefix_len);
     }
-    r = lys_find_child_node(parent ? LYD_CTX(parent) : lydctx->jsonctx->ctx, sparent, NULL, prefix, prefix_len,
+    r = lys_find_child_node(parent ? LYD_CTX(parent) : lydctx->jsonctx->ctx, sparent, mod, prefix, prefix_len,
             LY_VALUE_JSON, NULL, name, name_len, getnext_opts, snode, ext);
     LY_CHECK_RET(r && (r != LY_ENOT), r);
 
@@ -288,7 +316,7 @@ lydjson_get_snode(struct lyd_json_ctx *lydctx, ly_bool is_attr, const char *pref
 
     /* generate error, find the module */
     if (prefix_len) {
-        mod = ly_ctx_get_module_implemented2(parent ? LYD_CTX(parent) : lydctx->jsonctx->ctx, prefix, prefix_len);
+        /* module already searched for */
     } else if (parent) {
         if (parent->schema) {
             mod = parent->schema->module;
@@ -833,7 +861,7 @@ next_entry:
         }
 
         /* get the element module */
-        mod = ly_ctx_get_module_implemented2(ctx, prefix, prefix_len);
+        mod = lydjson_get_module(lydctx, ctx, prefix, prefix_len);
         if (!mod) {
             if (lydctx->parse_opts & LYD_PARSE_STRICT) {
                 LOGVAL(ctx, prev, LYVE_REFERENCE,
@@ -1060,6 +1088,10 @@ lydjson_parse_opaq(struct lyd_json_ctx *lydctx, const char *name, uint32_t name_
     }
 
 finish:
+    /* sort the children */
+    ret = lyd_parser_siblings_sort(*node, NULL, lydctx->parse_opts);
+    LY_CHECK_GOTO(ret, cleanup);
+
     /* finish linking metadata */
     ret = lydjson_metadata_finish(lydctx, lyd_node_child_p(*node));
 
@@ -1342,6 +1374,10 @@ lydjson_parse_any(struct lyd_json_ctx *lydctx, const struct lysc_node *snode, co
             *status = lyjson_ctx_status(lydctx->jsonctx);
         } while (*status == LYJSON_OBJECT_NEXT);
 
+        /* sort the anydata content */
+        r = lyd_parser_siblings_sort(NULL, &((struct lyd_node_any *)*node)->child, lydctx->parse_opts);
+        LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
+
         /* finish linking metadata */
         r = lydjson_metadata_finish(lydctx, &((struct lyd_node_any *)*node)->child);
         LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
@@ -1405,6 +1441,10 @@ lydjson_parse_instance_inner(struct lyd_json_ctx *lydctx, const struct lysc_node
         *status = lyjson_ctx_status(lydctx->jsonctx);
     } while (*status == LYJSON_OBJECT_NEXT);
 
+    /* sort the children */
+    r = lyd_parser_siblings_sort(*node, NULL, lydctx->parse_opts);
+    LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
+
     /* finish linking metadata */
     r = lydjson_metadata_finish(lydctx, lyd_node_child_p(*node));
     LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
@@ -1971,6 +2011,10 @@ lyd_parse_json(const struct ly_ctx *ctx, struct lyd_node *parent, const struct l
         LY_DPARSER_ERR_GOTO(r, rc = r, lydctx, cleanup);
     }
 
+    /* sort the top-level siblings */
+    r = lyd_parser_siblings_sort(parent, first_p, lydctx->parse_opts);
+    LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
+
     /* finish linking metadata */
     r = lydjson_metadata_finish(lydctx, parent ? lyd_node_child_p(parent) : first_p);
     LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
@@ -2167,6 +2211,10 @@ lyd_parse_json_restconf(const struct ly_ctx *ctx, struct lyd_node *parent, struc
         }
     }
 
+    /* sort the top-level siblings */
+    r = lyd_parser_siblings_sort(parent, first_p, lydctx->parse_opts);
+    LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
+
     /* finish linking metadata */
     r = lydjson_metadata_finish(lydctx, parent ? lyd_node_child_p(parent) : first_p);
     LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
@@ -1011,7 +1011,7 @@ lyb_insert_node(struct lyd_lyb_ctx *lybctx, struct lyd_node *parent, struct lyd_
 {
     /* insert, keep first pointer correct */
     lyd_insert_node(parent, first_p, node,
-            lybctx->parse_opts & LYD_PARSE_ORDERED ? LYD_INSERT_NODE_LAST : LYD_INSERT_NODE_DEFAULT);
+            lybctx->parse_opts & LYD_PARSE_ORDERED ? LYD_INSERT_NODE_LAST : LYD_INSERT_NODE_DEFER_SORT);
     while (!parent && (*first_p)->prev->next) {
         *first_p = (*first_p)->prev;
     }
@@ -1623,7 +1623,8 @@ lyb_parse_siblings(struct lyd_lyb_ctx *lybctx, struct lyd_node *parent, ly_bool
     }
     LY_CHECK_RET(r != LY_ENOT, r);
 
-    return LY_SUCCESS;
+    /* sort the siblings */
+    return lyd_parser_siblings_sort(parent, first_p, lybctx->parse_opts);
 }
 
 /**
@@ -78,6 +78,31 @@ lydxml_log_namespace_err(const struct ly_ctx *ctx, const struct lyd_node *lnode,
     }
 }
 
+/**
+ * @brief Get an implemented module by its namespace, the last found module is remembered in the parser context.
+ *
+ * @param[in] lydctx XML data parser context.
+ * @param[in] ctx Context to search in.
+ * @param[in] ns Namespace URI.
+ * @return Found module, NULL if there is none.
+ */
+static const struct lys_module *
+lydxml_get_module_ns(struct lyd_xml_ctx *lydctx, const struct ly_ctx *ctx, const char *ns)
+{
+    const struct lys_module *mod = lydctx->ns_mod;
+
+    if (mod && (mod->ctx == ctx) && !strcmp(mod->ns, ns)) {
+        /* the same module as the last time */
+        return mod;
+    }
+
+    mod = ly_ctx_get_module_implemented_ns(ctx, ns);
+    if (mod) {
+        lydctx->ns_mod = mod;
+    }
+    return mod;
+}
+
 /**
  * @brief Parse and create XML metadata.
  *
@@ -162,7 +187,7 @@ lydxml_metadata(struct lyd_xml_ctx *lydctx, const struct lysc_node *sparent, con
         }
 
         /* get the module with metadata definition */
-        mod = ly_ctx_get_module_implemented_ns(xmlctx->ctx, ns->uri);
+        mod = (struct lys_module *)lydxml_get_module_ns(lydctx, xmlctx->ctx, ns->uri);
         if (!mod) {
             if (lydctx->parse_opts & LYD_PARSE_STRICT) {
                 LOG_LOCSET(sparent);
@@ -588,7 +613,13 @@ lydxml_subtree_get_snode(struct lyd_xml_ctx *lydctx, const struct lyd_node *pare
     if (!prefix_len) {
         prefix = NULL;
     }
-    r = lys_find_child_node(parent ? LYD_CTX(parent) : ctx, sparent, NULL, prefix, prefix_len, LY_VALUE_XML,
+
+    /* get the element module, use parent context if possible because of extensions */
+    ns = lyxml_ns_get(&xmlctx->ns, prefix, prefix_len);
+    if (ns) {
+        mod = lydxml_get_module_ns(lydctx, parent ? LYD_CTX(parent) : ctx, ns->uri);
+    }
+    r = lys_find_child_node(parent ? LYD_CTX(parent) : ctx, sparent, mod, prefix, prefix_len, LY_VALUE_XML,
             &lydctx->xmlctx->ns, name, name_len, getnext_opts, snode, ext);
     LY_CHECK_RET(r && (r != LY_ENOT), r);
 
@@ -600,7 +631,6 @@ lydxml_subtree_get_snode(struct lyd_xml_ctx *lydctx, const struct lyd_node *pare
     }
 
     /* generate error, check namespace */
-    ns = lyxml_ns_get(&xmlctx->ns, prefix, prefix_len);
     if (!ns && !(lydctx->int_opts & LYD_INTOPT_ANY)) {
         lydxml_log_namespace_err(xmlctx->ctx, parent, prefix, prefix_len, NULL, 0);
         return LY_EVALID;
@@ -609,10 +639,6 @@ lydxml_subtree_get_snode(struct lyd_xml_ctx *lydctx, const struct lyd_node *pare
         return LY_SUCCESS;
     }
 
-    if (ns) {
-        /* get the element module, use parent context if possible because of extensions */
-        mod = ly_ctx_get_module_implemented_ns(parent ? LYD_CTX(parent) : ctx, ns->uri);
-    }
     if (!mod) {
         if (ns) {
             LOGVAL(ctx, parent, LYVE_REFERENCE, "No module with namespace \"%s\" in the context.", ns->uri);
@@ -707,6 +733,8 @@ lydxml_subtree_opaq(struct lyd_xml_ctx *lydctx, const char *prefix, uint32_t pre
         rc = lydxml_subtree_r(lydctx, *node, lyd_node_child_p(*node), NULL);
         LY_CHECK_GOTO(rc, cleanup);
     }
+    rc = lyd_parser_siblings_sort(*node, NULL, lydctx->parse_opts);
+    LY_CHECK_GOTO(rc, cleanup);
 
     /* update the value */
     opaq = (struct lyd_node_opaq *)*node;
@@ -871,6 +899,8 @@ lydxml_subtree_inner(struct lyd_xml_ctx *lydctx, const struct lysc_node *snode,
         r = lyd_parser_node_insert(parent, first_p, NULL, lydctx->parse_opts, *node);
         LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
     }
+    r = lyd_parser_siblings_sort(*node, NULL, lydctx->parse_opts);
+    LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
 
     /* restore options */
     lydctx->parse_opts = prev_parse_opts;
@@ -976,6 +1006,8 @@ lydxml_subtree_any(struct lyd_xml_ctx *lydctx, const struct lysc_node *snode, co
             r = lydxml_subtree_r(lydctx, *node, &((struct lyd_node_any *)*node)->child, NULL);
             LY_DPARSER_ERR_GOTO(r, rc = r, lydctx, cleanup);
         }
+        r = lyd_parser_siblings_sort(NULL, &((struct lyd_node_any *)*node)->child, lydctx->parse_opts);
+        LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
     }
 
 cleanup:
@@ -1260,6 +1292,8 @@ lyd_parse_xml(const struct ly_ctx *ctx, struct lyd_node *parent, struct lyd_node
             break;
         }
     }
+    r = lyd_parser_siblings_sort(parent, first_p, lydctx->parse_opts);
+    LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
 
     /* close an opened element */
     if (close_elem) {
@@ -1547,6 +1581,7 @@ lyd_parse_xml_netconf(const struct ly_ctx *ctx, struct lyd_node *parent, struct
             break;
         }
     }
+    LY_CHECK_GOTO(rc = lyd_parser_siblings_sort(parent, first_p, lydctx->parse_opts), cleanup);
 
     /* close all opened elements */
     for (i = 0; i < close_elem; ++i) {
@@ -24,6 +24,7 @@
 #include "dict.h"
 #include "log.h"
 #include "ly_common.h"
+#include "plugins_internal.h"
 #include "plugins_types.h"
 #include "schema_compile.h"
 #include "set.h"
@@ -930,7 +931,7 @@ ly_path_dup_predicates(const struct ly_ctx *ctx, const struct ly_path_predicate
     LY_ARRAY_CREATE_RET(ctx, *dup, LY_ARRAY_COUNT(pred), LY_EMEM);
     LY_ARRAY_FOR(pred, u) {
         LY_ARRAY_INCREMENT(*dup);
-        (*dup)[u].type = pred->type;
+        (*dup)[u].type = pred[u].type;
 
         switch (pred[u].type) {
         case LY_PATH_PREDTYPE_POSITION:
@@ -1346,7 +1347,10 @@ ly_path_eval_partial(const struct ly_path *path, const struct lyd_node *ctx_node
     }
 
     LY_ARRAY_FOR(path, u) {
-        if (path[u].predicates) {
+        if (path[u].inst) {
+            /* we will use hashes to find the instance prepared before */
+            lyd_find_sibling_first(ctx_node, path[u].inst, &node);
+        } else if (path[u].predicates) {
             switch (path[u].predicates[0].type) {
             case LY_PATH_PREDTYPE_POSITION:
                 /* we cannot use hashes and want an instance on a specific position */
@@ -1363,7 +1367,7 @@ ly_path_eval_partial(const struct ly_path *path, const struct lyd_node *ctx_node
             case LY_PATH_PREDTYPE_LEAFLIST:
                 /* we will use hashes to find one leaf-list instance */
                 LY_CHECK_RET(lyd_create_term(path[u].node, prev_node, path[u].predicates[0].value,
-                        strlen(path[u].predicates[0].value) * 8, 1, 1, NULL, LY_VALUE_CANON, NULL, LYD_HINT_DATA,
+                        strlen(path[u].predicates[0].value) * 8, 1, 1, 0, NULL, LY_VALUE_CANON, NULL, LYD_HINT_DATA,
                         NULL, &target));
                 lyd_find_sibling_first(ctx_node, target, &node);
                 lyd_free_tree(target);
@@ -1454,6 +1458,162 @@ ly_path_eval(const struct ly_path *path, const struct lyd_node *ctx_node, const
     return LY_ENOTFOUND;
 }
 
+/**
+ * @brief Learn whether key predicates include a variable.
+ *
+ * @param[in] predicates Predicates to examine.
+ * @return Whether a variable is used.
+ */
+static ly_bool
+ly_path_pred_has_var(const struct ly_path_predicate *predicates)
+{
+    LY_ARRAY_COUNT_TYPE u;
+
+    LY_ARRAY_FOR(predicates, u) {
+        if (predicates[u].type == LY_PATH_PREDTYPE_LIST_VAR) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+LY_ERR
+ly_path_prepare_insts(struct ly_path *path)
+{
+    LY_ARRAY_COUNT_TYPE u;
+
+    LY_ARRAY_FOR(path, u) {
+        if (path[u].inst || !path[u].predicates) {
+            continue;
+        }
+
+        switch (path[u].predicates[0].type) {
+        case LY_PATH_PREDTYPE_POSITION:
+        case LY_PATH_PREDTYPE_LIST_VAR:
+            /* cannot be prepared */
+            break;
+        case LY_PATH_PREDTYPE_LEAFLIST:
+            LY_CHECK_RET(lyd_create_term(path[u].node, NULL, path[u].predicates[0].value,
+                    strlen(path[u].predicates[0].value) * 8, 1, 1, 0, NULL, LY_VALUE_CANON, NULL, LYD_HINT_DATA, NULL,
+                    &path[u].inst));
+            break;
+        case LY_PATH_PREDTYPE_LIST:
+            if (ly_path_pred_has_var(path[u].predicates)) {
+                /* instance prepared when the variables are bound */
+                break;
+            }
+            LY_CHECK_RET(lyd_create_list(path[u].node, path[u].predicates, NULL, 1, &path[u].inst));
+            break;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+LY_ERR
+ly_path_bind_var(struct ly_path *path, const char *name, const struct lyd_value *value, const void *val,
+        uint64_t val_size_bits, LY_VALUE_FORMAT format)
+{
+    LY_ERR rc = LY_SUCCESS;
+    const struct ly_ctx *ctx = path[0].node->module->ctx;
+    struct ly_path_predicate *pred;
+    struct lyd_node *key;
+    struct lyd_node_term *term;
+    struct lyd_value stored;
+    LY_ARRAY_COUNT_TYPE u, v, w;
+    ly_bool found = 0;
+
+    LY_ARRAY_FOR(path, u) {
+        LY_ARRAY_FOR(path[u].predicates, v) {
+            pred = &path[u].predicates[v];
+            if ((pred->type != LY_PATH_PREDTYPE_LIST_VAR) || strcmp(pred->variable, name)) {
+                continue;
+            }
+
+            if (!path[u].inst) {
+                /* create the list instance with only the keys that are not variables */
+                LY_CHECK_RET(lyd_create_inner(path[u].node, &path[u].inst));
+                LY_ARRAY_FOR(path[u].predicates, w) {
+                    if (path[u].predicates[w].type == LY_PATH_PREDTYPE_LIST_VAR) {
+                        continue;
+                    }
+                    LY_CHECK_RET(lyd_create_term(path[u].predicates[w].key, NULL, path[u].predicates[w].value,
+                            strlen(path[u].predicates[w].value) * 8, 1, 1, 0, NULL, LY_VALUE_JSON, NULL, LYD_HINT_DATA,
+                            NULL, &key));
+                    lyd_insert_node(path[u].inst, NULL, key, LYD_INSERT_NODE_DEFAULT);
+                }
+            }
+
+            /* store the value */
+            if (value) {
+                LY_CHECK_RET(lyd_value_store_from(pred->key, value, &stored));
+            } else {
+                LY_CHECK_RET(lyd_value_store(ctx, NULL, &stored, ((struct lysc_node_leaf *)pred->key)->type, val,
+                        val_size_bits, 0, 0, 0, NULL, format, NULL, LYD_HINT_DATA, pred->key, NULL));
+            }
+
+            /* find the key instance */
+            LY_LIST_FOR(lyd_child(path[u].inst), key) {
+                if (key->schema == pred->key) {
+                    break;
+                }
+            }
+
+            if (key) {
+                /* replace the bound value */
+                term = (struct lyd_node_term *)key;
+                LYSC_GET_TYPE_PLG(term->value.realtype->plugin_ref)->free(ctx, &term->value);
+                term->value = stored;
+                lyd_hash(key);
+                lyd_hash(path[u].inst);
+            } else {
+                /* insert a new key, the list is hashed once it has all the keys */
+                LY_CHECK_RET(lyd_create_term2(pred->key, &stored, &key));
+                lyd_insert_node(path[u].inst, NULL, key, LYD_INSERT_NODE_DEFAULT);
+            }
+            found = 1;
+        }
+    }
+
+    if (!found) {
+        LOGERR(ctx, LY_ENOTFOUND, "Variable \"%s\" not used in the path.", name);
+        rc = LY_ENOTFOUND;
+    }
+    return rc;
+}
+
+const char *
+ly_path_unbound_var(const struct ly_path *path)
+{
+    LY_ARRAY_COUNT_TYPE u, v;
+    const struct lyd_node *key;
+
+    LY_ARRAY_FOR(path, u) {
+        LY_ARRAY_FOR(path[u].predicates, v) {
+            if (path[u].predicates[v].type != LY_PATH_PREDTYPE_LIST_VAR) {
+                continue;
+            }
+
+            /* the prepared instance includes the key only after the variable was bound */
+            if (path[u].inst) {
+                LY_LIST_FOR(lyd_child(path[u].inst), key) {
+                    if (key->schema == path[u].predicates[v].key) {
+                        break;
+                    }
+                }
+            } else {
+                key = NULL;
+            }
+            if (!key) {
+                return path[u].predicates[v].variable;
+            }
+        }
+    }
+
+    return NULL;
+}
+
 LY_ERR
 ly_path_dup(const struct ly_ctx *ctx, const struct ly_path *path, struct ly_path **dup)
 {
@@ -1469,8 +1629,10 @@ ly_path_dup(const struct ly_ctx *ctx, const struct ly_path *path, struct ly_path
         LY_ARRAY_INCREMENT(*dup);
         (*dup)[u].node = path[u].node;
         (*dup)[u].ext = path[u].ext;
-        LY_CHECK_RET(ret = ly_path_dup_predicates(ctx, path[u].predicates, &(*dup)[u].predicates), ret);
+        (*dup)[u].predicates = NULL;
         (*dup)[u].doc_root = path[u].doc_root;
+        (*dup)[u].inst = NULL;
+        LY_CHECK_RET(ret = ly_path_dup_predicates(ctx, path[u].predicates, &(*dup)[u].predicates), ret);
     }
 
     return LY_SUCCESS;
@@ -1513,6 +1675,7 @@ ly_path_free(struct ly_path *path)
 
     LY_ARRAY_FOR(path, u) {
         ly_path_predicates_free(path[u].node->module->ctx, path[u].predicates);
+        lyd_free_tree(path[u].inst);
     }
     LY_ARRAY_FREE(path);
 }
@@ -81,6 +81,9 @@ struct ly_path {
     struct ly_path_predicate *predicates;   /**< [Sized array](@ref sizedarrays) of the path segment's predicates. */
     ly_bool doc_root;                       /**< Node is relative to the document root, set for the first node in an
                                                  absolute path, unset for all nodes in a relative path. */
+    struct lyd_node *inst;                  /**< Optional prepared instance of @p node with the @p predicates values
+                                                 used for finding the data instance using hashes, see
+                                                 ::ly_path_prepare_insts(). */
 };
 
 /**
@@ -245,6 +248,38 @@ LY_ERR ly_path_eval_partial(const struct ly_path *path, const struct lyd_node *c
 LY_ERR ly_path_eval(const struct ly_path *path, const struct lyd_node *ctx_node, const struct lyxp_var *vars,
         struct lyd_node **match);
 
+/**
+ * @brief Prepare the instances of all the list and leaf-list path segments with key or value predicates so that
+ * they do not have to be created every time the path is evaluated.
+ *
+ * @param[in,out] path Path to prepare.
+ * @return LY_ERR value.
+ */
+LY_ERR ly_path_prepare_insts(struct ly_path *path);
+
+/**
+ * @brief Bind a value to a key predicate variable by storing it in the prepared list instances.
+ *
+ * @param[in,out] path Path with the variable.
+ * @param[in] name Variable name.
+ * @param[in] value Stored value to bind, if set, @p val is ignored.
+ * @param[in] val Value to bind in @p format.
+ * @param[in] val_size_bits Size of @p val in bits.
+ * @param[in] format Format of @p val.
+ * @return LY_ENOTFOUND if the variable is not used in @p path.
+ * @return LY_ERR value.
+ */
+LY_ERR ly_path_bind_var(struct ly_path *path, const char *name, const struct lyd_value *value, const void *val,
+        uint64_t val_size_bits, LY_VALUE_FORMAT format);
+
+/**
+ * @brief Get a key predicate variable that has no value bound.
+ *
+ * @param[in] path Path to examine.
+ * @return Name of the first unbound variable, NULL if there is none.
+ */
+const char *ly_path_unbound_var(const struct ly_path *path);
+
 /**
  * @brief Duplicate ly_path structure.
  *
@@ -51,9 +51,7 @@ static inline const char *
 lyd_get_meta_value(const struct lyd_meta *meta)
 {
     if (meta) {
-        const struct lyd_value *value = &meta->value;
-
-        return value->_canonical ? value->_canonical : lyd_value_get_canonical(meta->annotation->module->ctx, value);
+        return lyd_value_get_canonical(meta->annotation->module->ctx, &meta->value);
     }
 
     return NULL;
@@ -205,13 +205,39 @@ LIBYANG_API_DEF const void *
 lyplg_type_print_simple(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *value, LY_VALUE_FORMAT UNUSED(format),
         void *UNUSED(prefix_data), ly_bool *dynamic, uint64_t *value_size_bits)
 {
+    /* may be published concurrently by ::lyplg_type_set_canonical() */
+    const char *canon = ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical);
+
     if (dynamic) {
         *dynamic = 0;
     }
     if (value_size_bits) {
-        *value_size_bits = ly_strlen(value->_canonical) * 8;
+        *value_size_bits = ly_strlen(canon) * 8;
+    }
+    return canon;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyplg_type_set_canonical(const struct ly_ctx *ctx, const struct lyd_value *value, const char *canon, size_t canon_len,
+        ly_bool dynamic)
+{
+    LY_ERR r;
+    const char *str;
+    struct lyd_value *val = (struct lyd_value *)value;
+
+    if (dynamic) {
+        r = lydict_insert_zc(ctx, (char *)canon, &str);
+    } else {
+        r = lydict_insert(ctx, canon, canon_len, &str);
     }
-    return value->_canonical;
+    LY_CHECK_RET(r);
+
+    if (!ATOMIC_PTR_CAS(val->_canonical, NULL, str)) {
+        /* published by another reader in the meantime, they are equal */
+        lydict_remove(ctx, str);
+    }
+
+    return LY_SUCCESS;
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -1003,7 +1029,7 @@ lyplg_type_resolve_leafref(const struct lysc_type_leafref *lref, const struct ly
 
     /* find the target data instance(s) */
     rc = lyxp_eval(LYD_CTX(node), target_path ? target_path : lref->path, node->schema->module,
-            LY_VALUE_SCHEMA_RESOLVED, lref->prefixes, node, node, tree, NULL, &set, LYXP_IGNORE_WHEN);
+            LY_VALUE_SCHEMA_RESOLVED, lref->prefixes, node, node, tree, NULL, NULL, &set, LYXP_IGNORE_WHEN);
     if (rc) {
         e = ly_err_last(LYD_CTX(node));
         if (e && (e->err == rc)) {
@@ -486,6 +486,9 @@ LIBYANG_API_DECL typedef void (*lyplg_type_lyb_size_clb)(const struct lysc_type
                                              the value, make the module implemented. */
 #define LYPLG_TYPE_STORE_IS_UTF8   0x04 /**< The value is guaranteed to be a valid UTF-8 string, if applicable for the type. */
 #define LYPLG_TYPE_STORE_ONLY      0x08 /**< The value is stored only, type-specific validation is skipped (performed before) */
+#define LYPLG_TYPE_STORE_REF_INPUT 0x10 /**< The value is part of input data that are not freed or changed before the
+                                             stored value. Plugins may only reference it and insert it into the dictionary
+                                             once its canonical value is needed. */
 /**
  * @} plugintypestoreopts
  */
@@ -702,6 +705,23 @@ LIBYANG_API_DEF int lyplg_type_sort_simple(const struct ly_ctx *ctx, const struc
 LIBYANG_API_DECL const void *lyplg_type_print_simple(const struct ly_ctx *ctx, const struct lyd_value *value,
         LY_VALUE_FORMAT format, void *prefix_data, ly_bool *dynamic, uint64_t *value_size_bits);
 
+/**
+ * @brief Publish a canonical value generated on demand by a ::lyplg_type_print_clb callback.
+ *
+ * Type plugins that do not generate ::lyd_value._canonical when storing a value must set it using this function
+ * so that concurrent readers of a single data tree (refer to @ref howtoThreads) never overwrite each other's
+ * canonical value. If another thread has already published a canonical value, @p canon is discarded.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] value Value to set the canonical value of.
+ * @param[in] canon Canonical value.
+ * @param[in] canon_len Length of @p canon, 0 to use strlen().
+ * @param[in] dynamic Whether @p canon is dynamically allocated and should be consumed (even on error).
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyplg_type_set_canonical(const struct ly_ctx *ctx, const struct lyd_value *value,
+        const char *canon, size_t canon_len, ly_bool dynamic);
+
 /**
  * @brief Implementation of ::lyplg_type_dup_clb for a generic simple type.
  */
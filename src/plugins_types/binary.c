@@ -426,14 +426,14 @@ lyplg_type_print_binary(const struct ly_ctx *ctx, const struct lyd_value *value,
     }
 
     /* generate canonical value if not already */
-    if (!value->_canonical) {
+    if (!ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) {
         /* get the base64 string value */
         if (binary_base64_encode(ctx, val->data, val->size, &ret, &ret_size)) {
             return NULL;
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lyplg_type_set_canonical(ctx, value, ret, 0, 1)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -444,9 +444,9 @@ lyplg_type_print_binary(const struct ly_ctx *ctx, const struct lyd_value *value,
         *dynamic = 0;
     }
     if (value_size_bits) {
-        *value_size_bits = ret_size ? ret_size * 8 : strlen(value->_canonical) * 8;
+        *value_size_bits = ret_size ? ret_size * 8 : strlen(ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) * 8;
     }
-    return value->_canonical;
+    return ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical);
 }
 
 static LY_ERR
@@ -408,14 +408,14 @@ lyplg_type_print_bits(const struct ly_ctx *ctx, const struct lyd_value *value, L
     }
 
     /* generate canonical value if not already */
-    if (!value->_canonical) {
+    if (!ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) {
         /* get the canonical value */
         if (bits_items2canon(val->items, &ret)) {
             return NULL;
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lyplg_type_set_canonical(ctx, value, ret, 0, 1)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -426,9 +426,9 @@ lyplg_type_print_bits(const struct ly_ctx *ctx, const struct lyd_value *value, L
         *dynamic = 0;
     }
     if (value_len_bits) {
-        *value_len_bits = strlen(value->_canonical) * 8;
+        *value_len_bits = strlen(ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) * 8;
     }
-    return value->_canonical;
+    return ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical);
 }
 
 static LY_ERR
@@ -284,7 +284,7 @@ lyplg_type_print_ipv4_address(const struct ly_ctx *ctx, const struct lyd_value *
     }
 
     /* generate canonical value if not already */
-    if (!value->_canonical) {
+    if (!ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) {
         /* '%' + zone */
         zone_len = val->zone ? strlen(val->zone) + 1 : 0;
         ret = malloc(INET_ADDRSTRLEN + zone_len);
@@ -303,7 +303,7 @@ lyplg_type_print_ipv4_address(const struct ly_ctx *ctx, const struct lyd_value *
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lyplg_type_set_canonical(ctx, value, ret, 0, 1)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -314,9 +314,9 @@ lyplg_type_print_ipv4_address(const struct ly_ctx *ctx, const struct lyd_value *
         *dynamic = 0;
     }
     if (value_size_bits) {
-        *value_size_bits = strlen(value->_canonical) * 8;
+        *value_size_bits = strlen(ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) * 8;
     }
-    return value->_canonical;
+    return ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical);
 }
 
 /**
@@ -175,7 +175,7 @@ lyplg_type_print_ipv4_address_no_zone(const struct ly_ctx *ctx, const struct lyd
     }
 
     /* generate canonical value if not already (loaded from LYB) */
-    if (!value->_canonical) {
+    if (!ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) {
         ret = malloc(INET_ADDRSTRLEN);
         LY_CHECK_RET(!ret, NULL);
 
@@ -187,7 +187,7 @@ lyplg_type_print_ipv4_address_no_zone(const struct ly_ctx *ctx, const struct lyd
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lyplg_type_set_canonical(ctx, value, ret, 0, 1)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -198,9 +198,9 @@ lyplg_type_print_ipv4_address_no_zone(const struct ly_ctx *ctx, const struct lyd
         *dynamic = 0;
     }
     if (value_size_bits) {
-        *value_size_bits = strlen(value->_canonical) * 8;
+        *value_size_bits = strlen(ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) * 8;
     }
-    return value->_canonical;
+    return ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical);
 }
 
 /**
@@ -265,7 +265,7 @@ lyplg_type_print_ipv4_address_prefix(const struct ly_ctx *ctx, const struct lyd_
     }
 
     /* generate canonical value if not already */
-    if (!value->_canonical) {
+    if (!ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) {
         /* IPv4 mask + '/' + prefix */
         ret = malloc(INET_ADDRSTRLEN + 3);
         LY_CHECK_RET(!ret, NULL);
@@ -280,7 +280,7 @@ lyplg_type_print_ipv4_address_prefix(const struct ly_ctx *ctx, const struct lyd_
         sprintf(ret + strlen(ret), "/%" PRIu8, val->prefix);
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lyplg_type_set_canonical(ctx, value, ret, 0, 1)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -291,9 +291,9 @@ lyplg_type_print_ipv4_address_prefix(const struct ly_ctx *ctx, const struct lyd_
         *dynamic = 0;
     }
     if (value_size_bits) {
-        *value_size_bits = strlen(value->_canonical) * 8;
+        *value_size_bits = strlen(ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) * 8;
     }
-    return value->_canonical;
+    return ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical);
 }
 
 /**
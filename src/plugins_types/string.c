@@ -57,14 +57,63 @@ string_check_chars(const char *value, uint32_t value_size, struct ly_err_item **
     return LY_SUCCESS;
 }
 
-LIBYANG_API_DEF LY_ERR
-lyplg_type_store_string(const struct ly_ctx *ctx, const struct lysc_type *type, const void *value, uint64_t value_size_bits,
-        uint32_t options, LY_VALUE_FORMAT format, void *UNUSED(prefix_data), uint32_t hints,
-        const struct lysc_node *UNUSED(ctx_node), struct lyd_value *storage, struct lys_glob_unres *UNUSED(unres),
+/**
+ * @brief String value referenced in the input data, stored instead of the canonical value.
+ *
+ * Used only by the string plugin callbacks with ::LYPLG_TYPE_STORE_REF_INPUT.
+ */
+struct lyd_value_string_ref {
+    const char *str;    /**< string in the input data, not terminated */
+    uint64_t len;       /**< length of @p str */
+};
+
+/**
+ * @brief Validate string value restrictions.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] type String type.
+ * @param[in] value String value.
+ * @param[in] value_len Length of @p value.
+ * @param[out] err Generated error on error.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+string_validate(const struct ly_ctx *ctx, const struct lysc_type *type, const char *value, size_t value_len,
+        struct ly_err_item **err)
+{
+    LY_ERR ret;
+    struct lysc_type_str *type_str = (struct lysc_type_str *)type;
+
+    *err = NULL;
+
+    /* length restriction of the string */
+    if (type_str->length) {
+        /* value_len is in bytes, but we need number of characters here */
+        ret = lyplg_type_validate_range(LY_TYPE_STRING, type_str->length, ly_utf8len(value, value_len), value, value_len, err);
+        LY_CHECK_RET(ret);
+    }
+
+    /* pattern restrictions */
+    ret = lyplg_type_validate_patterns(ctx, type_str->patterns, value, value_len, err);
+    LY_CHECK_RET(ret);
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Store a string value.
+ *
+ * @param[in] ref_input Whether the value may only be referenced if ::LYPLG_TYPE_STORE_REF_INPUT is set.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+string_store(const struct ly_ctx *ctx, const struct lysc_type *type, const void *value, uint64_t value_size_bits,
+        uint32_t options, LY_VALUE_FORMAT format, uint32_t hints, struct lyd_value *storage, ly_bool ref_input,
         struct ly_err_item **err)
 {
     LY_ERR ret = LY_SUCCESS;
     uint32_t value_size;
+    struct lyd_value_string_ref *ref = NULL;
 
     /* init storage */
     memset(storage, 0, sizeof *storage);
@@ -92,6 +141,11 @@ lyplg_type_store_string(const struct ly_ctx *ctx, const struct lysc_type *type,
 
         /* value may have been freed */
         value = storage->_canonical;
+    } else if (ref_input && (options & LYPLG_TYPE_STORE_REF_INPUT) && (sizeof *ref <= LYD_VALUE_FIXED_MEM_SIZE)) {
+        /* only reference the value, it is inserted into the dictionary when needed */
+        LYD_VALUE_GET(storage, ref);
+        ref->str = value_size ? value : "";
+        ref->len = value_size;
     } else {
         ret = lydict_insert(ctx, value_size ? value : "", value_size, &storage->_canonical);
         LY_CHECK_GOTO(ret, cleanup);
@@ -99,7 +153,11 @@ lyplg_type_store_string(const struct ly_ctx *ctx, const struct lysc_type *type,
 
     if (!(options & LYPLG_TYPE_STORE_ONLY)) {
         /* validate value */
-        ret = lyplg_type_validate_value_string(ctx, type, storage, err);
+        if (storage->_canonical) {
+            ret = string_validate(ctx, type, storage->_canonical, strlen(storage->_canonical), err);
+        } else {
+            ret = string_validate(ctx, type, ref->str, ref->len, err);
+        }
         LY_CHECK_GOTO(ret, cleanup);
     }
 
@@ -114,30 +172,112 @@ cleanup:
     return ret;
 }
 
+LIBYANG_API_DEF LY_ERR
+lyplg_type_store_string(const struct ly_ctx *ctx, const struct lysc_type *type, const void *value, uint64_t value_size_bits,
+        uint32_t options, LY_VALUE_FORMAT format, void *UNUSED(prefix_data), uint32_t hints,
+        const struct lysc_node *UNUSED(ctx_node), struct lyd_value *storage, struct lys_glob_unres *UNUSED(unres),
+        struct ly_err_item **err)
+{
+    /* plugins reusing this callback expect the canonical value to always be stored */
+    return string_store(ctx, type, value, value_size_bits, options, format, hints, storage, 0, err);
+}
+
+/**
+ * @brief Implementation of ::lyplg_type_store_clb for the built-in string type.
+ *
+ * Supports ::LYPLG_TYPE_STORE_REF_INPUT, the value is then referenced until its canonical value is needed.
+ */
+static LY_ERR
+lyplg_type_store_string_ref(const struct ly_ctx *ctx, const struct lysc_type *type, const void *value,
+        uint64_t value_size_bits, uint32_t options, LY_VALUE_FORMAT format, void *UNUSED(prefix_data), uint32_t hints,
+        const struct lysc_node *UNUSED(ctx_node), struct lyd_value *storage, struct lys_glob_unres *UNUSED(unres),
+        struct ly_err_item **err)
+{
+    return string_store(ctx, type, value, value_size_bits, options, format, hints, storage, 1, err);
+}
+
 LIBYANG_API_DEF LY_ERR
 lyplg_type_validate_value_string(const struct ly_ctx *ctx, const struct lysc_type *type, struct lyd_value *storage,
         struct ly_err_item **err)
 {
-    LY_ERR ret;
-    struct lysc_type_str *type_str = (struct lysc_type_str *)type;
-    const void *value;
-    size_t value_len;
+    const char *value;
 
     LY_CHECK_ARG_RET(NULL, type, storage, err, LY_EINVAL);
     value = lyd_value_get_canonical(ctx, storage);
-    value_len = strlen(value);
-    *err = NULL;
 
-    /* length restriction of the string */
-    if (type_str->length) {
-        /* value_len is in bytes, but we need number of characters here */
-        ret = lyplg_type_validate_range(LY_TYPE_STRING, type_str->length, ly_utf8len(value, value_len), value, value_len, err);
-        LY_CHECK_RET(ret);
+    return string_validate(ctx, type, value, strlen(value), err);
+}
+
+/**
+ * @brief Implementation of ::lyplg_type_validate_value_clb for the built-in string type.
+ */
+static LY_ERR
+lyplg_type_validate_value_string_ref(const struct ly_ctx *ctx, const struct lysc_type *type, struct lyd_value *storage,
+        struct ly_err_item **err)
+{
+    struct lyd_value_string_ref *ref;
+
+    LY_CHECK_ARG_RET(NULL, type, storage, err, LY_EINVAL);
+
+    if (storage->_canonical) {
+        return string_validate(ctx, type, storage->_canonical, strlen(storage->_canonical), err);
     }
 
-    /* pattern restrictions */
-    ret = lyplg_type_validate_patterns(ctx, type_str->patterns, value, value_len, err);
-    LY_CHECK_RET(ret);
+    LYD_VALUE_GET(storage, ref);
+    return string_validate(ctx, type, ref->str, ref->len, err);
+}
+
+/**
+ * @brief Implementation of ::lyplg_type_print_clb for the built-in string type.
+ */
+static const void *
+lyplg_type_print_string_ref(const struct ly_ctx *ctx, const struct lyd_value *value, LY_VALUE_FORMAT format,
+        void *prefix_data, ly_bool *dynamic, uint64_t *value_size_bits)
+{
+    struct lyd_value_string_ref *ref;
+
+    if (!ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) {
+        LYD_VALUE_GET(value, ref);
+        if (format == LY_VALUE_LYB) {
+            /* LYB value is not terminated, print the referenced value directly (used for hashes without a context) */
+            if (dynamic) {
+                *dynamic = 0;
+            }
+            if (value_size_bits) {
+                *value_size_bits = ref->len * 8;
+            }
+            return ref->str;
+        }
+
+        /* referenced value, insert it into the dictionary now */
+        if (lyplg_type_set_canonical(ctx, value, ref->str, ref->len, 0)) {
+            return NULL;
+        }
+    }
+
+    return lyplg_type_print_simple(ctx, value, format, prefix_data, dynamic, value_size_bits);
+}
+
+/**
+ * @brief Implementation of ::lyplg_type_dup_clb for the built-in string type.
+ */
+static LY_ERR
+lyplg_type_dup_string_ref(const struct ly_ctx *ctx, const struct lyd_value *original, struct lyd_value *dup)
+{
+    LY_ERR r;
+    struct lyd_value_string_ref *ref;
+
+    if (original->_canonical) {
+        return lyplg_type_dup_simple(ctx, original, dup);
+    }
+
+    /* the duplicate does not reference the input data */
+    memset(dup, 0, sizeof *dup);
+    LYD_VALUE_GET(original, ref);
+    if ((r = lydict_insert(ctx, ref->str, ref->len, &dup->_canonical))) {
+        return r;
+    }
+    dup->realtype = original->realtype;
 
     return LY_SUCCESS;
 }
@@ -157,13 +297,13 @@ const struct lyplg_type_record plugins_string[] = {
 
         .plugin.id = "ly2 string",
         .plugin.lyb_size = lyplg_type_lyb_size_variable_bytes,
-        .plugin.store = lyplg_type_store_string,
-        .plugin.validate_value = lyplg_type_validate_value_string,
+        .plugin.store = lyplg_type_store_string_ref,
+        .plugin.validate_value = lyplg_type_validate_value_string_ref,
         .plugin.validate_tree = NULL,
         .plugin.compare = lyplg_type_compare_simple,
         .plugin.sort = lyplg_type_sort_simple,
-        .plugin.print = lyplg_type_print_simple,
-        .plugin.duplicate = lyplg_type_dup_simple,
+        .plugin.print = lyplg_type_print_string_ref,
+        .plugin.duplicate = lyplg_type_dup_string_ref,
         .plugin.free = lyplg_type_free_simple,
     },
     {0}
@@ -410,7 +410,7 @@ lyplg_type_print_time(const struct ly_ctx *ctx, const struct lyd_value *value, L
     }
 
     /* generate canonical value if not already */
-    if (!value->_canonical) {
+    if (!ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) {
         if (val_nz || (val && val->unknown_tz)) {
             if (val) {
                 t = val->seconds;
@@ -431,7 +431,7 @@ lyplg_type_print_time(const struct ly_ctx *ctx, const struct lyd_value *value, L
             }
 
             /* store it */
-            if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+            if (lyplg_type_set_canonical(ctx, value, ret, 0, 1)) {
                 LOGMEM(ctx);
                 return NULL;
             }
@@ -445,7 +445,7 @@ lyplg_type_print_time(const struct ly_ctx *ctx, const struct lyd_value *value, L
             memmove(ret, ret + 11, strlen(ret + 11) + 1);
 
             /* store it */
-            if (lydict_insert(ctx, ret, 0, (const char **)&value->_canonical)) {
+            if (lyplg_type_set_canonical(ctx, value, ret, 0, 0)) {
                 free(ret);
                 LOGMEM(ctx);
                 return NULL;
@@ -459,9 +459,9 @@ lyplg_type_print_time(const struct ly_ctx *ctx, const struct lyd_value *value, L
         *dynamic = 0;
     }
     if (value_size_bits) {
-        *value_size_bits = strlen(value->_canonical) * 8;
+        *value_size_bits = strlen(ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical)) * 8;
     }
-    return value->_canonical;
+    return ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical);
 }
 
 /**
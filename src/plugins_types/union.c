@@ -701,9 +701,9 @@ lyplg_type_print_union(const struct ly_ctx *ctx, const struct lyd_value *value,
     assert(format != LY_VALUE_LYB);
     ret = (void *)LYSC_GET_TYPE_PLG(subvalue->value.realtype->plugin_ref)->print(ctx, &subvalue->value,
             format, prefix_data, dynamic, value_size_bits);
-    if (!value->_canonical && (format == LY_VALUE_CANON)) {
+    if (!ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical) && (format == LY_VALUE_CANON)) {
         /* the canonical value is supposed to be stored now */
-        lydict_insert(ctx, subvalue->value._canonical, 0, (const char **)&value->_canonical);
+        lyplg_type_set_canonical(ctx, value, subvalue->value._canonical, 0, 0);
     }
 
     return ret;
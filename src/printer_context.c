@@ -542,6 +542,15 @@ ctxs_module(const struct lys_module *mod, struct ly_ht *ht, int *size)
     *size += CTXS_SIZED_ARRAY(mod->deviated_by);
 }
 
+static void
+ctxs_mod_ht(const struct ly_ht *ht, int *size)
+{
+    /* hash table with its hlists and records */
+    *size += LY_CTXP_MEM_SIZE(sizeof *ht);
+    *size += LY_CTXP_MEM_SIZE(ht->size * sizeof *ht->hlists);
+    *size += LY_CTXP_MEM_SIZE(ht->size * ht->rec_size);
+}
+
 void
 ly_ctx_compiled_size_context(const struct ly_ctx *ctx, struct ly_ht *addr_ht, int *size)
 {
@@ -562,6 +571,10 @@ ly_ctx_compiled_size_context(const struct ly_ctx *ctx, struct ly_ht *addr_ht, in
         /* modules */
         ctxs_module(mod, addr_ht, size);
     }
+
+    /* module hash tables */
+    ctxs_mod_ht(ctx->mod_name_ht, size);
+    ctxs_mod_ht(ctx->mod_ns_ht, size);
 }
 
 int
@@ -711,6 +724,39 @@ ctxp_set(const struct ly_set *orig_set, struct ly_set *set, void **mem)
     *mem = (char *)*mem + LY_CTXP_MEM_SIZE(set->count * sizeof set->objs);
 }
 
+static void
+ctxp_mod_ht(const struct ly_ht *orig_ht, struct ly_ht **ht, struct ly_ht *addr_ht, void **mem)
+{
+    uint32_t i, j;
+    struct ly_ht *pht;
+    struct ly_ht_rec *rec;
+    struct lys_module **mod_p;
+
+    *ht = *mem;
+    *mem = (char *)*mem + LY_CTXP_MEM_SIZE(sizeof **ht);
+    memcpy(*ht, orig_ht, sizeof **ht);
+
+    /* read-only, records are only iterated so no callbacks */
+    (*ht)->val_equal = NULL;
+    (*ht)->cb_data = NULL;
+    (*ht)->resize = 0;
+
+    (*ht)->hlists = *mem;
+    *mem = (char *)*mem + LY_CTXP_MEM_SIZE(orig_ht->size * sizeof *orig_ht->hlists);
+    memcpy((*ht)->hlists, orig_ht->hlists, orig_ht->size * sizeof *orig_ht->hlists);
+
+    (*ht)->recs = *mem;
+    *mem = (char *)*mem + LY_CTXP_MEM_SIZE(orig_ht->size * orig_ht->rec_size);
+    memcpy((*ht)->recs, orig_ht->recs, orig_ht->size * orig_ht->rec_size);
+
+    /* printed modules */
+    pht = *ht;
+    LYHT_ITER_ALL_RECS(pht, i, j, rec) {
+        mod_p = (struct lys_module **)&rec->val;
+        *mod_p = ly_ctx_compiled_addr_ht_get(addr_ht, *mod_p, 0);
+    }
+}
+
 static void
 ctxp_dict_strings(const struct ly_ht *orig_dict, struct ly_ht *addr_ht, void **mem)
 {
@@ -1738,6 +1784,10 @@ ly_ctx_compiled_print_context(const struct ly_ctx *orig_ctx, struct ly_ctx *ctx,
         ctxp_module(orig_ctx->modules.objs[i], ctx->modules.objs[i], addr_ht, ptr_set, mem);
     }
 
+    /* module hash tables */
+    ctxp_mod_ht(orig_ctx->mod_name_ht, &ctx->mod_name_ht, addr_ht, mem);
+    ctxp_mod_ht(orig_ctx->mod_ns_ht, &ctx->mod_ns_ht, addr_ht, mem);
+
     /* no imp cb */
     ctx->imp_clb = NULL;
     ctx->imp_clb_data = NULL;
@@ -1536,6 +1536,7 @@ lys_compile_depset_r(struct ly_ctx *ctx, struct ly_set *dep_set, struct lys_glob
         assert(mod->implemented);
 
         /* free the compiled module, if any */
+        lysc_child_index_remove_module(mod);
         lysc_module_free(ctx, mod->compiled);
         mod->compiled = NULL;
 
@@ -1566,6 +1567,10 @@ resolve_unres:
             goto resolve_unres;
         }
 
+        if (mod->to_compile) {
+            /* index the schema children of the (re)compiled module */
+            LY_CHECK_GOTO(ret = lysc_child_index_add_module(mod), cleanup);
+        }
         mod->to_compile = 0;
     }
 
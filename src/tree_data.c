@@ -619,6 +619,8 @@ lyd_insert_after_node(struct lyd_node **first_sibling_p, struct lyd_node *siblin
     node->prev = sibling;
     sibling->next = node;
     node->parent = sibling->parent;
+    lyd_digest_invalidate(node->parent);
+    lyd_desc_index_invalidate(node->parent);
 
     if (!(node->flags & LYD_DEFAULT)) {
         /* remove default flags from NP containers */
@@ -643,6 +645,8 @@ lyd_insert_before_node(struct lyd_node *sibling, struct lyd_node *node)
         ((struct lyd_node_inner *)sibling->parent)->child = node;
     }
     node->parent = sibling->parent;
+    lyd_digest_invalidate(node->parent);
+    lyd_desc_index_invalidate(node->parent);
 
     if (!(node->flags & LYD_DEFAULT)) {
         /* remove default flags from NP containers */
@@ -666,6 +670,8 @@ lyd_insert_only_child(struct lyd_node *parent, struct lyd_node *node)
 
     ((struct lyd_node_inner *)parent)->child = node;
     node->parent = parent;
+    lyd_digest_invalidate(parent);
+    lyd_desc_index_invalidate(parent);
 
     if (!(node->flags & LYD_DEFAULT)) {
         /* remove default flags from NP containers */
@@ -819,7 +825,16 @@ lyd_insert_node(struct lyd_node *parent, struct lyd_node **first_sibling_p, stru
         lyd_insert_node_ordby_schema(parent, &first_sibling, node);
     } else if (lyds_is_supported(node) &&
             (lyd_find_sibling_schema(first_sibling, node->schema, &leader) == LY_SUCCESS)) {
-        ret = lyds_insert(&first_sibling, &leader, node);
+        if ((order == LYD_INSERT_NODE_DEFER_SORT) && !lyds_has_tree(leader)) {
+            /* just append the instance, all of them are sorted at once later */
+            if (first_sibling->prev->schema == node->schema) {
+                lyd_insert_after_node(&first_sibling, first_sibling->prev, node);
+            } else {
+                lyd_insert_node_ordby_schema(parent, &first_sibling, node);
+            }
+        } else {
+            ret = lyds_insert(&first_sibling, &leader, node);
+        }
         if (ret) {
             /* The operation on the sorting tree unexpectedly failed due to some internal issue,
              * but insert the node anyway although the nodes will not be sorted.
@@ -1043,16 +1058,7 @@ lyd_move_nodes(struct lyd_node *parent, struct lyd_node **first_dst_p, struct ly
     return ret;
 }
 
-/**
- * @brief Check schema place of a node to be inserted.
- *
- * @param[in] parent Schema node of the parent data node.
- * @param[in] sibling Schema node of a sibling data node.
- * @param[in] schema Schema node if the data node to be inserted.
- * @return LY_SUCCESS on success.
- * @return LY_EINVAL if the place is invalid.
- */
-static LY_ERR
+LY_ERR
 lyd_insert_check_schema(const struct lysc_node *parent, const struct lysc_node *sibling, const struct lysc_node *schema)
 {
     const struct lysc_node *par2;
@@ -1223,6 +1229,8 @@ lyd_unlink_ignore_lyds(struct lyd_node **first_sibling_p, struct lyd_node *node)
 
     /* unlink from parent */
     if (node->parent) {
+        lyd_digest_invalidate(node->parent);
+        lyd_desc_index_invalidate(node->parent);
         if (((struct lyd_node_inner *)node->parent)->child == node) {
             /* the node is the first child */
             ((struct lyd_node_inner *)node->parent)->child = node->next;
@@ -1320,6 +1328,7 @@ lyd_insert_meta(struct lyd_node *parent, struct lyd_meta *meta, ly_bool clear_df
     } else {
         parent->meta = meta;
     }
+    lyd_digest_invalidate(parent);
 
     /* remove default flags from NP containers */
     if (clear_dflt) {
@@ -1336,6 +1345,7 @@ lyd_unlink_meta_single(struct lyd_meta *meta)
         return;
     }
 
+    lyd_digest_invalidate(meta->parent);
     if (meta->parent && (meta->parent->meta == meta)) {
         meta->parent->meta = meta->next;
     } else if (meta->parent) {
@@ -1403,8 +1413,8 @@ lyd_create_meta(struct lyd_node *parent, struct lyd_meta **meta, const struct ly
     mt->parent = parent;
     mt->annotation = ant;
     lyplg_ext_get_storage(ant, LY_STMT_TYPE, sizeof ant_type, (const void **)&ant_type);
-    ret = lyd_value_store(mod->ctx, lnode, &mt->value, ant_type, value, value_size_bits, is_utf8, store_only, dynamic,
-            format, prefix_data, hints, ctx_node, incomplete);
+    ret = lyd_value_store(mod->ctx, lnode, &mt->value, ant_type, value, value_size_bits, is_utf8, store_only, 0,
+            dynamic, format, prefix_data, hints, ctx_node, incomplete);
     LY_CHECK_ERR_GOTO(ret, free(mt), cleanup);
     ret = lydict_insert(mod->ctx, name, name_len, &mt->name);
     LY_CHECK_ERR_GOTO(ret, free(mt), cleanup);
@@ -1692,6 +1702,26 @@ lyd_compare_single_schema(const struct lyd_node *node1, const struct lyd_node *n
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Compare cached subtree digests of 2 inner data nodes.
+ *
+ * @param[in] node1 The first node to compare.
+ * @param[in] node2 The second node to compare.
+ * @return LY_SUCCESS if the digests are equal.
+ * @return LY_ENOT if the digests differ or could not be learned.
+ */
+static LY_ERR
+lyd_compare_single_digest(const struct lyd_node *node1, const struct lyd_node *node2)
+{
+    uint64_t digest1, digest2;
+
+    if (lyd_digest(node1, &digest1) || lyd_digest(node2, &digest2)) {
+        return LY_ENOT;
+    }
+
+    return (digest1 == digest2) ? LY_SUCCESS : LY_ENOT;
+}
+
 /**
  * @brief Compare 2 data nodes if they are equivalent regarding the data they contain.
  *
@@ -1752,6 +1782,9 @@ lyd_compare_single_data(const struct lyd_node *node1, const struct lyd_node *nod
         case LYS_NOTIF:
             /* implicit container is always equal to a container with non-default descendants */
             if (options & LYD_COMPARE_FULL_RECURSION) {
+                if ((options & LYD_COMPARE_DIGEST) && !lyd_compare_single_digest(node1, node2)) {
+                    return LY_SUCCESS;
+                }
                 return lyd_compare_siblings_(lyd_child(node1), lyd_child(node2), options, 1);
             }
             return LY_SUCCESS;
@@ -1760,6 +1793,9 @@ lyd_compare_single_data(const struct lyd_node *node1, const struct lyd_node *nod
             iter2 = lyd_child(node2);
 
             if (options & LYD_COMPARE_FULL_RECURSION) {
+                if ((options & LYD_COMPARE_DIGEST) && !lyd_compare_single_digest(node1, node2)) {
+                    return LY_SUCCESS;
+                }
                 return lyd_compare_siblings_(iter1, iter2, options, 1);
             } else if (node1->schema->flags & LYS_KEYLESS) {
                 /* always equal */
@@ -2289,7 +2325,7 @@ lyd_dup_r(const struct lyd_node *node, const struct ly_ctx *trg_ctx, struct lyd_
             /* store canonical value in the target context */
             val_can = lyd_get_value(node);
             type = ((struct lysc_node_leaf *)term->schema)->type;
-            rc = lyd_value_store(trg_ctx, dup, &term->value, type, val_can, strlen(val_can) * 8, 1, 1, NULL,
+            rc = lyd_value_store(trg_ctx, dup, &term->value, type, val_can, strlen(val_can) * 8, 1, 1, 0, NULL,
                     LY_VALUE_CANON, NULL, LYD_HINT_DATA, term->schema, NULL);
             LY_CHECK_GOTO(rc, cleanup);
         }
@@ -2584,7 +2620,7 @@ lyd_dup_meta_single_to_ctx(const struct ly_ctx *parent_ctx, const struct lyd_met
 
         /* duplicate callback expect only the same contexts, so use the store callback */
         val_can = lyd_value_get_canonical(meta->annotation->module->ctx, &meta->value);
-        ret = lyd_value_store(parent_ctx, parent, &mt->value, ant_type, val_can, strlen(val_can) * 8, 1, 1, NULL,
+        ret = lyd_value_store(parent_ctx, parent, &mt->value, ant_type, val_can, strlen(val_can) * 8, 1, 1, 0, NULL,
                 LY_VALUE_CANON, NULL, LYD_HINT_DATA, parent->schema, NULL);
     } else {
         /* annotation */
@@ -2622,6 +2658,480 @@ lyd_dup_meta_single(const struct lyd_meta *meta, struct lyd_node *node, struct l
     return lyd_dup_meta_single_to_ctx(meta->annotation->module->ctx, meta, node, dup);
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_snapshot_new(struct lyd_node *tree, struct lyd_snapshot **snap)
+{
+    LY_CHECK_ARG_RET(NULL, !tree || !tree->parent, snap, LY_EINVAL);
+
+    *snap = malloc(sizeof **snap);
+    LY_CHECK_ERR_RET(!*snap, LOGMEM(tree ? LYD_CTX(tree) : NULL), LY_EMEM);
+
+    (*snap)->tree = lyd_first_sibling(tree);
+    ATOMIC_STORE_RELAXED((*snap)->refcount, 1);
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_snapshot_dup(struct lyd_snapshot *snap, struct lyd_snapshot **dup)
+{
+    LY_CHECK_ARG_RET(NULL, snap, dup, LY_EINVAL);
+    LY_CHECK_ERR_RET(ATOMIC_LOAD_RELAXED(snap->refcount) == ATOMIC_T_MAX, LOGINT(NULL), LY_EINT);
+
+    ATOMIC_INC_RELAXED(snap->refcount);
+    *dup = snap;
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF const struct lyd_node *
+lyd_snapshot_tree(const struct lyd_snapshot *snap)
+{
+    LY_CHECK_ARG_RET(NULL, snap, NULL);
+
+    return snap->tree;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_snapshot_unshare(struct lyd_snapshot *snap, struct lyd_node **tree)
+{
+    LY_CHECK_ARG_RET(NULL, snap, tree, LY_EINVAL);
+
+    /* acquire all the reads of the data by the released references */
+    if (ATOMIC_LOAD_ACQUIRE(snap->refcount) == 1) {
+        /* the only reference, no need to copy anything */
+        *tree = snap->tree;
+        free(snap);
+        return LY_SUCCESS;
+    }
+
+    /* shared, copy the whole data tree including the validation flags */
+    *tree = NULL;
+    if (snap->tree) {
+        LY_CHECK_RET(lyd_dup_siblings(snap->tree, NULL, LYD_DUP_RECURSIVE | LYD_DUP_WITH_FLAGS, tree));
+    }
+    lyd_snapshot_free(snap);
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF void
+lyd_snapshot_free(struct lyd_snapshot *snap)
+{
+    if (!snap) {
+        return;
+    }
+
+    /* release the reads of the data, the last reference also acquires the reads of all the others */
+    if (ATOMIC_DEC_ACQ_REL(snap->refcount) > 1) {
+        /* still referenced */
+        return;
+    }
+
+    lyd_free_all(snap->tree);
+    free(snap);
+}
+
+/**
+ * @brief Get the size of a data node structure.
+ *
+ * @param[in] node Data node.
+ * @return Size of the structure of @p node.
+ */
+static size_t
+lyd_node_size(const struct lyd_node *node)
+{
+    if (!node->schema) {
+        return sizeof(struct lyd_node_opaq);
+    } else if (node->schema->nodetype & LYD_NODE_INNER) {
+        return sizeof(struct lyd_node_inner);
+    } else if (node->schema->nodetype & LYD_NODE_TERM) {
+        return sizeof(struct lyd_node_term);
+    }
+    return sizeof(struct lyd_node_any);
+}
+
+/**
+ * @brief Get the size of all the data node structures of siblings and their descendants.
+ *
+ * @param[in] first First sibling.
+ * @return Size of the data node structures.
+ */
+static size_t
+lyd_freeze_size(const struct lyd_node *first)
+{
+    const struct lyd_node *node;
+    size_t size = 0;
+
+    LY_LIST_FOR(first, node) {
+        size += lyd_node_size(node);
+        if (!node->schema || (node->schema->nodetype & LYD_NODE_INNER)) {
+            size += lyd_freeze_size(lyd_child(node));
+        }
+    }
+
+    return size;
+}
+
+/**
+ * @brief Create a frozen copy of a data subtree.
+ *
+ * @param[in] node Data node to copy.
+ * @param[in] parent Parent of the copy, if any.
+ * @param[in,out] first First sibling of the copy.
+ * @param[in,out] mem Memory for the node structures, is moved past the used memory.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_freeze_r(const struct lyd_node *node, struct lyd_node *parent, struct lyd_node **first, char **mem)
+{
+    LY_ERR rc = LY_SUCCESS;
+    const struct ly_ctx *ctx = LYD_CTX(node);
+    struct lyd_node *dup, *child;
+    struct lyd_meta *meta;
+    struct lyd_attr *attr;
+
+    /* the node structures are placed in the order of the data */
+    dup = (struct lyd_node *)*mem;
+    *mem += lyd_node_size(node);
+
+    dup->hash = node->hash;
+    dup->flags = node->flags;
+    dup->schema = node->schema;
+    dup->prev = dup;
+
+    /* the value first so that the node can always be freed, a term node without a value cannot */
+    if (!dup->schema) {
+        struct lyd_node_opaq *opaq = (struct lyd_node_opaq *)dup;
+        struct lyd_node_opaq *orig = (struct lyd_node_opaq *)node;
+
+        opaq->ctx = orig->ctx;
+        opaq->hints = orig->hints;
+        opaq->format = orig->format;
+        LY_CHECK_GOTO(rc = lydict_dup(ctx, orig->name.name, &opaq->name.name), cleanup);
+        LY_CHECK_GOTO(rc = lydict_dup(ctx, orig->name.prefix, &opaq->name.prefix), cleanup);
+        LY_CHECK_GOTO(rc = lydict_dup(ctx, orig->name.module_ns, &opaq->name.module_ns), cleanup);
+        LY_CHECK_GOTO(rc = lydict_dup(ctx, orig->value, &opaq->value), cleanup);
+        if (orig->val_prefix_data) {
+            LY_CHECK_GOTO(rc = ly_dup_prefix_data(ctx, opaq->format, orig->val_prefix_data, &opaq->val_prefix_data), cleanup);
+        }
+    } else if (dup->schema->nodetype & LYD_NODE_TERM) {
+        struct lyd_node_term *orig = (struct lyd_node_term *)node;
+
+        rc = LYSC_GET_TYPE_PLG(orig->value.realtype->plugin_ref)->duplicate(ctx, &orig->value,
+                &((struct lyd_node_term *)dup)->value);
+        /* nothing to free */
+        LY_CHECK_ERR_RET(rc, LOGERR(ctx, rc, "Value duplication failed."), rc);
+    } else if (dup->schema->nodetype & LYD_NODE_ANY) {
+        struct lyd_node_any *orig = (struct lyd_node_any *)node;
+
+        LY_CHECK_GOTO(rc = lyd_any_copy_value(dup, orig->child, orig->value, orig->hints), cleanup);
+        ((struct lyd_node_any *)dup)->hints = orig->hints;
+    }
+
+    /* metadata, except the sorting data that are only needed for inserting */
+    if (!node->schema) {
+        LY_LIST_FOR(((struct lyd_node_opaq *)node)->attr, attr) {
+            LY_CHECK_GOTO(rc = lyd_dup_attr_single(attr, dup, NULL), cleanup);
+        }
+    } else {
+        LY_LIST_FOR(node->meta, meta) {
+            if (lyd_meta_is_internal(meta)) {
+                continue;
+            }
+            LY_CHECK_GOTO(rc = lyd_dup_meta_single_to_ctx(ctx, meta, dup, NULL), cleanup);
+        }
+    }
+
+    /* children */
+    if (!dup->schema) {
+        LY_LIST_FOR(((struct lyd_node_opaq *)node)->child, child) {
+            LY_CHECK_GOTO(rc = lyd_freeze_r(child, dup, NULL, mem), cleanup);
+        }
+    } else if (dup->schema->nodetype & LYD_NODE_INNER) {
+        struct lyd_node_inner *orig = (struct lyd_node_inner *)node;
+
+        if (orig->children_ht) {
+            /* the table is not going to grow */
+            ((struct lyd_node_inner *)dup)->children_ht = lyht_new(lyht_get_fixed_size(orig->children_ht->used),
+                    sizeof(struct lyd_node *), lyd_hash_table_val_equal, NULL, 1);
+            LY_CHECK_ERR_GOTO(!((struct lyd_node_inner *)dup)->children_ht, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+        }
+        LY_LIST_FOR(orig->child, child) {
+            LY_CHECK_GOTO(rc = lyd_freeze_r(child, dup, NULL, mem), cleanup);
+        }
+    }
+
+    /* the siblings are already ordered */
+    lyd_insert_node(parent, first, dup, LYD_INSERT_NODE_LAST);
+
+cleanup:
+    if (rc) {
+        lyd_free_frozen_siblings(dup);
+    }
+    return rc;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_freeze(const struct lyd_node *tree, struct lyd_frozen **frozen)
+{
+    LY_ERR rc = LY_SUCCESS;
+    const struct lyd_node *node;
+    struct lyd_node *first = NULL;
+    char *mem;
+    size_t size;
+
+    LY_CHECK_ARG_RET(NULL, !tree || !tree->parent, frozen, LY_EINVAL);
+
+    *frozen = calloc(1, sizeof **frozen);
+    LY_CHECK_ERR_RET(!*frozen, LOGMEM(tree ? LYD_CTX(tree) : NULL), LY_EMEM);
+    if (!tree) {
+        return LY_SUCCESS;
+    }
+
+    /* allocate all the node structures at once */
+    tree = lyd_first_sibling(tree);
+    size = lyd_freeze_size(tree);
+    (*frozen)->nodes = mem = calloc(1, size);
+    LY_CHECK_ERR_GOTO(!mem, LOGMEM(LYD_CTX(tree)); rc = LY_EMEM, cleanup);
+
+    LY_LIST_FOR(tree, node) {
+        LY_CHECK_GOTO(rc = lyd_freeze_r(node, NULL, &first, &mem), cleanup);
+    }
+    assert(mem == (char *)(*frozen)->nodes + size);
+    (*frozen)->tree = first;
+
+cleanup:
+    if (rc) {
+        lyd_free_frozen_siblings(first);
+        free((*frozen)->nodes);
+        free(*frozen);
+        *frozen = NULL;
+    }
+    return rc;
+}
+
+LIBYANG_API_DEF const struct lyd_node *
+lyd_frozen_tree(const struct lyd_frozen *frozen)
+{
+    LY_CHECK_ARG_RET(NULL, frozen, NULL);
+
+    return frozen->tree;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_thaw(const struct lyd_frozen *frozen, struct lyd_node **tree)
+{
+    LY_CHECK_ARG_RET(NULL, frozen, tree, LY_EINVAL);
+
+    *tree = NULL;
+    if (!frozen->tree) {
+        return LY_SUCCESS;
+    }
+
+    return lyd_dup_siblings(frozen->tree, NULL, LYD_DUP_RECURSIVE | LYD_DUP_WITH_FLAGS, tree);
+}
+
+/**
+ * @brief Get the memory used by the dynamically allocated parts of a value of a built-in type.
+ *
+ * @param[in] value Value to examine.
+ * @return Memory used by @p value in bytes.
+ */
+static uint64_t
+lyd_value_mem_usage(const struct lyd_value *value)
+{
+    struct lyd_value_binary *bin;
+    struct lyd_value_bits *bits;
+    struct lyd_value_union *un;
+    const struct lysc_type_bits *type_bits;
+    uint64_t size = 0;
+
+    switch (value->realtype->basetype) {
+    case LY_TYPE_BINARY:
+        LYD_VALUE_GET(value, bin);
+        size = (LYPLG_TYPE_VAL_IS_DYN(bin) ? sizeof *bin : 0) + bin->size;
+        break;
+    case LY_TYPE_BITS:
+        LYD_VALUE_GET(value, bits);
+        type_bits = (const struct lysc_type_bits *)value->realtype;
+        size = (LYPLG_TYPE_VAL_IS_DYN(bits) ? sizeof *bits : 0) +
+                LYPLG_BITS2BYTES(type_bits->bits[LY_ARRAY_COUNT(type_bits->bits) - 1].position + 1);
+        if (bits->items) {
+            size += sizeof(LY_ARRAY_COUNT_TYPE) + LY_ARRAY_COUNT(type_bits->bits) * sizeof *bits->items;
+        }
+        break;
+    case LY_TYPE_UNION:
+        LYD_VALUE_GET(value, un);
+        size = sizeof *un + LYPLG_BITS2BYTES(un->orig_size_bits) + lyd_value_mem_usage(&un->value);
+        break;
+    case LY_TYPE_INST:
+        if (value->target) {
+            size = sizeof(LY_ARRAY_COUNT_TYPE) + LY_ARRAY_COUNT(value->target) * sizeof *value->target;
+        }
+        break;
+    default:
+        /* the value is stored inline or its memory is plugin-specific */
+        break;
+    }
+
+    return size;
+}
+
+/**
+ * @brief Callback for comparing schema node memory usage items.
+ * Implementation of ::lyht_value_equal_cb.
+ */
+static ly_bool
+lyd_mem_usage_schema_equal(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    return ((struct lyd_mem_usage_schema *)val1_p)->schema == ((struct lyd_mem_usage_schema *)val2_p)->schema;
+}
+
+/**
+ * @brief Callback for sorting schema node memory usage items from the largest.
+ */
+static int
+lyd_mem_usage_schema_cmp(const void *ptr1, const void *ptr2)
+{
+    const struct lyd_mem_usage_schema *item1 = ptr1, *item2 = ptr2;
+
+    if (item1->size == item2->size) {
+        return 0;
+    }
+    return (item1->size > item2->size) ? -1 : 1;
+}
+
+/**
+ * @brief Learn the memory used by a data subtree.
+ *
+ * @param[in] node Data subtree.
+ * @param[in,out] usage Memory usage to add to.
+ * @param[in] schema_ht Optional hash table of memory usage items of schema nodes to add to.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_mem_usage_r(const struct lyd_node *node, struct lyd_mem_usage *usage, struct ly_ht *schema_ht)
+{
+    const struct lyd_node *child;
+    const struct lyd_meta *meta;
+    const struct lyd_attr *attr;
+    const struct lyd_leafref_links_rec *rec;
+    struct lyd_value_lyds_tree *lt;
+    struct lyd_mem_usage_schema item = {0}, *item_p;
+    uint64_t size, s;
+    uint32_t hash;
+
+    size = lyd_node_size(node);
+    usage->nodes += size;
+    ++usage->node_count;
+
+    if (!node->schema) {
+        LY_LIST_FOR(((struct lyd_node_opaq *)node)->attr, attr) {
+            usage->meta += sizeof *attr;
+            size += sizeof *attr;
+        }
+    } else {
+        LY_LIST_FOR(node->meta, meta) {
+            s = sizeof *meta;
+            if (lyd_meta_is_internal(meta)) {
+                LYD_VALUE_GET(&meta->value, lt);
+                if (lt) {
+                    s += (LYPLG_TYPE_VAL_IS_DYN(lt) ? sizeof *lt : 0) + lyds_tree_mem_usage(lt->rbt);
+                }
+                usage->lyds += s;
+            } else {
+                s += lyd_value_mem_usage(&meta->value);
+                usage->meta += s;
+            }
+            size += s;
+        }
+    }
+
+    if (!node->schema || (node->schema->nodetype & LYD_NODE_INNER)) {
+        if (node->schema) {
+            s = lyht_mem_usage(((struct lyd_node_inner *)node)->children_ht);
+            usage->hash_tables += s;
+            size += s;
+        }
+        LY_LIST_FOR(lyd_child(node), child) {
+            LY_CHECK_RET(lyd_mem_usage_r(child, usage, schema_ht));
+        }
+    } else if (node->schema->nodetype & LYD_NODE_TERM) {
+        s = lyd_value_mem_usage(&((struct lyd_node_term *)node)->value);
+        usage->values += s;
+        size += s;
+
+        if (!lyd_leafref_get_links((struct lyd_node_term *)node, &rec)) {
+            s = lyd_leafref_links_rec_mem_usage(rec);
+            usage->leafref_links += s;
+            size += s;
+        }
+    } else {
+        /* anydata data tree */
+        LY_LIST_FOR(((struct lyd_node_any *)node)->child, child) {
+            LY_CHECK_RET(lyd_mem_usage_r(child, usage, schema_ht));
+        }
+    }
+
+    if (!schema_ht) {
+        return LY_SUCCESS;
+    }
+
+    /* add to the schema node usage */
+    item.schema = node->schema;
+    hash = lyht_hash((const char *)&item.schema, sizeof item.schema);
+    if (!lyht_find(schema_ht, &item, hash, (void **)&item_p)) {
+        item_p->size += size;
+        ++item_p->count;
+    } else {
+        item.size = size;
+        item.count = 1;
+        LY_CHECK_RET(lyht_insert(schema_ht, &item, hash, NULL));
+    }
+
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_mem_usage(const struct lyd_node *node, ly_bool siblings, struct lyd_mem_usage *usage,
+        struct lyd_mem_usage_schema **schemas, uint32_t *schema_count)
+{
+    LY_ERR rc = LY_SUCCESS;
+    const struct lyd_node *iter;
+    struct ly_ht *schema_ht = NULL;
+    struct ly_ht_rec *rec;
+    uint32_t hlist_idx, rec_idx;
+
+    LY_CHECK_ARG_RET(NULL, usage, !schemas || schema_count, LY_EINVAL);
+
+    memset(usage, 0, sizeof *usage);
+    if (schemas) {
+        *schemas = NULL;
+        *schema_count = 0;
+        schema_ht = lyht_new(1, sizeof(struct lyd_mem_usage_schema), lyd_mem_usage_schema_equal, NULL, 1);
+        LY_CHECK_ERR_RET(!schema_ht, LOGMEM(node ? LYD_CTX(node) : NULL), LY_EMEM);
+    }
+
+    LY_LIST_FOR(node, iter) {
+        LY_CHECK_GOTO(rc = lyd_mem_usage_r(iter, usage, schema_ht), cleanup);
+        if (!siblings) {
+            break;
+        }
+    }
+
+    if (schemas && schema_ht->used) {
+        /* collect and sort the items */
+        *schemas = malloc(schema_ht->used * sizeof **schemas);
+        LY_CHECK_ERR_GOTO(!*schemas, LOGMEM(LYD_CTX(node)); rc = LY_EMEM, cleanup);
+        LYHT_ITER_ALL_RECS(schema_ht, hlist_idx, rec_idx, rec) {
+            (*schemas)[(*schema_count)++] = *(struct lyd_mem_usage_schema *)rec->val;
+        }
+        qsort(*schemas, *schema_count, sizeof **schemas, lyd_mem_usage_schema_cmp);
+    }
+
+cleanup:
+    lyht_free(schema_ht, NULL);
+    return rc;
+}
+
 /**
  * @brief Merge a source sibling into target siblings.
  *
@@ -2692,6 +3202,7 @@ lyd_merge_sibling_r(struct lyd_node **first_trg, struct lyd_node *parent_trg,
                 opaq_trg->format = opaq_src->format;
                 ly_dup_prefix_data(LYD_CTX(opaq_trg), opaq_src->format, opaq_src->val_prefix_data,
                         &opaq_trg->val_prefix_data);
+                lyd_digest_invalidate(match_trg);
             }
         } else if ((match_trg->schema->nodetype == LYS_LEAF) &&
                 ((options & LYD_MERGE_DEFAULTS) || !(sibling_src->flags & LYD_DEFAULT))) {
@@ -3289,7 +3800,7 @@ lyd_find_sibling_val(const struct lyd_node *siblings, const struct lysc_node *sc
         /* create a data node and find the instance */
         if (schema->nodetype == LYS_LEAFLIST) {
             /* target used attributes: schema, hash, value */
-            rc = lyd_create_term(schema, NULL, key_or_value, val_len * 8, 0, 1, NULL, LY_VALUE_JSON, NULL, LYD_HINT_DATA,
+            rc = lyd_create_term(schema, NULL, key_or_value, val_len * 8, 0, 1, 0, NULL, LY_VALUE_JSON, NULL, LYD_HINT_DATA,
                     NULL, &target);
             LY_CHECK_RET(rc);
         } else {
@@ -3308,6 +3819,207 @@ lyd_find_sibling_val(const struct lyd_node *siblings, const struct lysc_node *sc
     return rc;
 }
 
+/**
+ * @brief Searched list or leaf-list instance values.
+ */
+struct lyd_find_inst {
+    const struct lysc_node *schema;     /**< schema node of the instance */
+    const struct lyd_value **values;    /**< ordered key values or the leaf-list value */
+};
+
+/**
+ * @brief Learn whether a term node has a specific value.
+ *
+ * @param[in] term Term node to compare.
+ * @param[in] value Stored value to compare with.
+ * @return Whether the values are equal.
+ */
+static ly_bool
+lyd_find_inst_value_equal(const struct lyd_node_term *term, const struct lyd_value *value)
+{
+    if (term->value.realtype == value->realtype) {
+        return LYSC_GET_TYPE_PLG(value->realtype->plugin_ref)->compare(LYD_CTX(term), &term->value, value) ? 0 : 1;
+    }
+
+    /* values of different types, compare canonical values */
+    return strcmp(lyd_get_value(&term->node), lyd_value_get_canonical(LYD_CTX(term), value)) ? 0 : 1;
+}
+
+/**
+ * @brief Learn whether a data node is the searched instance.
+ *
+ * @param[in] node Data node to examine.
+ * @param[in] inst Searched instance.
+ * @return Whether @p node is @p inst.
+ */
+static ly_bool
+lyd_find_inst_match(const struct lyd_node *node, const struct lyd_find_inst *inst)
+{
+    const struct lyd_node *key;
+    uint32_t i = 0;
+
+    if (!node->schema || !lyd_compare_schema_equal(node->schema, inst->schema, 0)) {
+        return 0;
+    }
+
+    if (inst->schema->nodetype == LYS_LEAFLIST) {
+        return lyd_find_inst_value_equal((struct lyd_node_term *)node, inst->values[0]);
+    }
+
+    for (key = lyd_child(node); key && key->schema && (key->schema->flags & LYS_KEY); key = key->next) {
+        if (!lyd_find_inst_value_equal((struct lyd_node_term *)key, inst->values[i])) {
+            return 0;
+        }
+        ++i;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Compare callback for finding an instance by its values in a hash table.
+ *
+ * Implementation of ::lyht_value_equal_cb.
+ */
+static ly_bool
+lyd_find_inst_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    const struct lyd_find_inst *inst = *(const struct lyd_find_inst **)val1_p;
+    const struct lyd_node *node = *(const struct lyd_node **)val2_p;
+
+    return lyd_find_inst_match(node, inst);
+}
+
+/**
+ * @brief Search in siblings for a list or leaf-list instance with specific stored values using its hash.
+ *
+ * @param[in] siblings Siblings to search in.
+ * @param[in] schema Schema node of the list with keys or the leaf-list.
+ * @param[in] values Ordered stored key values of the list or the value of the leaf-list.
+ * @param[out] match Optional found instance.
+ * @return LY_SUCCESS if found.
+ * @return LY_ENOTFOUND if not found.
+ */
+static LY_ERR
+lyd_find_sibling_inst(const struct lyd_node *siblings, const struct lysc_node *schema, const struct lyd_value **values,
+        struct lyd_node **match)
+{
+    struct lyd_find_inst inst = {schema, values}, *inst_p = &inst;
+    struct lyd_node **match_p, *parent, *iter = NULL;
+
+    if (!siblings || (siblings->schema &&
+            !lyd_compare_schema_equal(lysc_data_parent(siblings->schema), lysc_data_parent(schema), 1))) {
+        /* no data or schema mismatch */
+        goto cleanup;
+    }
+
+    siblings = lyd_first_sibling(siblings);
+    parent = siblings->parent;
+    if (!lysc_is_dup_inst_list(schema) && parent && parent->schema && ((struct lyd_node_inner *)parent)->children_ht) {
+        /* find by the hash of the instance */
+        if (!lyht_find_with_val_cb(((struct lyd_node_inner *)parent)->children_ht, &inst_p, lyd_hash_inst(schema, values),
+                lyd_find_inst_equal_cb, (void **)&match_p)) {
+            iter = *match_p;
+        }
+    } else {
+        /* no children hash table or the first instance is searched */
+        for (iter = (struct lyd_node *)siblings; iter && !lyd_find_inst_match(iter, &inst); iter = iter->next) {}
+    }
+
+cleanup:
+    if (match) {
+        *match = iter;
+    }
+    return iter ? LY_SUCCESS : LY_ENOTFOUND;
+}
+
+/**
+ * @brief Get the number of values identifying a list or leaf-list instance.
+ *
+ * @param[in] schema Schema node of the list with keys or the leaf-list.
+ * @return Number of the list keys, 1 for a leaf-list.
+ */
+static uint32_t
+lyd_find_inst_value_count(const struct lysc_node *schema)
+{
+    const struct lysc_node *key;
+    uint32_t count = 0;
+
+    if (schema->nodetype == LYS_LEAFLIST) {
+        return 1;
+    }
+
+    for (key = lysc_node_child(schema); key && (key->flags & LYS_KEY); key = key->next) {
+        ++count;
+    }
+    return count;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_find_sibling_stored(const struct lyd_node *siblings, const struct lysc_node *schema,
+        const struct lyd_value **key_values, struct lyd_node **match)
+{
+    LY_CHECK_ARG_RET(NULL, schema, key_values, LY_EINVAL);
+    LY_CHECK_ARG_RET(schema->module->ctx, ((schema->nodetype == LYS_LIST) && !(schema->flags & LYS_KEYLESS)) ||
+            (schema->nodetype == LYS_LEAFLIST), LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, siblings ? LYD_CTX(siblings) : NULL, schema->module->ctx, LY_EINVAL);
+
+    return lyd_find_sibling_inst(siblings, schema, key_values, match);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_find_sibling_bin(const struct lyd_node *siblings, const struct lysc_node *schema, const void **key_values,
+        const uint32_t *value_sizes_bits, struct lyd_node **match)
+{
+    LY_ERR rc = LY_SUCCESS;
+    const struct ly_ctx *ctx;
+    const struct lysc_node *key;
+    struct lyd_value *vals = NULL;
+    const struct lyd_value **val_p = NULL;
+    uint32_t i, count, stored = 0;
+
+    LY_CHECK_ARG_RET(NULL, schema, key_values, value_sizes_bits, LY_EINVAL);
+    ctx = schema->module->ctx;
+    LY_CHECK_ARG_RET(ctx, ((schema->nodetype == LYS_LIST) && !(schema->flags & LYS_KEYLESS)) ||
+            (schema->nodetype == LYS_LEAFLIST), LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, siblings ? LYD_CTX(siblings) : NULL, ctx, LY_EINVAL);
+
+    if (!siblings) {
+        /* no data */
+        if (match) {
+            *match = NULL;
+        }
+        return LY_ENOTFOUND;
+    }
+
+    count = lyd_find_inst_value_count(schema);
+    vals = calloc(count, sizeof *vals);
+    val_p = malloc(count * sizeof *val_p);
+    LY_CHECK_ERR_GOTO(!vals || !val_p, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+
+    /* store the binary values, no other instance needs to be created */
+    key = (schema->nodetype == LYS_LEAFLIST) ? schema : lysc_node_child(schema);
+    for (i = 0; i < count; ++i) {
+        rc = lyd_value_store(ctx, NULL, &vals[i], ((struct lysc_node_leaf *)key)->type, key_values[i],
+                value_sizes_bits[i], 0, 1, 0, NULL, LY_VALUE_LYB, NULL, LYD_HINT_DATA, key, NULL);
+        LY_CHECK_GOTO(rc, cleanup);
+        val_p[i] = &vals[i];
+        ++stored;
+        key = key->next;
+    }
+
+    /* find the instance */
+    rc = lyd_find_sibling_inst(siblings, schema, val_p, match);
+
+cleanup:
+    for (i = 0; i < stored; ++i) {
+        LYSC_GET_TYPE_PLG(vals[i].realtype->plugin_ref)->free(ctx, &vals[i]);
+    }
+    free(vals);
+    free(val_p);
+    return rc;
+}
+
 LIBYANG_API_DEF LY_ERR
 lyd_find_sibling_dup_inst_set(const struct lyd_node *siblings, const struct lyd_node *target, struct ly_set **set)
 {
@@ -3447,6 +4159,57 @@ lyd_find_xpath3(const struct lyd_node *ctx_node, const struct lyd_node *tree, co
     return lyd_eval_xpath4(ctx_node, tree, NULL, xpath, format, prefix_data, vars, NULL, set, NULL, NULL, NULL);
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_xpath_iter_new(const struct lyd_node *ctx_node, const struct lyd_node *tree, const char *xpath,
+        LY_VALUE_FORMAT format, void *prefix_data, const struct lyxp_var *vars, struct lyd_xpath_iter **iter)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct lyd_xpath_iter *it;
+
+    LY_CHECK_ARG_RET(NULL, tree, xpath, iter, LY_EINVAL);
+
+    *iter = NULL;
+
+    it = calloc(1, sizeof *it);
+    LY_CHECK_ERR_RET(!it, LOGMEM(LYD_CTX(tree)), LY_EMEM);
+
+    /* parse expression */
+    ret = lyxp_expr_parse((struct ly_ctx *)LYD_CTX(tree), ctx_node, xpath, 0, 1, &it->exp);
+    LY_CHECK_GOTO(ret, cleanup);
+
+    /* prepare the evaluation */
+    ret = lyxp_iter_init(it, LYD_CTX(tree), NULL, format, prefix_data, ctx_node, tree, vars);
+    LY_CHECK_GOTO(ret, cleanup);
+
+cleanup:
+    if (ret) {
+        lyd_xpath_iter_free(it);
+    } else {
+        *iter = it;
+    }
+    return ret;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_xpath_iter_next(struct lyd_xpath_iter *iter, struct lyd_node **node)
+{
+    LY_CHECK_ARG_RET(NULL, iter, node, LY_EINVAL);
+
+    return lyxp_iter_next(iter, (const struct lyd_node **)node);
+}
+
+LIBYANG_API_DEF void
+lyd_xpath_iter_free(struct lyd_xpath_iter *iter)
+{
+    if (!iter) {
+        return;
+    }
+
+    lyxp_iter_clean(iter);
+    lyxp_expr_free(iter->exp);
+    free(iter);
+}
+
 LIBYANG_API_DEF LY_ERR
 lyd_eval_xpath(const struct lyd_node *ctx_node, const char *xpath, ly_bool *result)
 {
@@ -3485,7 +4248,7 @@ lyd_eval_xpath4(const struct lyd_node *ctx_node, const struct lyd_node *tree, co
     LY_CHECK_GOTO(ret, cleanup);
 
     /* evaluate expression */
-    ret = lyxp_eval(LYD_CTX(tree), exp, cur_mod, format, prefix_data, ctx_node, ctx_node, tree, vars, &xp_set,
+    ret = lyxp_eval(LYD_CTX(tree), exp, cur_mod, format, prefix_data, ctx_node, ctx_node, tree, vars, NULL, &xp_set,
             LYXP_IGNORE_WHEN);
     LY_CHECK_GOTO(ret, cleanup);
 
@@ -3606,7 +4369,7 @@ lyd_trim_xpath(struct lyd_node **tree, const char *xpath, const struct lyxp_var
     LY_CHECK_GOTO(ret, cleanup);
 
     /* evaluate expression */
-    ret = lyxp_eval(ctx, exp, NULL, LY_VALUE_JSON, NULL, *tree, *tree, *tree, vars, &xp_set, LYXP_IGNORE_WHEN);
+    ret = lyxp_eval(ctx, exp, NULL, LY_VALUE_JSON, NULL, *tree, *tree, *tree, vars, NULL, &xp_set, LYXP_IGNORE_WHEN);
     LY_CHECK_GOTO(ret, cleanup);
 
     /* create hash table for all the parents of results */
@@ -3696,26 +4459,51 @@ cleanup:
     return ret;
 }
 
-LIBYANG_API_DEF LY_ERR
-lyd_find_path(const struct lyd_node *ctx_node, const char *path, ly_bool output, struct lyd_node **match)
+/**
+ * @brief Compile a data path.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] ctx_node Path context schema node, NULL for the root.
+ * @param[in] path Path to compile.
+ * @param[in] output Whether to search in RPC/action output nodes or in input nodes.
+ * @param[out] lypath Compiled path.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_path_compile(const struct ly_ctx *ctx, const struct lysc_node *ctx_node, const char *path, ly_bool output,
+        struct ly_path **lypath)
 {
     LY_ERR ret = LY_SUCCESS;
     struct lyxp_expr *expr = NULL;
-    struct ly_path *lypath = NULL;
-    const struct lyd_node *tree = NULL;
-
-    LY_CHECK_ARG_RET(NULL, ctx_node, ctx_node->schema, path, LY_EINVAL);
 
     /* parse the path */
-    ret = ly_path_parse(LYD_CTX(ctx_node), ctx_node->schema, path, 0, 0, LY_PATH_BEGIN_EITHER, LY_PATH_PREFIX_FIRST,
-            LY_PATH_PRED_SIMPLE, &expr);
+    ret = ly_path_parse(ctx, ctx_node, path, 0, 0, ctx_node ? LY_PATH_BEGIN_EITHER : LY_PATH_BEGIN_ABSOLUTE,
+            LY_PATH_PREFIX_FIRST, LY_PATH_PRED_SIMPLE, &expr);
     LY_CHECK_GOTO(ret, cleanup);
 
     /* compile the path */
-    ret = ly_path_compile(LYD_CTX(ctx_node), ctx_node->schema, expr,
-            output ? LY_PATH_OPER_OUTPUT : LY_PATH_OPER_INPUT, LY_PATH_TARGET_SINGLE, 0, LY_VALUE_JSON, NULL, &lypath);
+    ret = ly_path_compile(ctx, ctx_node, expr, output ? LY_PATH_OPER_OUTPUT : LY_PATH_OPER_INPUT,
+            LY_PATH_TARGET_SINGLE, 0, LY_VALUE_JSON, NULL, lypath);
     LY_CHECK_GOTO(ret, cleanup);
 
+cleanup:
+    lyxp_expr_free(expr);
+    return ret;
+}
+
+/**
+ * @brief Search for a data node of a compiled path.
+ *
+ * @param[in] ctx_node Path context node.
+ * @param[in] lypath Compiled path.
+ * @param[out] match Found data node, or its last found parent.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_path_find(const struct lyd_node *ctx_node, const struct ly_path *lypath, struct lyd_node **match)
+{
+    const struct lyd_node *tree = NULL;
+
     if (lypath[0].doc_root) {
         /* use the root context node for absolute paths, avoids specific XPath evaluation rules of extensions */
         for (tree = ctx_node; tree->parent; tree = tree->parent) {}
@@ -3723,14 +4511,100 @@ lyd_find_path(const struct lyd_node *ctx_node, const char *path, ly_bool output,
     }
 
     /* evaluate the path */
-    ret = ly_path_eval_partial(lypath, ctx_node, tree, NULL, 0, NULL, match);
+    return ly_path_eval_partial(lypath, ctx_node, tree, NULL, 0, NULL, match);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_find_path(const struct lyd_node *ctx_node, const char *path, ly_bool output, struct lyd_node **match)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct ly_path *lypath = NULL;
+
+    LY_CHECK_ARG_RET(NULL, ctx_node, ctx_node->schema, path, LY_EINVAL);
+
+    /* compile the path */
+    ret = lyd_path_compile(LYD_CTX(ctx_node), ctx_node->schema, path, output, &lypath);
+    LY_CHECK_GOTO(ret, cleanup);
+
+    /* find the node */
+    ret = lyd_path_find(ctx_node, lypath, match);
 
 cleanup:
-    lyxp_expr_free(expr);
     ly_path_free(lypath);
     return ret;
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_compile_path(const struct ly_ctx *ctx, const struct lysc_node *ctx_node, const char *path, ly_bool output,
+        struct ly_path **lypath)
+{
+    LY_ERR ret = LY_SUCCESS;
+
+    LY_CHECK_ARG_RET(ctx, ctx || ctx_node, path, lypath, LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, ctx, ctx_node ? ctx_node->module->ctx : NULL, LY_EINVAL);
+
+    *lypath = NULL;
+    if (!ctx) {
+        ctx = ctx_node->module->ctx;
+    }
+
+    /* compile the path */
+    ret = lyd_path_compile(ctx, ctx_node, path, output, lypath);
+    LY_CHECK_GOTO(ret, cleanup);
+
+    /* prepare the searched instances */
+    ret = ly_path_prepare_insts(*lypath);
+    LY_CHECK_GOTO(ret, cleanup);
+
+cleanup:
+    if (ret) {
+        ly_path_free(*lypath);
+        *lypath = NULL;
+    }
+    return ret;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_find_compiled_path(const struct lyd_node *ctx_node, const struct ly_path *lypath, struct lyd_node **match)
+{
+    const char *var;
+
+    LY_CHECK_ARG_RET(NULL, ctx_node, lypath, LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, LYD_CTX(ctx_node), lypath[0].node->module->ctx, LY_EINVAL);
+
+    if ((var = ly_path_unbound_var(lypath))) {
+        LOGERR(LYD_CTX(ctx_node), LY_EINVAL, "Variable \"%s\" of the compiled path not bound.", var);
+        return LY_EINVAL;
+    }
+
+    return lyd_path_find(ctx_node, lypath, match);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_compiled_path_bind(struct ly_path *lypath, const char *name, const struct lyd_value *value)
+{
+    LY_CHECK_ARG_RET(NULL, lypath, name, value, LY_EINVAL);
+
+    return ly_path_bind_var(lypath, name, value, NULL, 0, LY_VALUE_CANON);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_compiled_path_bind_val(struct ly_path *lypath, const char *name, const void *value, uint64_t value_size_bits,
+        LY_VALUE_FORMAT format)
+{
+    LY_CHECK_ARG_RET(NULL, lypath, name, value || !value_size_bits, LY_EINVAL);
+    LY_CHECK_ARG_RET(lypath[0].node->module->ctx, (format == LY_VALUE_JSON) || (format == LY_VALUE_CANON) ||
+            (format == LY_VALUE_LYB), LY_EINVAL);
+
+    return ly_path_bind_var(lypath, name, NULL, value ? value : "", value_size_bits, format);
+}
+
+LIBYANG_API_DEF void
+lyd_free_compiled_path(struct ly_path *lypath)
+{
+    ly_path_free(lypath);
+}
+
 LIBYANG_API_DEF LY_ERR
 lyd_find_target(const struct ly_path *path, const struct lyd_node *tree, struct lyd_node **match)
 {
@@ -3800,6 +4674,21 @@ cleanup:
     return ret;
 }
 
+uint64_t
+lyd_leafref_links_rec_mem_usage(const struct lyd_leafref_links_rec *rec)
+{
+    uint64_t size = sizeof *rec;
+
+    if (rec->leafref_nodes) {
+        size += sizeof(LY_ARRAY_COUNT_TYPE) + LY_ARRAY_COUNT(rec->leafref_nodes) * sizeof *rec->leafref_nodes;
+    }
+    if (rec->target_nodes) {
+        size += sizeof(LY_ARRAY_COUNT_TYPE) + LY_ARRAY_COUNT(rec->target_nodes) * sizeof *rec->target_nodes;
+    }
+
+    return size;
+}
+
 LIBYANG_API_DEF LY_ERR
 lyd_leafref_get_links(const struct lyd_node_term *node, const struct lyd_leafref_links_rec **record)
 {
@@ -34,9 +34,12 @@ extern "C" {
 struct ly_ctx;
 struct ly_path;
 struct ly_set;
+struct lyd_batch;
+struct lyd_frozen;
 struct lyd_node;
 struct lyd_node_opaq;
 struct lyd_node_term;
+struct lyd_snapshot;
 struct timespec;
 struct lyxp_var;
 struct rb_node;
@@ -100,9 +103,19 @@ struct rb_node;
  * - ::lyd_get_value()
  * - ::lyd_get_meta_value()
  * - ::lyd_find_xpath()
+ * - ::lyd_xpath_iter_new()
+ * - ::lyd_xpath_iter_next()
+ * - ::lyd_xpath_iter_free()
  * - ::lyd_find_path()
+ * - ::lyd_compile_path()
+ * - ::lyd_compiled_path_bind()
+ * - ::lyd_compiled_path_bind_val()
+ * - ::lyd_find_compiled_path()
+ * - ::lyd_free_compiled_path()
  * - ::lyd_find_target()
  * - ::lyd_find_sibling_val()
+ * - ::lyd_find_sibling_bin()
+ * - ::lyd_find_sibling_stored()
  * - ::lyd_find_sibling_first()
  * - ::lyd_find_sibling_opaq_next()
  * - ::lyd_find_meta()
@@ -222,6 +235,13 @@ struct rb_node;
  * ::lyd_new_path2()). The latter enables to create a whole path of nodes, requires less information
  * about the modified data, and is generally simpler to use. Actually the third way is duplicating the existing data using
  * ::lyd_dup_single(), ::lyd_dup_siblings() and ::lyd_dup_meta_single().
+ * Many new siblings, such as list instances, are inserted more efficiently at once using a batch created by
+ * ::lyd_batch_new() and inserted by ::lyd_batch_insert().
+ * Data trees that need to be kept unchanged for their readers while being modified (such as datastore snapshots) can
+ * be shared by reference using ::lyd_snapshot_new() and ::lyd_snapshot_dup(). This is whole-tree copy-on-write,
+ * ::lyd_snapshot_unshare() copies the whole data tree, just like ::lyd_dup_siblings(), if it is still referenced.
+ * Large data trees that are mostly read can be converted into a more compact read-only form with ::lyd_freeze()
+ * and back with ::lyd_thaw().
  *
  * The [metadata](@ref howtoDataMetadata) (and attributes in opaq nodes) can be created with ::lyd_new_meta()
  * and ::lyd_new_attr().
@@ -258,6 +278,12 @@ struct rb_node;
  * - ::lyd_new_list()
  * - ::lyd_new_list2()
  * - ::lyd_new_list3()
+ * - ::lyd_new_list_stored()
+ * - ::lyd_batch_new()
+ * - ::lyd_batch_new_list()
+ * - ::lyd_batch_add()
+ * - ::lyd_batch_insert()
+ * - ::lyd_batch_free()
  * - ::lyd_new_any()
  * - ::lyd_new_opaq()
  * - ::lyd_new_opaq2()
@@ -266,11 +292,23 @@ struct rb_node;
  * - ::lyd_new_meta()
  * - ::lyd_new_path()
  * - ::lyd_new_path2()
+ * - ::lyd_new_compiled_path()
  *
  * - ::lyd_dup_single()
  * - ::lyd_dup_siblings()
  * - ::lyd_dup_meta_single()
  *
+ * - ::lyd_snapshot_new()
+ * - ::lyd_snapshot_dup()
+ * - ::lyd_snapshot_tree()
+ * - ::lyd_snapshot_unshare()
+ * - ::lyd_snapshot_free()
+ * - ::lyd_freeze()
+ * - ::lyd_frozen_tree()
+ * - ::lyd_thaw()
+ * - ::lyd_frozen_free()
+ * - ::lyd_mem_usage()
+ *
  * - ::lyd_insert_child()
  * - ::lyd_insert_sibling()
  * - ::lyd_insert_after()
@@ -1169,9 +1207,7 @@ lyd_get_value(const struct lyd_node *node)
     if (!node->schema) {
         return ((const struct lyd_node_opaq *)node)->value;
     } else if (node->schema->nodetype & LYD_NODE_TERM) {
-        const struct lyd_value *value = &((const struct lyd_node_term *)node)->value;
-
-        return value->_canonical ? value->_canonical : lyd_value_get_canonical(LYD_CTX(node), value);
+        return lyd_value_get_canonical(LYD_CTX(node), &((const struct lyd_node_term *)node)->value);
     }
 
     return NULL;
@@ -1273,6 +1309,9 @@ LIBYANG_API_DECL LY_ERR lyd_new_inner(struct lyd_node *parent, const struct lys_
 #define LYD_NEW_PATH_WITH_OPAQ 0x40  /**< Consider opaque nodes normally when searching for existing nodes. */
 #define LYD_NEW_PATH_ANY_DATATREE 0x80  /**< The @p value is actually a data tree, not a string. */
 #define LYD_NEW_ANY_USE_VALUE 0x0100    /**< Whether to use dynamic @p value or make a copy. */
+#define LYD_NEW_VAL_BIN 0x0200          /**< Interpret the provided leaf/leaf-list @p value as being in the binary
+                                          ::LY_VALUE_LYB format, for example a little-endian integer. Its size must be
+                                          provided so it is not supported by functions with only a string value. */
 
 /** @} newvaloptions */
 
@@ -1286,6 +1325,7 @@ LIBYANG_API_DECL LY_ERR lyd_new_inner(struct lyd_node *parent, const struct lys_
  * @param[out] node Optional created node.
  * @param[in] ... Ordered key values of the new list instance, all must be set. In case of an instance-identifier
  * or identityref value, the JSON format is expected (module names instead of prefixes). No keys are expected for key-less lists.
+ * With ::LYD_NEW_VAL_BIN, each binary value is followed by its size in bits (uint32_t).
  * @return LY_ERR value.
  */
 LIBYANG_API_DECL LY_ERR lyd_new_list(struct lyd_node *parent, const struct lys_module *module, const char *name,
@@ -1315,7 +1355,8 @@ LIBYANG_API_DECL LY_ERR lyd_new_list2(struct lyd_node *parent, const struct lys_
  * @param[in] name Schema node name of the new data node. The node must be #LYS_LIST.
  * @param[in] key_values Ordered key values of the new list instance, all must be set.
  * Use NULL in case of key-less list.
- * @param[in] value_sizes_bits Array of size of each @p key_values in bits, may be NULL if @p key_values are 0-terminated strings.
+ * @param[in] value_sizes_bits Array of size of each @p key_values in bits, may be NULL if @p key_values are 0-terminated strings
+ * and must be set for binary values (::LYD_NEW_VAL_BIN).
  * @param[in] options Bitmask of options, see @ref newvaloptions.
  * @param[out] node Optional created node.
  * @return LY_ERR value.
@@ -1323,6 +1364,105 @@ LIBYANG_API_DECL LY_ERR lyd_new_list2(struct lyd_node *parent, const struct lys_
 LIBYANG_API_DECL LY_ERR lyd_new_list3(struct lyd_node *parent, const struct lys_module *module, const char *name,
         const void **key_values, uint32_t *value_sizes_bits, uint32_t options, struct lyd_node **node);
 
+/**
+ * @brief Create a new list node in the data tree from stored key values.
+ *
+ * The key values are only duplicated if of the key types so no type plugin has to store them again.
+ *
+ * @param[in] parent Parent node for the node being created. NULL in case of creating a top level element.
+ * @param[in] module Module of the node being created. If NULL, @p parent module will be used.
+ * @param[in] name Schema node name of the new data node. The node must be #LYS_LIST.
+ * @param[in] key_values Ordered stored key values of the new list instance, all must be set. They can be taken from
+ * other instances of the keys, values of other types are stored from their canonical values.
+ * Use NULL in case of key-less list.
+ * @param[in] options Bitmask of options, see @ref newvaloptions.
+ * @param[out] node Optional created node.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_new_list_stored(struct lyd_node *parent, const struct lys_module *module, const char *name,
+        const struct lyd_value **key_values, uint32_t options, struct lyd_node **node);
+
+/**
+ * @ingroup datatree
+ * @defgroup batchoptions Data batch options
+ *
+ * Various options to change lyd_batch_insert() behavior.
+ *
+ * Default behavior:
+ * - no duplicate instances are checked for, the same as when inserting the nodes one-by-one.
+ * @{
+ */
+
+#define LYD_BATCH_DUP_CHECK 0x01    /**< Check that no new node is a duplicate instance of another new node or
+                                         an existing sibling, all the nodes are checked at once before they are
+                                         inserted. */
+
+/** @} batchoptions */
+
+/**
+ * @brief Create a batch of new sibling nodes to be inserted at once.
+ *
+ * Inserting each node separately into a large number of siblings is costly. Nodes of a batch are created unlinked
+ * and when they are all inserted, the children hash table of @p parent is resized at most once and the sorted
+ * (leaf-)list instances are sorted together.
+ *
+ * @param[in] ctx Context of the nodes, may be NULL if @p parent is set.
+ * @param[in] parent Parent node for the nodes being inserted. NULL in case of inserting top-level nodes.
+ * @param[in] count Expected number of nodes, 0 if not known.
+ * @param[in] options Bitmask of options, see @ref batchoptions.
+ * @param[out] batch Created batch, insert it with ::lyd_batch_insert() or free with ::lyd_batch_free().
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_batch_new(const struct ly_ctx *ctx, struct lyd_node *parent, uint32_t count,
+        uint32_t options, struct lyd_batch **batch);
+
+/**
+ * @brief Create a new list node in a batch, see ::lyd_new_list3().
+ *
+ * The node is not inserted until the whole batch is but its children can be created normally.
+ *
+ * @param[in] batch Batch to add the node to.
+ * @param[in] module Module of the node being created. If NULL, the batch parent module will be used.
+ * @param[in] name Schema node name of the new data node. The node must be #LYS_LIST.
+ * @param[in] key_values Ordered key values of the new list instance, all must be set.
+ * Use NULL in case of key-less list.
+ * @param[in] value_sizes_bits Array of size of each @p key_values in bits, may be NULL if @p key_values are 0-terminated strings
+ * and must be set for binary values (::LYD_NEW_VAL_BIN).
+ * @param[in] options Bitmask of options, see @ref newvaloptions.
+ * @param[out] node Optional created node.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_batch_new_list(struct lyd_batch *batch, const struct lys_module *module, const char *name,
+        const void **key_values, uint32_t *value_sizes_bits, uint32_t options, struct lyd_node **node);
+
+/**
+ * @brief Add an unlinked node to a batch.
+ *
+ * @param[in] batch Batch to add to.
+ * @param[in] node Node without a parent and siblings to add, it is spent on success.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_batch_add(struct lyd_batch *batch, struct lyd_node *node);
+
+/**
+ * @brief Insert all the nodes of a batch.
+ *
+ * @param[in] batch Batch to insert, it is freed on success.
+ * @param[in,out] first_sibling Top-level siblings to insert into if the batch has no parent, pointing to NULL
+ * if there are none. Optional if the batch has a parent. Set to the first sibling.
+ * @return LY_SUCCESS on success.
+ * @return LY_EVALID if a duplicate instance was found with ::LYD_BATCH_DUP_CHECK, nothing was inserted.
+ * @return LY_ERR on error, nothing was inserted.
+ */
+LIBYANG_API_DECL LY_ERR lyd_batch_insert(struct lyd_batch *batch, struct lyd_node **first_sibling);
+
+/**
+ * @brief Free a batch including all its nodes that were not inserted.
+ *
+ * @param[in] batch Batch to free.
+ */
+LIBYANG_API_DECL void lyd_batch_free(struct lyd_batch *batch);
+
 /**
  * @brief Create a new term node in the data tree.
  *
@@ -1506,6 +1646,26 @@ LIBYANG_API_DECL LY_ERR lyd_new_path2(struct lyd_node *parent, const struct ly_c
         const void *value, uint64_t value_size_bits, uint32_t any_hints, uint32_t options, struct lyd_node **new_parent,
         struct lyd_node **new_node);
 
+/**
+ * @brief Create a new node in the data tree based on a compiled path.
+ *
+ * It is ::lyd_new_path() with a path compiled by ::lyd_compile_path() and all its variables bound. The prepared
+ * list instances are duplicated so no key values are stored again.
+ *
+ * @param[in] parent Data parent to add to/modify, can be NULL for absolute paths.
+ * @param[in] lypath Compiled path to create.
+ * @param[in] value String value of the new leaf/leaf-list in JSON format. For other node types it should be NULL.
+ * @param[in] options Bitmask of options, see @ref newvaloptions.
+ * @param[out] node Optional first created node.
+ * @return LY_SUCCESS on success.
+ * @return LY_EEXIST if the final node to create exists (unless ::LYD_NEW_PATH_UPDATE is used).
+ * @return LY_EINVAL on invalid arguments including unbound variables of @p lypath.
+ * @return LY_EVALID on invalid @p value.
+ * @return LY_ERR on other errors.
+ */
+LIBYANG_API_DECL LY_ERR lyd_new_compiled_path(struct lyd_node *parent, const struct ly_path *lypath, const char *value,
+        uint32_t options, struct lyd_node **node);
+
 /**
  * @ingroup datatree
  * @defgroup implicitoptions Implicit node creation options
@@ -1800,6 +1960,10 @@ LIBYANG_API_DECL LY_ERR lyd_value_compare(const struct lyd_node_term *node, cons
 #define LYD_COMPARE_OPAQ 0x04           /* Opaque nodes can normally be never equal to data nodes. Using this flag even
                                            opaque nodes members are compared to data node schema and value and can result
                                            in a match. */
+#define LYD_COMPARE_DIGEST 0x08         /* With ::LYD_COMPARE_FULL_RECURSION, inner nodes with equal subtree digests
+                                           (see ::lyd_digest()) are considered equal without descending into them.
+                                           The digests are computed and cached on first use. Different subtrees
+                                           with colliding digests are considered equal. */
 /** @} datacompareoptions */
 
 /**
@@ -1828,6 +1992,26 @@ LIBYANG_API_DECL LY_ERR lyd_compare_single(const struct lyd_node *node1, const s
  */
 LIBYANG_API_DECL LY_ERR lyd_compare_siblings(const struct lyd_node *node1, const struct lyd_node *node2, uint32_t options);
 
+/**
+ * @brief Get the digest of a data subtree.
+ *
+ * The digest is a 64-bit hash of the whole subtree covering schema nodes, values, metadata, default flags, and
+ * the order of all the descendants. Equal subtrees always have the same digest even in different contexts.
+ *
+ * The digest is not a cryptographic hash, different subtrees may have the same digest. The chance of a collision
+ * of two random subtrees is about 2^-64 but the digest functions are public so data can be crafted to collide.
+ * Options relying on digests (::LYD_COMPARE_DIGEST, ::LYD_DIFF_DIGEST) then treat such subtrees as equal and
+ * miss their differences, do not use them if that is unacceptable.
+ *
+ * Digests of inner nodes are computed lazily and cached until the subtree is modified, when the digests of the
+ * modified node and all its ancestors are invalidated.
+ *
+ * @param[in] node Root of the subtree.
+ * @param[out] digest Digest of the subtree.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_digest(const struct lyd_node *node, uint64_t *digest);
+
 /**
  * @brief Compare 2 metadata.
  *
@@ -1941,6 +2125,138 @@ LIBYANG_API_DECL LY_ERR lyd_dup_siblings_to_ctx(const struct lyd_node *node, con
  */
 LIBYANG_API_DECL LY_ERR lyd_dup_meta_single(const struct lyd_meta *meta, struct lyd_node *parent, struct lyd_meta **dup);
 
+/**
+ * @brief Create a whole-tree copy-on-write snapshot of a data tree.
+ *
+ * Snapshots are shared by reference so that creating another snapshot of the same data with ::lyd_snapshot_dup()
+ * is *O(1)*. The data tree of a snapshot is never modified, it can be read using the standard functions for
+ * const data trees, concurrently as well (refer to @ref howtoThreads). To modify it, get the tree using
+ * ::lyd_snapshot_unshare().
+ *
+ * Nothing is shared below the whole tree, a data tree cannot share subtrees with another one (each node has
+ * a single parent). Unsharing a snapshot that is still referenced therefore copies all of its data and costs
+ * the same time and memory as ::lyd_dup_siblings(), regardless of how small the following modification is.
+ *
+ * @param[in] tree Top-level data tree to create a snapshot of, is spent on success. May be NULL.
+ * @param[out] snap Created snapshot with a single reference.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_snapshot_new(struct lyd_node *tree, struct lyd_snapshot **snap);
+
+/**
+ * @brief Create another reference of a snapshot.
+ *
+ * @param[in] snap Snapshot to reference.
+ * @param[out] dup Snapshot reference, which is @p snap itself, to be released with ::lyd_snapshot_free().
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_snapshot_dup(struct lyd_snapshot *snap, struct lyd_snapshot **dup);
+
+/**
+ * @brief Get the data tree of a snapshot.
+ *
+ * @param[in] snap Snapshot to read.
+ * @return First top-level node of the snapshot data tree, NULL if empty.
+ */
+LIBYANG_API_DECL const struct lyd_node *lyd_snapshot_tree(const struct lyd_snapshot *snap);
+
+/**
+ * @brief Release a snapshot reference and get its data tree unshared for modification.
+ *
+ * If @p snap is not referenced anywhere else, its data tree is returned without copying. Otherwise, the whole data
+ * tree is duplicated using ::lyd_dup_siblings() and the other references keep the original data. A new snapshot of
+ * the modified tree can then be created with ::lyd_snapshot_new().
+ *
+ * @param[in] snap Snapshot reference to release, is released only on success.
+ * @param[out] tree Data tree owned by the caller, NULL if the snapshot was empty.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_snapshot_unshare(struct lyd_snapshot *snap, struct lyd_node **tree);
+
+/**
+ * @brief Release a snapshot reference, its data tree is freed with the last reference.
+ *
+ * @param[in] snap Snapshot reference to release.
+ */
+LIBYANG_API_DECL void lyd_snapshot_free(struct lyd_snapshot *snap);
+
+/**
+ * @brief Create a frozen (read-only) copy of a data tree optimized for memory usage and reading.
+ *
+ * All the data node structures are allocated in a single memory block in the order of the data and
+ * the children hash tables are created with their final size. Internal metadata needed only for modifying
+ * the data (the sorting trees of (leaf-)list instances) are not created. The frozen data tree can be read
+ * using the standard functions for const data trees but never modified, use ::lyd_thaw() for that.
+ *
+ * @param[in] tree Top-level data tree to freeze, may be NULL.
+ * @param[out] frozen Created frozen data tree.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_freeze(const struct lyd_node *tree, struct lyd_frozen **frozen);
+
+/**
+ * @brief Get the data tree of a frozen data tree.
+ *
+ * @param[in] frozen Frozen data tree.
+ * @return First top-level node of the data tree, NULL if empty.
+ */
+LIBYANG_API_DECL const struct lyd_node *lyd_frozen_tree(const struct lyd_frozen *frozen);
+
+/**
+ * @brief Create a standard modifiable copy of a frozen data tree.
+ *
+ * @param[in] frozen Frozen data tree.
+ * @param[out] tree Copy of the data tree, NULL if empty.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_thaw(const struct lyd_frozen *frozen, struct lyd_node **tree);
+
+/**
+ * @brief Free a frozen data tree.
+ *
+ * @param[in] frozen Frozen data tree to free.
+ */
+LIBYANG_API_DECL void lyd_frozen_free(struct lyd_frozen *frozen);
+
+/**
+ * @brief Memory used by data nodes, in bytes.
+ *
+ * Strings are stored in the context dictionary shared by all the data trees so they are not included, refer to
+ * ::ly_ctx_mem_usage().
+ */
+struct lyd_mem_usage {
+    uint64_t nodes;         /**< data node structures */
+    uint64_t values;        /**< dynamically allocated parts of the values of built-in types */
+    uint64_t meta;          /**< metadata and attributes with their values */
+    uint64_t hash_tables;   /**< children hash tables of inner nodes */
+    uint64_t lyds;          /**< sorting trees of (leaf-)list instances with their metadata */
+    uint64_t leafref_links; /**< leafref links records of term nodes, see ::LY_CTX_LEAFREF_LINKING */
+    uint64_t node_count;    /**< number of data nodes */
+};
+
+/**
+ * @brief Memory used by all the data nodes of a single schema node, in bytes.
+ */
+struct lyd_mem_usage_schema {
+    const struct lysc_node *schema; /**< schema node of the data nodes, NULL for opaque nodes */
+    uint64_t size;                  /**< total memory used by the data nodes, excluding their descendants */
+    uint64_t count;                 /**< number of the data nodes */
+};
+
+/**
+ * @brief Get the memory used by a data tree.
+ *
+ * @param[in] node Data tree (subtree) to learn about, descendants are always included.
+ * @param[in] siblings Whether to include the following siblings of @p node as well.
+ * @param[out] usage Memory used by the data tree.
+ * @param[out] schemas Optional memory used by the data nodes of every schema node, ordered from the largest
+ * consumer. The array is to be freed by the caller.
+ * @param[out] schema_count Number of items in @p schemas.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_mem_usage(const struct lyd_node *node, ly_bool siblings, struct lyd_mem_usage *usage,
+        struct lyd_mem_usage_schema **schemas, uint32_t *schema_count);
+
 /**
  * @ingroup datatree
  * @defgroup mergeoptions Data merge options.
@@ -2055,6 +2371,15 @@ LIBYANG_API_DECL LY_ERR lyd_merge_module(struct lyd_node **target, const struct
 #define LYD_DIFF_META       0x02 /**< All metadata are compared and the full difference reported in the diff always in
                                       the form of 'yang:meta-\<operation\>' metadata. Also, equal nodes with only changes
                                       in their metadata will be present in the diff with the 'none' operation. */
+#define LYD_DIFF_DIGEST     0x04 /**< Matching inner nodes with equal subtree digests (see ::lyd_digest()) are not
+                                      descended into because there can be no differences in their subtrees. The digests
+                                      are computed and cached on first use so repeated diffs of mostly unchanged trees
+                                      visit only the changed subtrees. Differences in subtrees with colliding digests
+                                      are missed. */
+#define LYD_DIFF_PARALLEL   0x08 /**< Generate diffs of independent subtrees (top-level nodes and instances of large lists)
+                                      concurrently in several threads and connect them into the resulting diff, which
+                                      is identical to the one generated without this option. Both data trees are only
+                                      read but must not be modified by other threads during the diff. */
 
 /** @} diffoptions */
 
@@ -2119,6 +2444,10 @@ typedef LY_ERR (*lyd_diff_cb)(const struct lyd_node *diff_node, struct lyd_node
  * created. Unless the resulting tree is validated (and default values thus consolidated), using it further
  * (such as applying another diff) may cause unexpected results or errors.
  *
+ * Without @p diff_cb, creating and deleting siblings not ordered by the user is performed in batches for every
+ * parent (all the deletes first and then all the created nodes inserted at once). With the callback, all the
+ * operations are applied one-by-one in the diff order.
+ *
  * @param[in,out] data Data to apply the diff on.
  * @param[in] diff Diff to apply.
  * @param[in] mod Module, whose diff/data only to consider, NULL for all modules.
@@ -2307,6 +2636,46 @@ LIBYANG_API_DECL LY_ERR lyd_find_sibling_first(const struct lyd_node *siblings,
 LIBYANG_API_DECL LY_ERR lyd_find_sibling_val(const struct lyd_node *siblings, const struct lysc_node *schema,
         const char *key_or_value, uint32_t val_len, struct lyd_node **match);
 
+/**
+ * @brief Search in the given siblings for a list or leaf-list instance with binary values.
+ * Uses hashes - should be used whenever possible for best performance.
+ *
+ * Unlike ::lyd_find_sibling_val(), no value is printed or parsed as a string and the hash of the instance is
+ * computed directly from the values.
+ *
+ * @param[in] siblings Siblings to search in including preceding and succeeding nodes.
+ * @param[in] schema Schema node of the list with keys or the leaf-list to find.
+ * @param[in] key_values Ordered key values of the list or the value of the leaf-list in the binary ::LY_VALUE_LYB
+ * format, for example a little-endian integer.
+ * @param[in] value_sizes_bits Array of size of each @p key_values in bits.
+ * @param[out] match Can be NULL, otherwise the found data node.
+ * @return LY_SUCCESS on success, @p match set.
+ * @return LY_ENOTFOUND if not found, @p match set to NULL.
+ * @return LY_EINVAL if @p schema is a key-less list.
+ * @return LY_ERR value if another error occurred.
+ */
+LIBYANG_API_DECL LY_ERR lyd_find_sibling_bin(const struct lyd_node *siblings, const struct lysc_node *schema,
+        const void **key_values, const uint32_t *value_sizes_bits, struct lyd_node **match);
+
+/**
+ * @brief Search in the given siblings for a list or leaf-list instance with stored values.
+ * Uses hashes - should be used whenever possible for best performance.
+ *
+ * The hash of the instance is computed directly from the values and no instance is created for comparison.
+ *
+ * @param[in] siblings Siblings to search in including preceding and succeeding nodes.
+ * @param[in] schema Schema node of the list with keys or the leaf-list to find.
+ * @param[in] key_values Ordered stored key values of the list or the value of the leaf-list. They are expected to be
+ * stored for the key types, for example taken from other instances of the keys.
+ * @param[out] match Can be NULL, otherwise the found data node.
+ * @return LY_SUCCESS on success, @p match set.
+ * @return LY_ENOTFOUND if not found, @p match set to NULL.
+ * @return LY_EINVAL if @p schema is a key-less list.
+ * @return LY_ERR value if another error occurred.
+ */
+LIBYANG_API_DECL LY_ERR lyd_find_sibling_stored(const struct lyd_node *siblings, const struct lysc_node *schema,
+        const struct lyd_value **key_values, struct lyd_node **match);
+
 /**
  * @brief Search the given siblings for all the exact same instances of a specific node instance.
  * Uses hashes to whatever extent possible.
@@ -2410,6 +2779,53 @@ LIBYANG_API_DECL LY_ERR lyd_find_xpath2(const struct lyd_node *ctx_node, const c
 LIBYANG_API_DECL LY_ERR lyd_find_xpath3(const struct lyd_node *ctx_node, const struct lyd_node *tree, const char *xpath,
         LY_VALUE_FORMAT format, void *prefix_data, const struct lyxp_var *vars, struct ly_set **set);
 
+/**
+ * @brief Opaque XPath iterator, see ::lyd_xpath_iter_new().
+ */
+struct lyd_xpath_iter;
+
+/**
+ * @brief Create an iterator over the data nodes matching the provided XPath.
+ *
+ * The nodes are returned in the same order as by ::lyd_find_xpath3(). Location paths consisting only of child
+ * (`/`) and descendant (`//`) steps with name tests and no predicates, such as `/mod:cont//leaf`, are evaluated
+ * lazily, each ::lyd_xpath_iter_next() call continues a single traversal of the data until the next matching node
+ * so the iteration can be stopped early cheaply. All the other expressions are evaluated by this function.
+ *
+ * The data tree must not be modified while the iterator is being used.
+ *
+ * @param[in] ctx_node XPath context node, NULL for the root node.
+ * @param[in] tree Data tree to evaluate on.
+ * @param[in] xpath [XPath](@ref howtoXPath) to select with prefixes in @p format. It must evaluate into a node set.
+ * @param[in] format Format of any prefixes in @p xpath.
+ * @param[in] prefix_data Format-specific prefix data.
+ * @param[in] vars [Sized array](@ref sizedarrays) of XPath variables.
+ * @param[out] iter Created iterator, free with ::lyd_xpath_iter_free().
+ * @return LY_SUCCESS on success, @p iter is returned.
+ * @return LY_ERR value if an error occurred.
+ */
+LIBYANG_API_DECL LY_ERR lyd_xpath_iter_new(const struct lyd_node *ctx_node, const struct lyd_node *tree,
+        const char *xpath, LY_VALUE_FORMAT format, void *prefix_data, const struct lyxp_var *vars,
+        struct lyd_xpath_iter **iter);
+
+/**
+ * @brief Get the next data node matching the XPath of an iterator.
+ *
+ * @param[in] iter XPath iterator.
+ * @param[out] node Next matching data node.
+ * @return LY_SUCCESS on success, @p node is returned.
+ * @return LY_ENOTFOUND if there are no more matching nodes.
+ * @return LY_ERR value if an error occurred.
+ */
+LIBYANG_API_DECL LY_ERR lyd_xpath_iter_next(struct lyd_xpath_iter *iter, struct lyd_node **node);
+
+/**
+ * @brief Free an XPath iterator.
+ *
+ * @param[in] iter XPath iterator to free.
+ */
+LIBYANG_API_DECL void lyd_xpath_iter_free(struct lyd_xpath_iter *iter);
+
 /**
  * @brief Evaluate an XPath on data and return the result converted to boolean.
  *
@@ -2524,6 +2940,80 @@ LIBYANG_API_DEF LY_ERR lyd_trim_xpath(struct lyd_node **tree, const char *xpath,
 LIBYANG_API_DECL LY_ERR lyd_find_path(const struct lyd_node *ctx_node, const char *path, ly_bool output,
         struct lyd_node **match);
 
+/**
+ * @brief Compile a path to be used for searching data repeatedly.
+ *
+ * The path is parsed and compiled only once and the list and leaf-list instances matching its predicates are
+ * prepared beforehand so that ::lyd_find_compiled_path() performs only the hash-based searches.
+ *
+ * The path may be a template with variables used instead of the list key values, for example
+ * `/ietf-interfaces:interfaces/interface[name=$name]`. Their values must be bound using ::lyd_compiled_path_bind()
+ * or ::lyd_compiled_path_bind_val() before the path is used and can be rebound any number of times.
+ *
+ * @param[in] ctx libyang context, may be NULL if @p ctx_node is set.
+ * @param[in] ctx_node Path context schema node, may be NULL for absolute paths.
+ * @param[in] path [Path](@ref howtoXPath) to compile.
+ * @param[in] output Whether to search in RPC/action output nodes or in input nodes.
+ * @param[out] lypath Compiled path, free with ::lyd_free_compiled_path().
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_compile_path(const struct ly_ctx *ctx, const struct lysc_node *ctx_node, const char *path,
+        ly_bool output, struct ly_path **lypath);
+
+/**
+ * @brief Bind a stored value to a key variable of a compiled path.
+ *
+ * @param[in] lypath Compiled path with the variable.
+ * @param[in] name Name of the variable, without the `$`.
+ * @param[in] value Stored value to bind, for example of another instance of the key. It is duplicated if of the key
+ * type, otherwise its canonical value is stored.
+ * @return LY_SUCCESS on success.
+ * @return LY_ENOTFOUND if the variable is not used in @p lypath.
+ * @return LY_ERR on other errors.
+ */
+LIBYANG_API_DECL LY_ERR lyd_compiled_path_bind(struct ly_path *lypath, const char *name, const struct lyd_value *value);
+
+/**
+ * @brief Bind a value to a key variable of a compiled path.
+ *
+ * @param[in] lypath Compiled path with the variable.
+ * @param[in] name Name of the variable, without the `$`.
+ * @param[in] value Value to bind. In ::LY_VALUE_LYB format, the native binary value of the key type is expected,
+ * for example a little-endian integer.
+ * @param[in] value_size_bits Size of @p value in bits.
+ * @param[in] format Format of @p value, ::LY_VALUE_JSON, ::LY_VALUE_CANON, or ::LY_VALUE_LYB.
+ * @return LY_SUCCESS on success.
+ * @return LY_ENOTFOUND if the variable is not used in @p lypath.
+ * @return LY_EVALID on invalid @p value.
+ * @return LY_ERR on other errors.
+ */
+LIBYANG_API_DECL LY_ERR lyd_compiled_path_bind_val(struct ly_path *lypath, const char *name, const void *value,
+        uint64_t value_size_bits, LY_VALUE_FORMAT format);
+
+/**
+ * @brief Search in given data for a node uniquely identified by a compiled path.
+ *
+ * It is ::lyd_find_path() with a path compiled by ::lyd_compile_path().
+ *
+ * @param[in] ctx_node Path context node, any node in the data tree for absolute paths.
+ * @param[in] lypath Compiled path to find.
+ * @param[out] match Can be NULL, otherwise the found data node.
+ * @return LY_SUCCESS on success, @p match is set to the found node.
+ * @return LY_EINCOMPLETE if only a parent of the node was found, @p match is set to this parent node.
+ * @return LY_ENOTFOUND if no nodes in the path were found.
+ * @return LY_EINVAL if a variable of @p lypath is not bound.
+ * @return LY_ERR on other errors.
+ */
+LIBYANG_API_DECL LY_ERR lyd_find_compiled_path(const struct lyd_node *ctx_node, const struct ly_path *lypath,
+        struct lyd_node **match);
+
+/**
+ * @brief Free a path compiled by ::lyd_compile_path().
+ *
+ * @param[in] lypath Compiled path to free.
+ */
+LIBYANG_API_DECL void lyd_free_compiled_path(struct ly_path *lypath);
+
 /**
  * @brief Find the target node of a compiled path (::lyd_value instance-identifier).
  *
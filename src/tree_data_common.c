@@ -481,8 +481,8 @@ lyd_data_next_module(struct lyd_node **next, struct lyd_node **first)
 LY_ERR
 lyd_value_store(const struct ly_ctx *ctx, const struct lyd_node *lnode, struct lyd_value *val,
         const struct lysc_type *type, const void *value, uint64_t value_size_bits, ly_bool is_utf8, ly_bool store_only,
-        ly_bool *dynamic, LY_VALUE_FORMAT format, void *prefix_data, uint32_t hints, const struct lysc_node *ctx_snode,
-        ly_bool *incomplete)
+        ly_bool ref_input, ly_bool *dynamic, LY_VALUE_FORMAT format, void *prefix_data, uint32_t hints,
+        const struct lysc_node *ctx_snode, ly_bool *incomplete)
 {
     LY_ERR r;
     struct ly_err_item *err = NULL;
@@ -505,6 +505,9 @@ lyd_value_store(const struct ly_ctx *ctx, const struct lyd_node *lnode, struct l
     if (store_only) {
         options |= LYPLG_TYPE_STORE_ONLY;
     }
+    if (ref_input) {
+        options |= LYPLG_TYPE_STORE_REF_INPUT;
+    }
 
     r = LYSC_GET_TYPE_PLG(type->plugin_ref)->store(ctx, type, value, value_size_bits, options, format, prefix_data,
             hints, ctx_snode, val, NULL, &err);
@@ -535,6 +538,26 @@ lyd_value_store(const struct ly_ctx *ctx, const struct lyd_node *lnode, struct l
     return LY_SUCCESS;
 }
 
+LY_ERR
+lyd_value_store_from(const struct lysc_node *schema, const struct lyd_value *value, struct lyd_value *val)
+{
+    const struct ly_ctx *ctx = schema->module->ctx;
+    const struct lysc_type *type = ((struct lysc_node_leaf *)schema)->type;
+    const char *canon;
+
+    if ((value->realtype == type) ||
+            ((type->basetype == LY_TYPE_LEAFREF) && (value->realtype == ((struct lysc_type_leafref *)type)->realtype))) {
+        /* value of the same type, only duplicate it */
+        return LYSC_GET_TYPE_PLG(value->realtype->plugin_ref)->duplicate(ctx, value, val);
+    }
+
+    /* value of another type, store its canonical value */
+    canon = lyd_value_get_canonical(ctx, value);
+    LY_CHECK_RET(!canon, LY_EMEM);
+    return lyd_value_store(ctx, NULL, val, type, canon, strlen(canon) * 8, 1, 0, 0, NULL, LY_VALUE_JSON, NULL,
+            LYD_HINT_DATA, schema, NULL);
+}
+
 LY_ERR
 lyd_value_validate_incomplete(const struct ly_ctx *ctx, const struct lysc_type *type, struct lyd_value *val,
         const struct lyd_node *ctx_node, const struct lyd_node *tree)
@@ -696,7 +719,7 @@ lyd_value_compare(const struct lyd_node_term *node, const char *value, uint32_t
     type = ((struct lysc_node_leaf *)node->schema)->type;
 
     /* store the value */
-    LY_CHECK_RET(lyd_value_store(ctx, &node->node, &val, type, value, value_len * 8, 0, 0, NULL, LY_VALUE_JSON, NULL,
+    LY_CHECK_RET(lyd_value_store(ctx, &node->node, &val, type, value, value_len * 8, 0, 0, 0, NULL, LY_VALUE_JSON, NULL,
             LYD_HINT_DATA, node->schema, NULL));
 
     /* compare values */
@@ -971,9 +994,13 @@ cleanup:
 LIBYANG_API_DEF const char *
 lyd_value_get_canonical(const struct ly_ctx *ctx, const struct lyd_value *value)
 {
+    const char *canon;
+
     LY_CHECK_ARG_RET(ctx, ctx, value, NULL);
 
-    return value->_canonical ? value->_canonical :
+    /* may be published concurrently by ::lyplg_type_set_canonical() */
+    canon = ATOMIC_PTR_LOAD_ACQUIRE(value->_canonical);
+    return canon ? canon :
            (const char *)LYSC_GET_TYPE_PLG(value->realtype->plugin_ref)->print(ctx, value, LY_VALUE_CANON, NULL, NULL, NULL);
 }
 
@@ -1197,6 +1224,7 @@ lyd_np_cont_dflt_set(struct lyd_node *parent)
 
         /* set the dflt flag */
         parent->flags |= LYD_DEFAULT;
+        lyd_digest_invalidate(parent);
 
         /* check all parent containers */
         parent = parent->parent;
@@ -1208,6 +1236,7 @@ lyd_np_cont_dflt_del(struct lyd_node *parent)
 {
     while (parent && (parent->flags & LYD_DEFAULT)) {
         parent->flags &= ~LYD_DEFAULT;
+        lyd_digest_invalidate(parent);
         parent = parent->parent;
     }
 }
@@ -39,6 +39,7 @@ lyd_free_meta(struct lyd_meta *meta, ly_bool siblings)
     }
 
     if (meta->parent) {
+        lyd_digest_invalidate(meta->parent);
         if (meta->parent->meta == meta) {
             if (siblings) {
                 meta->parent->meta = NULL;
@@ -209,21 +210,25 @@ lyd_free_leafref_nodes(const struct lyd_node_term *node)
  * @brief Free Data (sub)tree.
  *
  * @param[in] node Data node to be freed.
+ * @param[in] free_node Whether to free the node structures or only their content.
  */
 static void
-lyd_free_subtree(struct lyd_node *node)
+lyd_free_subtree(struct lyd_node *node, ly_bool free_node)
 {
     struct lyd_node *iter, *next;
     struct lyd_node_opaq *opaq = NULL;
 
     assert(node);
 
+    /* remove cached descendant index */
+    lyd_desc_index_remove(node);
+
     if (!node->schema) {
         opaq = (struct lyd_node_opaq *)node;
 
         /* free the children */
         LY_LIST_FOR_SAFE(lyd_child(node), next, iter) {
-            lyd_free_subtree(iter);
+            lyd_free_subtree(iter, free_node);
         }
 
         lydict_remove(LYD_CTX(opaq), opaq->name.name);
@@ -235,9 +240,12 @@ lyd_free_subtree(struct lyd_node *node)
         /* remove children hash table in case of inner data node */
         lyht_free(((struct lyd_node_inner *)node)->children_ht, NULL);
 
+        /* remove cached digest */
+        lyd_digest_remove(node);
+
         /* free the children */
         LY_LIST_FOR_SAFE(lyd_child(node), next, iter) {
-            lyd_free_subtree(iter);
+            lyd_free_subtree(iter, free_node);
         }
     } else if (node->schema->nodetype & LYD_NODE_ANY) {
         assert(!((struct lyd_node_any *)node)->children_ht);
@@ -258,7 +266,9 @@ lyd_free_subtree(struct lyd_node *node)
         lyd_free_meta_siblings(node->meta);
     }
 
-    free(node);
+    if (free_node) {
+        free(node);
+    }
 }
 
 LIBYANG_API_DEF void
@@ -274,7 +284,7 @@ lyd_free_tree(struct lyd_node *node)
     }
 
     lyd_unlink(node);
-    lyd_free_subtree(node);
+    lyd_free_subtree(node, 1);
 }
 
 static void
@@ -297,7 +307,7 @@ lyd_free_(struct lyd_node *node)
             lyds_free_metadata(iter);
             lyd_unlink_ignore_lyds(&first_sibling, iter);
         }
-        lyd_free_subtree(iter);
+        lyd_free_subtree(iter, 1);
     }
 }
 
@@ -319,3 +329,25 @@ lyd_free_all(struct lyd_node *node)
 
     lyd_free_(node);
 }
+
+void
+lyd_free_frozen_siblings(struct lyd_node *node)
+{
+    struct lyd_node *iter, *next;
+
+    LY_LIST_FOR_SAFE(node, next, iter) {
+        lyd_free_subtree(iter, 0);
+    }
+}
+
+LIBYANG_API_DEF void
+lyd_frozen_free(struct lyd_frozen *frozen)
+{
+    if (!frozen) {
+        return;
+    }
+
+    lyd_free_frozen_siblings(frozen->tree);
+    free(frozen->nodes);
+    free(frozen);
+}
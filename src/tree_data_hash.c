@@ -13,14 +13,17 @@
  */
 
 #include <assert.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "compat.h"
 #include "hash_table.h"
+#include "hash_table_internal.h"
 #include "log.h"
 #include "ly_common.h"
+#include "plugins_exts/metadata.h"
 #include "plugins_internal.h"
 #include "plugins_types.h"
 #include "tree.h"
@@ -28,14 +31,35 @@
 #include "tree_data_internal.h"
 #include "tree_schema.h"
 
-LY_ERR
-lyd_hash(struct lyd_node *node)
+/**
+ * @brief Add a stored value into a hash.
+ *
+ * @param[in] hash Hash to add to.
+ * @param[in] value Value to hash.
+ * @return Updated hash.
+ */
+static uint32_t
+lyd_hash_value(uint32_t hash, const struct lyd_value *value)
 {
-    struct lyd_node *iter;
     const void *hash_key;
     ly_bool dyn;
     uint64_t key_size_bits;
 
+    hash_key = LYSC_GET_TYPE_PLG(value->realtype->plugin_ref)->print(NULL, value, LY_VALUE_LYB, NULL, &dyn,
+            &key_size_bits);
+    hash = lyht_hash_multi(hash, hash_key, LYPLG_BITS2BYTES(key_size_bits));
+    if (dyn) {
+        free((void *)hash_key);
+    }
+
+    return hash;
+}
+
+LY_ERR
+lyd_hash(struct lyd_node *node)
+{
+    struct lyd_node *iter;
+
     if (!node->schema) {
         return LY_SUCCESS;
     }
@@ -55,26 +79,12 @@ lyd_hash(struct lyd_node *node)
 
             /* list hash is made up from its keys */
             for (iter = list->child; iter && iter->schema && (iter->schema->flags & LYS_KEY); iter = iter->next) {
-                struct lyd_node_term *key = (struct lyd_node_term *)iter;
-
-                hash_key = LYSC_GET_TYPE_PLG(key->value.realtype->plugin_ref)->print(NULL, &key->value,
-                        LY_VALUE_LYB, NULL, &dyn, &key_size_bits);
-                node->hash = lyht_hash_multi(node->hash, hash_key, LYPLG_BITS2BYTES(key_size_bits));
-                if (dyn) {
-                    free((void *)hash_key);
-                }
+                node->hash = lyd_hash_value(node->hash, &((struct lyd_node_term *)iter)->value);
             }
         }
     } else if (node->schema->nodetype == LYS_LEAFLIST) {
         /* leaf-list adds its hash key */
-        struct lyd_node_term *llist = (struct lyd_node_term *)node;
-
-        hash_key = LYSC_GET_TYPE_PLG(llist->value.realtype->plugin_ref)->print(NULL, &llist->value,
-                LY_VALUE_LYB, NULL, &dyn, &key_size_bits);
-        node->hash = lyht_hash_multi(node->hash, hash_key, LYPLG_BITS2BYTES(key_size_bits));
-        if (dyn) {
-            free((void *)hash_key);
-        }
+        node->hash = lyd_hash_value(node->hash, &((struct lyd_node_term *)node)->value);
     }
 
     /* finish the hash */
@@ -83,6 +93,32 @@ lyd_hash(struct lyd_node *node)
     return LY_SUCCESS;
 }
 
+uint32_t
+lyd_hash_inst(const struct lysc_node *schema, const struct lyd_value **values)
+{
+    uint32_t hash;
+    const struct lysc_node *key;
+    uint32_t i;
+
+    assert(((schema->nodetype == LYS_LIST) && !(schema->flags & LYS_KEYLESS)) || (schema->nodetype == LYS_LEAFLIST));
+
+    /* the same hash as of the instance */
+    hash = lyht_hash_multi(0, schema->module->name, strlen(schema->module->name));
+    hash = lyht_hash_multi(hash, schema->name, strlen(schema->name));
+
+    if (schema->nodetype == LYS_LIST) {
+        i = 0;
+        for (key = lysc_node_child(schema); key && (key->flags & LYS_KEY); key = key->next) {
+            hash = lyd_hash_value(hash, values[i]);
+            ++i;
+        }
+    } else {
+        hash = lyd_hash_value(hash, values[0]);
+    }
+
+    return lyht_hash_multi(hash, NULL, 0);
+}
+
 /**
  * @brief Compare callback for values in hash table.
  *
@@ -244,3 +280,727 @@ lyd_unlink_hash(struct lyd_node *node)
         }
     }
 }
+
+void
+lyd_hash_first_inst_replace(struct lyd_node *old_first, struct lyd_node *new_first)
+{
+    struct lyd_node_inner *parent;
+    uint32_t hash;
+
+    if (!old_first->parent || !old_first->parent->schema || !((struct lyd_node_inner *)old_first->parent)->children_ht) {
+        /* not in any HT */
+        return;
+    }
+
+    parent = (struct lyd_node_inner *)old_first->parent;
+
+    /* get the simple hash */
+    hash = lyht_hash_multi(0, old_first->schema->module->name, strlen(old_first->schema->module->name));
+    hash = lyht_hash_multi(hash, old_first->schema->name, strlen(old_first->schema->name));
+    hash = lyht_hash_multi(hash, NULL, 0);
+
+    /* replace the first instance */
+    if (lyht_remove(parent->children_ht, &old_first, hash)) {
+        LOGINT(LYD_CTX(old_first));
+        return;
+    }
+    if (lyht_insert(parent->children_ht, &new_first, hash, NULL)) {
+        LOGINT(LYD_CTX(old_first));
+        return;
+    }
+}
+
+LY_ERR
+lyd_insert_hash_reserve(struct lyd_node *parent, uint32_t count)
+{
+    struct lyd_node_inner *inner;
+    struct lyd_node *iter;
+    struct ly_ht *ht;
+    uint32_t u, size;
+
+    if (!parent || !parent->schema || !(parent->schema->nodetype & LYD_NODE_INNER)) {
+        /* no HT */
+        return LY_SUCCESS;
+    }
+
+    inner = (struct lyd_node_inner *)parent;
+
+    /* learn the final number of children */
+    u = count;
+    LY_LIST_FOR(inner->child, iter) {
+        if (iter->schema) {
+            ++u;
+        }
+    }
+    if (u < LYD_HT_MIN_ITEMS) {
+        /* HT is not needed */
+        return LY_SUCCESS;
+    }
+
+    /* the first (leaf-)list instances are stored twice, so expect twice the number of records in the worst case
+     * and keep them below the enlarge threshold */
+    size = lyht_get_fixed_size(((2 * u) * LYHT_HUNDRED_PERCENTAGE) / LYHT_ENLARGE_PERCENTAGE + 1);
+    if (inner->children_ht && (inner->children_ht->size >= size)) {
+        /* large enough */
+        return LY_SUCCESS;
+    }
+
+    /* create the new HT with all the current children */
+    ht = lyht_new(size, sizeof(struct lyd_node *), lyd_hash_table_val_equal, NULL, 1);
+    LY_CHECK_ERR_RET(!ht, LOGMEM(LYD_CTX(parent)), LY_EMEM);
+    LY_LIST_FOR(inner->child, iter) {
+        if (iter->schema) {
+            LY_CHECK_ERR_RET(lyd_insert_hash_add(ht, iter, 1), lyht_free(ht, NULL), LY_EINT);
+        }
+    }
+
+    lyht_free(inner->children_ht, NULL);
+    inner->children_ht = ht;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Add bytes into a 64-bit digest (FNV-1a).
+ *
+ * @param[in] digest Digest to update.
+ * @param[in] data Data to add.
+ * @param[in] len Length of @p data.
+ * @return Updated digest.
+ */
+static uint64_t
+lyd_digest_add(uint64_t digest, const void *data, size_t len)
+{
+    const uint8_t *bytes = data;
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+        digest ^= bytes[i];
+        digest *= 0x100000001b3ULL;
+    }
+
+    return digest;
+}
+
+/**
+ * @brief Add a string including its terminating zero into a digest so that adjacent strings cannot be confused.
+ *
+ * @param[in] digest Digest to update.
+ * @param[in] str String to add, NULL is treated as an empty string.
+ * @return Updated digest.
+ */
+static uint64_t
+lyd_digest_add_str(uint64_t digest, const char *str)
+{
+    if (!str) {
+        str = "";
+    }
+
+    return lyd_digest_add(digest, str, strlen(str) + 1);
+}
+
+/**
+ * @brief Finish a digest by mixing all its bits (splitmix64 finalizer).
+ *
+ * @param[in] digest Digest to finish.
+ * @return Final digest.
+ */
+static uint64_t
+lyd_digest_finish(uint64_t digest)
+{
+    digest ^= digest >> 30;
+    digest *= 0xbf58476d1ce4e5b9ULL;
+    digest ^= digest >> 27;
+    digest *= 0x94d049bb133111ebULL;
+    digest ^= digest >> 31;
+
+    return digest;
+}
+
+static LY_ERR lyd_digest_get(const struct lyd_node *node, uint64_t *digest);
+
+/**
+ * @brief Compute the digest of a data node and its subtree.
+ *
+ * @param[in] node Node to process.
+ * @param[out] digest Computed digest.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_digest_compute(const struct lyd_node *node, uint64_t *digest)
+{
+    const struct lyd_node_opaq *opaq;
+    const struct lyd_node *child;
+    const struct lyd_meta *meta;
+    const struct lyd_attr *attr;
+    uint64_t d, child_digest;
+    uint32_t dflt;
+    char *str;
+
+    d = 0xcbf29ce484222325ULL;
+
+    if (node->schema) {
+        /* schema node identity, valid across contexts */
+        d = lyd_digest_add_str(d, node->schema->module->name);
+        d = lyd_digest_add_str(d, node->schema->name);
+
+        /* metadata, except the internal sorting tree */
+        LY_LIST_FOR(node->meta, meta) {
+            if (!strcmp(meta->name, "lyds_tree")) {
+                continue;
+            }
+            d = lyd_digest_add_str(d, meta->annotation->module->name);
+            d = lyd_digest_add_str(d, meta->name);
+            d = lyd_digest_add_str(d, lyd_get_meta_value(meta));
+        }
+
+        /* value */
+        if (node->schema->nodetype & LYD_NODE_TERM) {
+            d = lyd_digest_add_str(d, lyd_get_value(node));
+        } else if ((node->schema->nodetype & LYD_NODE_ANY) && !((struct lyd_node_any *)node)->child) {
+            LY_CHECK_RET(lyd_any_value_str(node, LYD_XML, &str));
+            d = lyd_digest_add_str(d, str);
+            free(str);
+        }
+    } else {
+        opaq = (const struct lyd_node_opaq *)node;
+        d = lyd_digest_add_str(d, opaq->name.module_ns);
+        d = lyd_digest_add_str(d, opaq->name.name);
+        d = lyd_digest_add_str(d, opaq->value);
+        LY_LIST_FOR(opaq->attr, attr) {
+            d = lyd_digest_add_str(d, attr->name.module_ns);
+            d = lyd_digest_add_str(d, attr->name.name);
+            d = lyd_digest_add_str(d, attr->value);
+        }
+    }
+
+    /* default flag is significant for diff */
+    dflt = node->flags & LYD_DEFAULT;
+    d = lyd_digest_add(d, &dflt, sizeof dflt);
+
+    /* children, in order */
+    LY_LIST_FOR(lyd_child_any(node), child) {
+        LY_CHECK_RET(lyd_digest_get(child, &child_digest));
+        d = lyd_digest_add(d, &child_digest, sizeof child_digest);
+    }
+
+    *digest = lyd_digest_finish(d);
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Get the digest of a data node, use the cached one of an inner node or compute and cache it.
+ *
+ * @param[in] node Node to process.
+ * @param[out] digest Node digest.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_digest_get(const struct lyd_node *node, uint64_t *digest)
+{
+    struct ly_ctx_shared_data *ctx_data;
+    struct lyd_digest_rec rec, *match;
+    uint32_t hash;
+    LY_ERR r;
+
+    if (!node->schema || !(node->schema->nodetype & LYD_NODE_INNER)) {
+        /* not cached */
+        return lyd_digest_compute(node, digest);
+    }
+
+    ctx_data = ly_ctx_shared_data_get(LYD_CTX(node));
+    rec.node = node;
+    hash = lyht_hash((const char *)&node, sizeof node);
+
+    /* DIGEST LOCK */
+    pthread_mutex_lock(&ctx_data->digest_lock);
+
+    r = lyht_find(ctx_data->digest_ht, &rec, hash, (void **)&match);
+    if (!r) {
+        *digest = match->digest;
+    }
+
+    /* DIGEST UNLOCK */
+    pthread_mutex_unlock(&ctx_data->digest_lock);
+
+    if (!r) {
+        return LY_SUCCESS;
+    }
+
+    /* compute the digest, caches also all the descendant inner node digests */
+    LY_CHECK_RET(lyd_digest_compute(node, &rec.digest));
+
+    /* DIGEST LOCK */
+    pthread_mutex_lock(&ctx_data->digest_lock);
+
+    r = lyht_insert(ctx_data->digest_ht, &rec, hash, (void **)&match);
+    if (!r) {
+        ATOMIC_INC_RELAXED(ctx_data->digest_count);
+    } else if (r == LY_EEXIST) {
+        /* cached by another reader in the meantime */
+        rec.digest = match->digest;
+        r = LY_SUCCESS;
+    }
+
+    /* DIGEST UNLOCK */
+    pthread_mutex_unlock(&ctx_data->digest_lock);
+
+    if (r) {
+        LOGINT_RET(LYD_CTX(node));
+    }
+
+    *digest = rec.digest;
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_digest(const struct lyd_node *node, uint64_t *digest)
+{
+    LY_CHECK_ARG_RET(NULL, node, digest, LY_EINVAL);
+
+    return lyd_digest_get(node, digest);
+}
+
+/**
+ * @brief Remove a cached digest of a single node.
+ *
+ * Context digest lock is expected to be held.
+ *
+ * @param[in] ctx_data Context shared data.
+ * @param[in] node Inner data node.
+ * @return LY_SUCCESS if the digest was removed, LY_ENOTFOUND if the node had no cached digest.
+ */
+static LY_ERR
+lyd_digest_remove_locked(struct ly_ctx_shared_data *ctx_data, const struct lyd_node *node)
+{
+    struct lyd_digest_rec rec = {0};
+    uint32_t hash;
+
+    rec.node = node;
+    hash = lyht_hash((const char *)&node, sizeof node);
+    if (lyht_find(ctx_data->digest_ht, &rec, hash, NULL)) {
+        return LY_ENOTFOUND;
+    }
+
+    lyht_remove(ctx_data->digest_ht, &rec, hash);
+    ATOMIC_DEC_RELAXED(ctx_data->digest_count);
+    return LY_SUCCESS;
+}
+
+void
+lyd_digest_remove(struct lyd_node *node)
+{
+    struct ly_ctx_shared_data *ctx_data;
+
+    ctx_data = ly_ctx_shared_data_get(LYD_CTX(node));
+    if (!ATOMIC_LOAD_RELAXED(ctx_data->digest_count)) {
+        /* no cached digests */
+        return;
+    }
+
+    /* DIGEST LOCK */
+    pthread_mutex_lock(&ctx_data->digest_lock);
+
+    lyd_digest_remove_locked(ctx_data, node);
+
+    /* DIGEST UNLOCK */
+    pthread_mutex_unlock(&ctx_data->digest_lock);
+}
+
+void
+lyd_digest_invalidate(struct lyd_node *node)
+{
+    struct ly_ctx_shared_data *ctx_data;
+
+    if (!node) {
+        return;
+    }
+
+    ctx_data = ly_ctx_shared_data_get(LYD_CTX(node));
+    if (!ATOMIC_LOAD_RELAXED(ctx_data->digest_count)) {
+        /* no cached digests */
+        return;
+    }
+
+    /* DIGEST LOCK */
+    pthread_mutex_lock(&ctx_data->digest_lock);
+
+    for ( ; node; node = node->parent) {
+        if (!node->schema || !(node->schema->nodetype & LYD_NODE_INNER)) {
+            /* not cached */
+            continue;
+        }
+
+        if (lyd_digest_remove_locked(ctx_data, node)) {
+            /* no ancestor can have a cached digest either */
+            break;
+        }
+    }
+
+    /* DIGEST UNLOCK */
+    pthread_mutex_unlock(&ctx_data->digest_lock);
+}
+
+/**
+ * @brief Callback for comparing two descendant index inner node records.
+ */
+static ly_bool
+lyd_desc_index_inner_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyd_desc_index_inner *inner1 = val1_p, *inner2 = val2_p;
+
+    return inner1->node == inner2->node;
+}
+
+/**
+ * @brief Callback for comparing two descendant index schema records.
+ */
+static ly_bool
+lyd_desc_index_schema_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyd_desc_index_schema *schema1 = val1_p, *schema2 = val2_p;
+
+    return schema1->schema == schema2->schema;
+}
+
+/**
+ * @brief Callback for finding all the descendant index schema records with a name.
+ *
+ * When searching for the previous match (@p mod set), only the same record matches.
+ */
+static ly_bool
+lyd_desc_index_name_equal_cb(void *val1_p, void *val2_p, ly_bool mod, void *UNUSED(cb_data))
+{
+    struct lyd_desc_index_schema *schema1 = val1_p, *schema2 = val2_p;
+
+    if (mod) {
+        return schema1->schema == schema2->schema;
+    }
+    return (schema1->name_len == schema2->name_len) && !strncmp(schema1->name, schema2->name, schema1->name_len);
+}
+
+/**
+ * @brief Free a descendant index schema record, callback for ::lyht_free().
+ *
+ * @param[in] val_p Pointer to the record.
+ */
+static void
+lyd_desc_index_schema_free(void *val_p)
+{
+    struct lyd_desc_index_schema *schema = val_p;
+
+    free(schema->insts);
+}
+
+void
+lyd_desc_index_rec_free(void *val_p)
+{
+    struct lyd_desc_index_rec *rec = val_p;
+
+    lyht_free(rec->inner, NULL);
+    lyht_free(rec->schemas, lyd_desc_index_schema_free);
+}
+
+uint64_t
+lyd_desc_index_rec_mem_usage(const struct lyd_desc_index_rec *rec)
+{
+    struct lyd_desc_index_schema *schema;
+    struct ly_ht_rec *ht_rec;
+    uint32_t hlist_idx, rec_idx;
+    uint64_t size;
+
+    size = lyht_mem_usage(rec->inner) + lyht_mem_usage(rec->schemas);
+    LYHT_ITER_ALL_RECS(rec->schemas, hlist_idx, rec_idx, ht_rec) {
+        schema = (struct lyd_desc_index_schema *)ht_rec->val;
+        size += (uint64_t)schema->size * sizeof *schema->insts;
+    }
+
+    return size;
+}
+
+/**
+ * @brief Add a data node with all its descendants into a descendant index, in the document order.
+ *
+ * @param[in] node Data node to add.
+ * @param[in] rec Index to add to.
+ * @param[in,out] pos Preorder position of @p node, is moved after its last descendant.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_desc_index_build(const struct lyd_node *node, struct lyd_desc_index_rec *rec, uint32_t *pos)
+{
+    const struct lyd_node *child;
+    struct lyd_desc_index_inner inner;
+    struct lyd_desc_index_schema schema, *match;
+    void *mem;
+    uint32_t hash;
+    LY_ERR r;
+
+    inner.node = node;
+    inner.pos = (*pos)++;
+
+    /* unknown opaque nodes never match a name test, but their descendants may */
+    schema.schema = lyd_node_schema(node);
+    if (schema.schema) {
+        schema.name = schema.schema->name;
+        schema.name_len = strlen(schema.name);
+        hash = lyht_hash(schema.name, schema.name_len);
+
+        r = lyht_find(rec->schemas, &schema, hash, (void **)&match);
+        if (r == LY_ENOTFOUND) {
+            schema.insts = NULL;
+            schema.count = 0;
+            schema.size = 0;
+            LY_CHECK_RET(lyht_insert(rec->schemas, &schema, hash, (void **)&match));
+        }
+
+        if (match->count == match->size) {
+            mem = realloc(match->insts, (match->size ? match->size * 2 : 8) * sizeof *match->insts);
+            LY_CHECK_ERR_RET(!mem, LOGMEM(LYD_CTX(node)), LY_EMEM);
+            match->insts = mem;
+            match->size = match->size ? match->size * 2 : 8;
+        }
+        match->insts[match->count].node = node;
+        match->insts[match->count].pos = inner.pos;
+        ++match->count;
+    }
+
+    if (!lyd_child_any(node)) {
+        return LY_SUCCESS;
+    }
+
+    LY_LIST_FOR(lyd_child_any(node), child) {
+        LY_CHECK_RET(lyd_desc_index_build(child, rec, pos));
+    }
+
+    /* the range of all the descendants */
+    inner.end = *pos;
+    return lyht_insert(rec->inner, &inner, lyht_hash((const char *)&node, sizeof node), NULL);
+}
+
+/**
+ * @brief Get the cached descendant index of a data tree, build it if there is none.
+ *
+ * Context digest lock is expected to be held.
+ *
+ * @param[in] top Top-level node of the data tree.
+ * @param[out] index Index of the data tree.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_desc_index_tree_get(const struct lyd_node *top, struct lyd_desc_index_rec **index)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct ly_ctx_shared_data *ctx_data;
+    struct lyd_desc_index_rec rec = {0};
+    uint32_t hash, pos = 0;
+
+    ctx_data = ly_ctx_shared_data_get(LYD_CTX(top));
+    assert(ctx_data->desc_index_ht);
+    rec.node = top;
+    hash = lyht_hash((const char *)&top, sizeof top);
+
+    if (!lyht_find(ctx_data->desc_index_ht, &rec, hash, (void **)index)) {
+        return LY_SUCCESS;
+    }
+
+    /* build the index */
+    rec.inner = lyht_new(LYHT_MIN_SIZE, sizeof(struct lyd_desc_index_inner), lyd_desc_index_inner_equal_cb, NULL, 1);
+    rec.schemas = lyht_new(LYHT_MIN_SIZE, sizeof(struct lyd_desc_index_schema), lyd_desc_index_schema_equal_cb, NULL, 1);
+    LY_CHECK_ERR_GOTO(!rec.inner || !rec.schemas, LOGMEM(LYD_CTX(top)); rc = LY_EMEM, cleanup);
+    LY_CHECK_GOTO(rc = lyd_desc_index_build(top, &rec, &pos), cleanup);
+
+    LY_CHECK_GOTO(rc = lyht_insert(ctx_data->desc_index_ht, &rec, hash, (void **)index), cleanup);
+    ATOMIC_INC_RELAXED(ctx_data->desc_index_count);
+
+cleanup:
+    if (rc) {
+        lyd_desc_index_rec_free(&rec);
+    }
+    return rc;
+}
+
+/**
+ * @brief Compare descendant index instances by their position, callback for qsort().
+ */
+static int
+lyd_desc_index_inst_cmp(const void *ptr1, const void *ptr2)
+{
+    const struct lyd_desc_index_inst *inst1 = ptr1, *inst2 = ptr2;
+
+    return (inst1->pos > inst2->pos) - (inst1->pos < inst2->pos);
+}
+
+LY_ERR
+lyd_desc_index_get(const struct lyd_node *node, const char *name, uint32_t name_len, struct ly_set **nodes)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct ly_ctx_shared_data *ctx_data;
+    const struct lyd_node *top;
+    struct lyd_desc_index_rec *index;
+    struct lyd_desc_index_inner inner, *range;
+    struct lyd_desc_index_schema schema, *match;
+    struct lyd_desc_index_inst *insts = NULL;
+    uint32_t i, hash, count = 0, schema_count = 0, lo, hi;
+    void *mem;
+
+    *nodes = NULL;
+
+    if (!lyd_child_any(node)) {
+        /* no descendants */
+        return LY_SUCCESS;
+    }
+
+    /* the index is kept for the whole data tree */
+    for (top = node; top->parent; top = top->parent) {}
+
+    ctx_data = ly_ctx_shared_data_get(LYD_CTX(node));
+
+    /* DIGEST LOCK */
+    pthread_mutex_lock(&ctx_data->digest_lock);
+
+    LY_CHECK_GOTO(rc = lyd_desc_index_tree_get(top, &index), cleanup);
+
+    /* the range of the descendants of the node */
+    inner.node = node;
+    if (lyht_find(index->inner, &inner, lyht_hash((const char *)&node, sizeof node), (void **)&range)) {
+        LOGINT(LYD_CTX(node));
+        rc = LY_EINT;
+        goto cleanup;
+    }
+
+    /* collect the descendant instances of all the schema nodes with the name */
+    schema.schema = NULL;
+    schema.name = name;
+    schema.name_len = name_len;
+    hash = lyht_hash(name, name_len);
+    if (lyht_find_with_val_cb(index->schemas, &schema, hash, lyd_desc_index_name_equal_cb, (void **)&match)) {
+        match = NULL;
+    }
+    while (match) {
+        /* first instance after the node */
+        lo = 0;
+        hi = match->count;
+        while (lo < hi) {
+            i = lo + (hi - lo) / 2;
+            if (match->insts[i].pos <= range->pos) {
+                lo = i + 1;
+            } else {
+                hi = i;
+            }
+        }
+
+        for (i = lo; (i < match->count) && (match->insts[i].pos < range->end); ++i) {
+            if (!(count % 8)) {
+                mem = realloc(insts, (count + 8) * sizeof *insts);
+                LY_CHECK_ERR_GOTO(!mem, LOGMEM(LYD_CTX(node)); rc = LY_EMEM, cleanup);
+                insts = mem;
+            }
+            insts[count++] = match->insts[i];
+        }
+        ++schema_count;
+
+        if (lyht_find_next_with_collision_cb(index->schemas, match, hash, lyd_desc_index_name_equal_cb,
+                (void **)&match)) {
+            match = NULL;
+        }
+    }
+
+    if (!count) {
+        goto cleanup;
+    }
+    if (schema_count > 1) {
+        /* merge the instances of several schema nodes into the document order */
+        qsort(insts, count, sizeof *insts, lyd_desc_index_inst_cmp);
+    }
+
+    LY_CHECK_GOTO(rc = ly_set_new(nodes), cleanup);
+    for (i = 0; i < count; ++i) {
+        LY_CHECK_GOTO(rc = ly_set_add(*nodes, insts[i].node, 1, NULL), cleanup);
+    }
+
+cleanup:
+    /* DIGEST UNLOCK */
+    pthread_mutex_unlock(&ctx_data->digest_lock);
+
+    free(insts);
+    if (rc) {
+        ly_set_free(*nodes, NULL);
+        *nodes = NULL;
+    }
+    return rc;
+}
+
+/**
+ * @brief Remove the cached descendant index of a single node.
+ *
+ * Context digest lock is expected to be held.
+ *
+ * @param[in] ctx_data Context shared data.
+ * @param[in] node Data node.
+ */
+static void
+lyd_desc_index_remove_locked(struct ly_ctx_shared_data *ctx_data, const struct lyd_node *node)
+{
+    struct lyd_desc_index_rec rec = {0}, *match;
+    uint32_t hash;
+
+    /* the indexes may have been dropped with the context option */
+    if (!ctx_data->desc_index_ht) {
+        return;
+    }
+
+    rec.node = node;
+    hash = lyht_hash((const char *)&node, sizeof node);
+    if (!lyht_find(ctx_data->desc_index_ht, &rec, hash, (void **)&match)) {
+        lyd_desc_index_rec_free(match);
+        lyht_remove(ctx_data->desc_index_ht, &rec, hash);
+        ATOMIC_DEC_RELAXED(ctx_data->desc_index_count);
+    }
+}
+
+void
+lyd_desc_index_remove(struct lyd_node *node)
+{
+    struct ly_ctx_shared_data *ctx_data;
+
+    ctx_data = ly_ctx_shared_data_get(LYD_CTX(node));
+    if (!ATOMIC_LOAD_RELAXED(ctx_data->desc_index_count)) {
+        /* no cached indexes */
+        return;
+    }
+
+    /* DIGEST LOCK */
+    pthread_mutex_lock(&ctx_data->digest_lock);
+
+    lyd_desc_index_remove_locked(ctx_data, node);
+
+    /* DIGEST UNLOCK */
+    pthread_mutex_unlock(&ctx_data->digest_lock);
+}
+
+void
+lyd_desc_index_invalidate(struct lyd_node *node)
+{
+    struct ly_ctx_shared_data *ctx_data;
+
+    if (!node) {
+        return;
+    }
+
+    ctx_data = ly_ctx_shared_data_get(LYD_CTX(node));
+    if (!ATOMIC_LOAD_RELAXED(ctx_data->desc_index_count)) {
+        /* no cached indexes */
+        return;
+    }
+
+    /* DIGEST LOCK */
+    pthread_mutex_lock(&ctx_data->digest_lock);
+
+    /* the index is kept for the top-level node but a linked subtree may have kept its own */
+    for ( ; node; node = node->parent) {
+        lyd_desc_index_remove_locked(ctx_data, node);
+    }
+
+    /* DIGEST UNLOCK */
+    pthread_mutex_unlock(&ctx_data->digest_lock);
+}
@@ -42,6 +42,49 @@ struct lyd_dup_inst {
     uint32_t used;
 };
 
+/**
+ * @brief Data tree snapshot shared by reference, copied as a whole when unshared.
+ */
+struct lyd_snapshot {
+    struct lyd_node *tree;  /**< first top-level node of the data tree, never modified while referenced */
+    ATOMIC_T refcount;      /**< number of references */
+};
+
+/**
+ * @brief Builder of new sibling nodes inserted at once.
+ */
+struct lyd_batch {
+    const struct ly_ctx *ctx;   /**< context of all the nodes */
+    struct lyd_node *parent;    /**< parent to insert the nodes into, NULL for top-level nodes */
+    struct lyd_node **nodes;    /**< unlinked nodes to insert */
+    uint32_t count;             /**< number of @p nodes */
+    uint32_t size;              /**< allocated size of @p nodes */
+    uint32_t options;           /**< batch options */
+};
+
+/**
+ * @brief Get the memory used by a leafref links record.
+ *
+ * @param[in] rec Leafref links record.
+ * @return Memory used by @p rec in bytes.
+ */
+uint64_t lyd_leafref_links_rec_mem_usage(const struct lyd_leafref_links_rec *rec);
+
+/**
+ * @brief Frozen (read-only) data tree.
+ */
+struct lyd_frozen {
+    struct lyd_node *tree;  /**< first top-level node of the data tree */
+    void *nodes;            /**< memory block with all the data node structures */
+};
+
+/**
+ * @brief Free frozen data siblings with their descendants, the node structures themselves are not freed.
+ *
+ * @param[in] node First sibling to free.
+ */
+void lyd_free_frozen_siblings(struct lyd_node *node);
+
 /**
  * @brief Update a found inst using a duplicate instance cache hash table. Needs to be called for every "used"
  * (that should not be considered next time) instance.
@@ -213,6 +256,7 @@ const char *ly_format2str(LY_VALUE_FORMAT format);
  * @param[in] value_size_bits Size of @p value in bits, must be set correctly.
  * @param[in] is_utf8 Whether @p value is a valid UTF-8 string, if applicable.
  * @param[in] store_only Whether to perform storing operation only.
+ * @param[in] ref_input Whether @p value may only be referenced, see ::LYPLG_TYPE_STORE_REF_INPUT.
  * @param[in,out] dynamic Flag if @p value is dynamically allocated, is adjusted when @p value is consumed.
  * @param[in] format Input format of @p value.
  * @param[in] prefix_data Format-specific data for resolving any prefixes (see ::ly_resolve_prefix).
@@ -223,8 +267,21 @@ const char *ly_format2str(LY_VALUE_FORMAT format);
  * @return LY_ERR value if an error occurred.
  */
 LY_ERR lyd_create_term(const struct lysc_node *schema, const struct lyd_node *lnode, const void *value,
-        uint64_t value_size_bits, ly_bool is_utf8, ly_bool store_only, ly_bool *dynamic, LY_VALUE_FORMAT format,
-        void *prefix_data, uint32_t hints, ly_bool *incomplete, struct lyd_node **node);
+        uint64_t value_size_bits, ly_bool is_utf8, ly_bool store_only, ly_bool ref_input, ly_bool *dynamic,
+        LY_VALUE_FORMAT format, void *prefix_data, uint32_t hints, ly_bool *incomplete, struct lyd_node **node);
+
+/**
+ * @brief Create a term (leaf/leaf-list) node from an already stored value.
+ *
+ * Hash is calculated and new node flag is set.
+ *
+ * @param[in] schema Schema node of the new data node.
+ * @param[in] val Stored value of the node type, is spent even on error.
+ * @param[out] node Created node.
+ * @return LY_SUCCESS on success.
+ * @return LY_ERR value if an error occurred.
+ */
+LY_ERR lyd_create_term2(const struct lysc_node *schema, struct lyd_value *val, struct lyd_node **node);
 
 /**
  * @brief Create an inner (container/list/RPC/action/notification) node.
@@ -450,9 +507,24 @@ void lyd_insert_before_node(struct lyd_node *sibling, struct lyd_node *node);
                                                   in Debug build, to detect misuse of the LYD_PARSE_ORDERED flag. */
 #define LYD_INSERT_NODE_LAST_BY_SCHEMA  0x02 /**< The node is inserted according to the schema as a last instance.
                                                   Node order not checked. */
+#define LYD_INSERT_NODE_DEFER_SORT     0x03 /**< Same as ::LYD_INSERT_NODE_DEFAULT except that instances of (leaf-)lists
+                                                  without BST are only appended. They must all be sorted later
+                                                  by ::lyds_sort_siblings(). */
 
 /** @} insertorder */
 
+/**
+ * @brief Check schema place of a node to be inserted.
+ *
+ * @param[in] parent Schema node of the parent data node.
+ * @param[in] sibling Schema node of a sibling data node.
+ * @param[in] schema Schema node if the data node to be inserted.
+ * @return LY_SUCCESS on success.
+ * @return LY_EINVAL if the place is invalid.
+ */
+LY_ERR lyd_insert_check_schema(const struct lysc_node *parent, const struct lysc_node *sibling,
+        const struct lysc_node *schema);
+
 /**
  * @brief Insert a node into parent/siblings. Order and hashes are fully handled.
  *
@@ -602,6 +674,7 @@ ly_bool lyd_compare_schema_equal(const struct lysc_node *schema1, const struct l
  * @param[in] value_size_bits Size of @p value in bits, must be set correctly.
  * @param[in] is_utf8 Whether @p value is a valid UTF-8 string, if applicable.
  * @param[in] store_only Whether to perform storing operation only.
+ * @param[in] ref_input Whether @p value may only be referenced, see ::LYPLG_TYPE_STORE_REF_INPUT.
  * @param[in,out] dynamic Flag if @p value is dynamically allocated, is adjusted when @p value is consumed.
  * @param[in] format Input format of @p value.
  * @param[in] prefix_data Format-specific data for resolving any prefixes (see ::ly_resolve_prefix).
@@ -613,8 +686,18 @@ ly_bool lyd_compare_schema_equal(const struct lysc_node *schema1, const struct l
  */
 LY_ERR lyd_value_store(const struct ly_ctx *ctx, const struct lyd_node *lnode, struct lyd_value *val,
         const struct lysc_type *type, const void *value, uint64_t value_size_bits, ly_bool is_utf8, ly_bool store_only,
-        ly_bool *dynamic, LY_VALUE_FORMAT format, void *prefix_data, uint32_t hints, const struct lysc_node *ctx_snode,
-        ly_bool *incomplete);
+        ly_bool ref_input, ly_bool *dynamic, LY_VALUE_FORMAT format, void *prefix_data, uint32_t hints,
+        const struct lysc_node *ctx_snode, ly_bool *incomplete);
+
+/**
+ * @brief Store a value of a term node from a value stored before, possibly for another type.
+ *
+ * @param[in] schema Term node schema of the value.
+ * @param[in] value Stored value to use, is duplicated if of the @p schema type.
+ * @param[out] val Stored value.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_value_store_from(const struct lysc_node *schema, const struct lyd_value *value, struct lyd_value *val);
 
 /**
  * @brief Validate previously incompletely stored value.
@@ -688,6 +771,15 @@ LY_ERR lyd_value_validate3(const struct lysc_node *schema, const char *value, si
  */
 LY_ERR lyd_hash(struct lyd_node *node);
 
+/**
+ * @brief Generate hash of a list or leaf-list instance with the given values without creating it.
+ *
+ * @param[in] schema Schema node of the list with keys or the leaf-list.
+ * @param[in] values Ordered stored key values of the list or the value of the leaf-list.
+ * @return Hash equal to the hash of the instance generated by ::lyd_hash().
+ */
+uint32_t lyd_hash_inst(const struct lysc_node *schema, const struct lyd_value **values);
+
 /**
  * @brief Compare callback for values in hash table.
  *
@@ -712,6 +804,133 @@ LY_ERR lyd_insert_hash(struct lyd_node *node);
  */
 void lyd_unlink_hash(struct lyd_node *node);
 
+/**
+ * @brief Update the parent children hash table after another instance of a (leaf-)list became the first one.
+ *
+ * @param[in] old_first Previous first instance.
+ * @param[in] new_first New first instance, already linked instead of @p old_first.
+ */
+void lyd_hash_first_inst_replace(struct lyd_node *old_first, struct lyd_node *new_first);
+
+/**
+ * @brief Make sure the children hash table of a node is large enough for additional children.
+ *
+ * The hash table is rebuilt at most once so that inserting the children later causes no resizing.
+ *
+ * @param[in] parent Parent data node, nothing is done if it cannot have a children hash table.
+ * @param[in] count Number of children to be inserted.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_insert_hash_reserve(struct lyd_node *parent, uint32_t count);
+
+/**
+ * @brief Internal data digest hash table record.
+ */
+struct lyd_digest_rec {
+    const struct lyd_node *node;    /**< inner data node, used as the key */
+    uint64_t digest;                /**< cached subtree digest of the node */
+};
+
+/**
+ * @brief Invalidate cached digests of a node and all its ancestors.
+ *
+ * Needs to be called on every change of the data that are covered by the digest. If the node
+ * (or the nearest inner ancestor of a terminal node) has no cached digest, none of its ancestors can have one.
+ *
+ * @param[in] node Changed node or the parent of a linked/unlinked node, may be NULL.
+ */
+void lyd_digest_invalidate(struct lyd_node *node);
+
+/**
+ * @brief Internal data descendant index hash table record.
+ */
+struct lyd_desc_index_rec {
+    const struct lyd_node *node;    /**< top-level data node whose subtree is indexed, used as the key */
+    struct ly_ht *inner;            /**< hash table of the preorder positions of all the nodes with children
+                                         (struct lyd_desc_index_inner) */
+    struct ly_ht *schemas;          /**< hash table of the instances of all the schema nodes (struct lyd_desc_index_schema) */
+};
+
+/**
+ * @brief Node with children in a data descendant index.
+ */
+struct lyd_desc_index_inner {
+    const struct lyd_node *node;    /**< data node, used as the key */
+    uint32_t pos;                   /**< preorder position of the node */
+    uint32_t end;                   /**< preorder position following the last descendant of the node */
+};
+
+/**
+ * @brief Instance of a schema node in a data descendant index.
+ */
+struct lyd_desc_index_inst {
+    const struct lyd_node *node;    /**< data node instance */
+    uint32_t pos;                   /**< preorder position of the instance */
+};
+
+/**
+ * @brief Instances of a specific schema node in a data descendant index.
+ */
+struct lyd_desc_index_schema {
+    const struct lysc_node *schema; /**< schema node, used as the key */
+    const char *name;               /**< schema node name, not terminated for lookups by name */
+    uint32_t name_len;              /**< length of @p name */
+    struct lyd_desc_index_inst *insts;  /**< instances in the document order */
+    uint32_t count;                 /**< number of @p insts */
+    uint32_t size;                  /**< allocated size of @p insts */
+};
+
+/**
+ * @brief Get all the descendants of a data node with a specific name from the index of its whole data tree, which
+ * is built if needed.
+ *
+ * @param[in] node Data node whose descendants to get.
+ * @param[in] name Name of the descendants.
+ * @param[in] name_len Length of @p name.
+ * @param[out] nodes Descendants in the document order, NULL if there are none. Needs to be freed.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_desc_index_get(const struct lyd_node *node, const char *name, uint32_t name_len, struct ly_set **nodes);
+
+/**
+ * @brief Remove the cached descendant index of a node, if there is any.
+ *
+ * @param[in] node Data node.
+ */
+void lyd_desc_index_remove(struct lyd_node *node);
+
+/**
+ * @brief Invalidate cached descendant indexes of a node and all its ancestors.
+ *
+ * Needs to be called on every change of the descendants of a node, does nothing without
+ * ::LY_CTX_XPATH_DESC_INDEX.
+ *
+ * @param[in] node Parent of a linked/unlinked node, may be NULL.
+ */
+void lyd_desc_index_invalidate(struct lyd_node *node);
+
+/**
+ * @brief Free a descendant index record, callback for ::lyht_free().
+ *
+ * @param[in] val_p Pointer to the record.
+ */
+void lyd_desc_index_rec_free(void *val_p);
+
+/**
+ * @brief Get the memory used by a descendant index record, except the record itself.
+ *
+ * @param[in] rec Descendant index record.
+ * @return Memory used by @p rec in bytes.
+ */
+uint64_t lyd_desc_index_rec_mem_usage(const struct lyd_desc_index_rec *rec);
+
+/**
+ * @brief Remove a cached digest of a single node, which is being freed, if there is any.
+ *
+ * @param[in] node Inner data node.
+ */
+void lyd_digest_remove(struct lyd_node *node);
+
 /** @} datahash */
 
 /**
@@ -29,6 +29,7 @@
 #include "dict.h"
 #include "diff.h"
 #include "hash_table.h"
+#include "hash_table_internal.h"
 #include "in.h"
 #include "in_internal.h"
 #include "log.h"
@@ -53,8 +54,8 @@
 
 LY_ERR
 lyd_create_term(const struct lysc_node *schema, const struct lyd_node *lnode, const void *value,
-        uint64_t value_size_bits, ly_bool is_utf8, ly_bool store_only, ly_bool *dynamic, LY_VALUE_FORMAT format,
-        void *prefix_data, uint32_t hints, ly_bool *incomplete, struct lyd_node **node)
+        uint64_t value_size_bits, ly_bool is_utf8, ly_bool store_only, ly_bool ref_input, ly_bool *dynamic,
+        LY_VALUE_FORMAT format, void *prefix_data, uint32_t hints, ly_bool *incomplete, struct lyd_node **node)
 {
     LY_ERR ret;
     struct lyd_node_term *term;
@@ -69,7 +70,7 @@ lyd_create_term(const struct lysc_node *schema, const struct lyd_node *lnode, co
     term->flags = LYD_NEW;
 
     ret = lyd_value_store(schema->module->ctx, lnode, &term->value, ((struct lysc_node_leaf *)term->schema)->type,
-            value, value_size_bits, is_utf8, store_only, dynamic, format, prefix_data, hints, schema, incomplete);
+            value, value_size_bits, is_utf8, store_only, ref_input, dynamic, format, prefix_data, hints, schema, incomplete);
     LY_CHECK_ERR_RET(ret, free(term), ret);
     lyd_hash(&term->node);
 
@@ -77,6 +78,27 @@ lyd_create_term(const struct lysc_node *schema, const struct lyd_node *lnode, co
     return ret;
 }
 
+LY_ERR
+lyd_create_term2(const struct lysc_node *schema, struct lyd_value *val, struct lyd_node **node)
+{
+    struct lyd_node_term *term;
+
+    assert(schema->nodetype & LYD_NODE_TERM);
+
+    term = calloc(1, sizeof *term);
+    LY_CHECK_ERR_RET(!term, LOGMEM(schema->module->ctx);
+            LYSC_GET_TYPE_PLG(val->realtype->plugin_ref)->free(schema->module->ctx, val), LY_EMEM);
+
+    term->schema = schema;
+    term->prev = &term->node;
+    term->flags = LYD_NEW;
+    term->value = *val;
+    lyd_hash(&term->node);
+
+    *node = &term->node;
+    return LY_SUCCESS;
+}
+
 LY_ERR
 lyd_create_inner(const struct lysc_node *schema, struct lyd_node **node)
 {
@@ -132,7 +154,7 @@ lyd_create_list(const struct lysc_node *schema, const struct ly_path_predicate *
             value = predicates[u].value;
         }
 
-        ret = lyd_create_term(predicates[u].key, NULL, value, strlen(value) * 8, 1, store_only, NULL, LY_VALUE_JSON,
+        ret = lyd_create_term(predicates[u].key, NULL, value, strlen(value) * 8, 1, store_only, 0, NULL, LY_VALUE_JSON,
                 NULL, LYD_HINT_DATA, NULL, &key);
         LY_CHECK_GOTO(ret, cleanup);
         lyd_insert_node(list, NULL, key, LYD_INSERT_NODE_DEFAULT);
@@ -329,6 +351,8 @@ lyd_any_copy_value(struct lyd_node *trg, const struct lyd_node *child, const cha
     t = (struct lyd_node_any *)trg;
 
     /* free trg */
+    lyd_digest_invalidate(trg);
+    lyd_desc_index_invalidate(trg);
     lyd_free_siblings(t->child);
     t->child = NULL;
     lydict_remove(LYD_CTX(trg), t->value);
@@ -433,7 +457,9 @@ lyd_new_val_get_format(uint32_t options, LY_VALUE_FORMAT *format)
 {
     LY_CHECK_ARG_RET(NULL, format, LY_EVALID);
 
-    if (options & LYD_NEW_VAL_CANON) {
+    if (options & LYD_NEW_VAL_BIN) {
+        *format = LY_VALUE_LYB;
+    } else if (options & LYD_NEW_VAL_CANON) {
         *format = LY_VALUE_CANON;
     } else {
         *format = LY_VALUE_JSON;
@@ -556,7 +582,7 @@ lyd_new_list(struct lyd_node *parent, const struct lys_module *module, const cha
             key_val = va_arg(ap, const char *);
             key_size_bits = key_val ? strlen((char *)key_val) * 8 : 0;
         }
-        rc = lyd_create_term(key_s, parent, key_val, key_size_bits, 0, store_only, NULL, format, NULL, LYD_HINT_DATA,
+        rc = lyd_create_term(key_s, parent, key_val, key_size_bits, 0, store_only, 0, NULL, format, NULL, LYD_HINT_DATA,
                 NULL, &key);
         LY_CHECK_GOTO(rc, cleanup);
         lyd_insert_node(ret, NULL, key, LYD_INSERT_NODE_LAST);
@@ -628,23 +654,31 @@ lyd_new_list2(struct lyd_node *parent, const struct lys_module *module, const ch
     return LY_SUCCESS;
 }
 
-LIBYANG_API_DEF LY_ERR
-lyd_new_list3(struct lyd_node *parent, const struct lys_module *module, const char *name, const void **key_values,
-        uint32_t *value_sizes_bits, uint32_t options, struct lyd_node **node)
+/**
+ * @brief Create a new list node with its keys, not inserted into @p parent.
+ *
+ * @param[in] ctx Context of the new node.
+ * @param[in] parent Parent node for the node being created, used only to find its schema node.
+ * @param[in] module Module of the node being created. If NULL, @p parent module will be used.
+ * @param[in] name Schema node name of the new data node. The node must be #LYS_LIST.
+ * @param[in] key_values Ordered key values of the new list instance, all must be set.
+ * @param[in] value_sizes_bits Array of size of each @p key_values in bits, may be NULL.
+ * @param[in] options Bitmask of options, see @ref newvaloptions.
+ * @param[in] format Format of @p key_values.
+ * @param[out] node Created node.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+_lyd_new_list3(const struct ly_ctx *ctx, const struct lyd_node *parent, const struct lys_module *module,
+        const char *name, const void **key_values, uint32_t *value_sizes_bits, uint32_t options, LY_VALUE_FORMAT format,
+        struct lyd_node **node)
 {
     struct lyd_node *ret = NULL, *key;
     const struct lysc_node *key_s;
-    const struct ly_ctx *ctx = parent ? LYD_CTX(parent) : (module ? module->ctx : NULL);
     const void *key_val;
     uint32_t key_size_bits, i;
     LY_ERR rc = LY_SUCCESS;
     ly_bool store_only = (options & LYD_NEW_VAL_STORE_ONLY) ? 1 : 0;
-    LY_VALUE_FORMAT format;
-
-    LY_CHECK_RET(lyd_new_val_get_format(options, &format));
-    LY_CHECK_ARG_RET(ctx, parent || module, parent || node, name, (format != LY_VALUE_LYB) || value_sizes_bits, LY_EINVAL);
-    LY_CHECK_CTX_EQUAL_RET(__func__, parent ? LYD_CTX(parent) : NULL, module ? module->ctx : NULL, LY_EINVAL);
-    LY_CHECK_ARG_RET(ctx, !(store_only && (format == LY_VALUE_CANON || format == LY_VALUE_LYB)), LY_EINVAL);
 
     /* create the list node */
     LY_CHECK_RET(_lyd_new_list_node(ctx, parent, module, name, options, &ret));
@@ -661,13 +695,79 @@ lyd_new_list3(struct lyd_node *parent, const struct lys_module *module, const ch
         key_val = key_values[i] ? key_values[i] : "";
         key_size_bits = value_sizes_bits ? value_sizes_bits[i] : strlen(key_val) * 8;
 
-        rc = lyd_create_term(key_s, parent, key_val, key_size_bits, 0, store_only, NULL, format, NULL, LYD_HINT_DATA,
+        rc = lyd_create_term(key_s, parent, key_val, key_size_bits, 0, store_only, 0, NULL, format, NULL, LYD_HINT_DATA,
                 NULL, &key);
         LY_CHECK_GOTO(rc, cleanup);
         lyd_insert_node(ret, NULL, key, LYD_INSERT_NODE_LAST);
         ++i;
     }
 
+cleanup:
+    if (rc) {
+        lyd_free_tree(ret);
+    } else {
+        *node = ret;
+    }
+    return rc;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_new_list3(struct lyd_node *parent, const struct lys_module *module, const char *name, const void **key_values,
+        uint32_t *value_sizes_bits, uint32_t options, struct lyd_node **node)
+{
+    struct lyd_node *ret;
+    const struct ly_ctx *ctx = parent ? LYD_CTX(parent) : (module ? module->ctx : NULL);
+    ly_bool store_only = (options & LYD_NEW_VAL_STORE_ONLY) ? 1 : 0;
+    LY_VALUE_FORMAT format;
+
+    LY_CHECK_RET(lyd_new_val_get_format(options, &format));
+    LY_CHECK_ARG_RET(ctx, parent || module, parent || node, name, (format != LY_VALUE_LYB) || value_sizes_bits, LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, parent ? LYD_CTX(parent) : NULL, module ? module->ctx : NULL, LY_EINVAL);
+    LY_CHECK_ARG_RET(ctx, !(store_only && (format == LY_VALUE_CANON || format == LY_VALUE_LYB)), LY_EINVAL);
+
+    LY_CHECK_RET(_lyd_new_list3(ctx, parent, module, name, key_values, value_sizes_bits, options, format, &ret));
+
+    if (parent) {
+        lyd_insert_node(parent, NULL, ret, LYD_INSERT_NODE_DEFAULT);
+    }
+    if (node) {
+        *node = ret;
+    }
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_new_list_stored(struct lyd_node *parent, const struct lys_module *module, const char *name,
+        const struct lyd_value **key_values, uint32_t options, struct lyd_node **node)
+{
+    struct lyd_node *ret = NULL, *key;
+    const struct lysc_node *key_s;
+    const struct ly_ctx *ctx = parent ? LYD_CTX(parent) : (module ? module->ctx : NULL);
+    struct lyd_value val;
+    uint32_t i;
+    LY_ERR rc = LY_SUCCESS;
+
+    LY_CHECK_ARG_RET(ctx, parent || module, parent || node, name, LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, parent ? LYD_CTX(parent) : NULL, module ? module->ctx : NULL, LY_EINVAL);
+
+    /* create the list node */
+    LY_CHECK_RET(_lyd_new_list_node(ctx, parent, module, name, options, &ret));
+
+    if (!(ret->schema->flags & LYS_KEYLESS) && !key_values) {
+        LOGERR(ctx, LY_EINVAL, "Missing list \"%s\" keys.", LYD_NAME(ret));
+        rc = LY_EINVAL;
+        goto cleanup;
+    }
+
+    /* create and insert all the keys from the stored values, the list is hashed once all are inserted */
+    i = 0;
+    for (key_s = lysc_node_child(ret->schema); key_s && (key_s->flags & LYS_KEY); key_s = key_s->next) {
+        LY_CHECK_GOTO(rc = lyd_value_store_from(key_s, key_values[i], &val), cleanup);
+        LY_CHECK_GOTO(rc = lyd_create_term2(key_s, &val, &key), cleanup);
+        lyd_insert_node(ret, NULL, key, LYD_INSERT_NODE_LAST);
+        ++i;
+    }
+
     if (parent) {
         lyd_insert_node(parent, NULL, ret, LYD_INSERT_NODE_DEFAULT);
     }
@@ -682,6 +782,279 @@ cleanup:
     return rc;
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_batch_new(const struct ly_ctx *ctx, struct lyd_node *parent, uint32_t count, uint32_t options,
+        struct lyd_batch **batch)
+{
+    struct lyd_batch *b;
+
+    if (!ctx && parent) {
+        ctx = LYD_CTX(parent);
+    }
+    LY_CHECK_ARG_RET(ctx, ctx, batch, !parent || !parent->schema || (parent->schema->nodetype & LYD_NODE_INNER),
+            LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, ctx, parent ? LYD_CTX(parent) : NULL, LY_EINVAL);
+
+    *batch = NULL;
+
+    b = calloc(1, sizeof *b);
+    LY_CHECK_ERR_RET(!b, LOGMEM(ctx), LY_EMEM);
+    b->ctx = ctx;
+    b->parent = parent;
+    b->options = options;
+
+    if (count) {
+        b->nodes = malloc(count * sizeof *b->nodes);
+        LY_CHECK_ERR_RET(!b->nodes, LOGMEM(ctx); free(b), LY_EMEM);
+        b->size = count;
+    }
+
+    *batch = b;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Append an unlinked node to a batch.
+ *
+ * @param[in] batch Batch to append to.
+ * @param[in] node Node to append.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_batch_append(struct lyd_batch *batch, struct lyd_node *node)
+{
+    struct lyd_node **nodes;
+    uint32_t size;
+
+    if (batch->count == batch->size) {
+        size = batch->size ? batch->size * 2 : 8;
+        nodes = realloc(batch->nodes, size * sizeof *nodes);
+        LY_CHECK_ERR_RET(!nodes, LOGMEM(batch->ctx), LY_EMEM);
+        batch->nodes = nodes;
+        batch->size = size;
+    }
+
+    batch->nodes[batch->count++] = node;
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_batch_add(struct lyd_batch *batch, struct lyd_node *node)
+{
+    LY_CHECK_ARG_RET(NULL, batch, node, !node->parent, node->prev == node, LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, batch->ctx, LYD_CTX(node), LY_EINVAL);
+
+    if (!(node->flags & LYD_EXT) && (!batch->parent || batch->parent->schema)) {
+        LY_CHECK_RET(lyd_insert_check_schema(batch->parent ? batch->parent->schema : NULL, NULL, node->schema));
+    }
+
+    return lyd_batch_append(batch, node);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_batch_new_list(struct lyd_batch *batch, const struct lys_module *module, const char *name, const void **key_values,
+        uint32_t *value_sizes_bits, uint32_t options, struct lyd_node **node)
+{
+    struct lyd_node *ret;
+    ly_bool store_only = (options & LYD_NEW_VAL_STORE_ONLY) ? 1 : 0;
+    LY_VALUE_FORMAT format;
+
+    LY_CHECK_ARG_RET(NULL, batch, LY_EINVAL);
+    LY_CHECK_RET(lyd_new_val_get_format(options, &format));
+    LY_CHECK_ARG_RET(batch->ctx, batch->parent || module, name, (format != LY_VALUE_LYB) || value_sizes_bits,
+            LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, batch->ctx, module ? module->ctx : NULL, LY_EINVAL);
+    LY_CHECK_ARG_RET(batch->ctx, !(store_only && (format == LY_VALUE_CANON || format == LY_VALUE_LYB)), LY_EINVAL);
+
+    LY_CHECK_RET(_lyd_new_list3(batch->ctx, batch->parent, module, name, key_values, value_sizes_bits, options, format,
+            &ret));
+    LY_CHECK_ERR_RET(lyd_batch_append(batch, ret), lyd_free_tree(ret), LY_EMEM);
+
+    if (node) {
+        *node = ret;
+    }
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Compare callback for finding duplicate instances in a hash table.
+ *
+ * Implementation of ::lyht_value_equal_cb.
+ */
+static ly_bool
+lyd_batch_dup_val_equal(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *cb_data)
+{
+    /* always find the same instance, never the exact same pointer */
+    return lyd_hash_table_val_equal(val1_p, val2_p, 0, cb_data);
+}
+
+/**
+ * @brief Check that no batch node is a duplicate of another batch node or an existing sibling.
+ *
+ * @param[in] batch Batch with the nodes to check.
+ * @param[in] first First existing sibling, NULL if there are none.
+ * @return LY_SUCCESS if there are no duplicates.
+ * @return LY_EVALID if a duplicate instance was found.
+ * @return LY_ERR on error.
+ */
+static LY_ERR
+lyd_batch_check_dup(const struct lyd_batch *batch, struct lyd_node *first)
+{
+    LY_ERR rc = LY_SUCCESS, r;
+    struct ly_ht *ht;
+    struct lyd_node *iter;
+    uint32_t u, count;
+
+    /* the hash table is never resized, keep the records below the enlarge threshold */
+    count = batch->count;
+    LY_LIST_FOR(first, iter) {
+        ++count;
+    }
+    ht = lyht_new(lyht_get_fixed_size((count * LYHT_HUNDRED_PERCENTAGE) / LYHT_ENLARGE_PERCENTAGE + 1),
+            sizeof(struct lyd_node *), lyd_batch_dup_val_equal, NULL, 0);
+    LY_CHECK_ERR_RET(!ht, LOGMEM(batch->ctx), LY_EMEM);
+
+    /* existing siblings, they are not checked themselves */
+    LY_LIST_FOR(first, iter) {
+        if (iter->schema && !lysc_is_dup_inst_list(iter->schema)) {
+            LY_CHECK_ERR_GOTO(lyht_insert_no_check(ht, &iter, iter->hash, NULL), LOGINT(batch->ctx); rc = LY_EINT,
+                    cleanup);
+        }
+    }
+
+    /* new nodes */
+    for (u = 0; u < batch->count; ++u) {
+        iter = batch->nodes[u];
+        if (!iter->schema || lysc_is_dup_inst_list(iter->schema)) {
+            /* duplicate instances allowed */
+            continue;
+        }
+
+        r = lyht_insert(ht, &iter, iter->hash, NULL);
+        if (r == LY_EEXIST) {
+            LOGVAL(batch->ctx, iter, LY_VCODE_DUP, iter->schema->name);
+            rc = LY_EVALID;
+            goto cleanup;
+        } else if (r) {
+            LOGINT(batch->ctx);
+            rc = LY_EINT;
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    lyht_free(ht, NULL);
+    return rc;
+}
+
+/**
+ * @brief Release the sorting trees of the existing (leaf-)list instances that are outnumbered by the new ones.
+ *
+ * The instances are then sorted and their tree built at once instead of inserting each new instance into the tree.
+ *
+ * @param[in] batch Batch with the new nodes.
+ * @param[in] first First existing sibling.
+ */
+static void
+lyd_batch_free_sort_trees(const struct lyd_batch *batch, const struct lyd_node *first)
+{
+    const struct lysc_node *schema = NULL;
+    struct lyd_node *node, *leader, *iter;
+    uint32_t u, v, count;
+
+    for (u = 0; u < batch->count; ++u) {
+        node = batch->nodes[u];
+        if ((node->schema == schema) || !lyds_is_supported(node) || (node->flags & LYD_EXT)) {
+            /* just processed or not sorted */
+            continue;
+        }
+        schema = node->schema;
+
+        if (lyd_find_sibling_schema(first, schema, &leader) || !lyds_has_tree(leader)) {
+            /* no existing tree */
+            continue;
+        }
+
+        /* count the new instances */
+        count = 0;
+        for (v = u; v < batch->count; ++v) {
+            if (batch->nodes[v]->schema == schema) {
+                ++count;
+            }
+        }
+
+        /* skip at most the same number of existing instances */
+        for (iter = leader; iter && (iter->schema == schema) && count; iter = iter->next) {
+            --count;
+        }
+        if (iter && (iter->schema == schema)) {
+            /* more existing instances, keep inserting into the tree */
+            continue;
+        }
+
+        lyds_free_metadata(leader);
+    }
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_batch_insert(struct lyd_batch *batch, struct lyd_node **first_sibling)
+{
+    struct lyd_node *parent, *first;
+    uint32_t u;
+
+    LY_CHECK_ARG_RET(NULL, batch, batch->parent || first_sibling, LY_EINVAL);
+    LY_CHECK_ARG_RET(batch->ctx, batch->parent || !*first_sibling || !(*first_sibling)->parent, LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, batch->ctx, (!batch->parent && *first_sibling) ? LYD_CTX(*first_sibling) : NULL,
+            LY_EINVAL);
+
+    parent = batch->parent;
+    first = parent ? lyd_child_any(parent) : lyd_first_sibling(*first_sibling);
+
+    if (batch->options & LYD_BATCH_DUP_CHECK) {
+        /* check all the duplicates in one pass, before anything is inserted */
+        LY_CHECK_RET(lyd_batch_check_dup(batch, first));
+    }
+
+    /* size the children hash table for all the nodes */
+    LY_CHECK_RET(lyd_insert_hash_reserve(parent, batch->count));
+
+    /* insert the nodes, (leaf-)list instances without a sorting tree are only appended */
+    lyd_batch_free_sort_trees(batch, first);
+    for (u = 0; u < batch->count; ++u) {
+        lyd_insert_node(parent, &first, batch->nodes[u], LYD_INSERT_NODE_DEFER_SORT);
+    }
+
+    /* sort the instances and build their trees at once */
+    if (batch->count && lyds_sort_siblings(parent ? lyd_node_child_p(parent) : &first)) {
+        /* the nodes are inserted anyway */
+        LOGWRN(batch->ctx, "Data in \"%s\" are not sorted.", LYD_NAME(batch->nodes[0]));
+    }
+
+    if (first_sibling) {
+        *first_sibling = parent ? lyd_child_any(parent) : first;
+    }
+
+    batch->count = 0;
+    lyd_batch_free(batch);
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF void
+lyd_batch_free(struct lyd_batch *batch)
+{
+    uint32_t u;
+
+    if (!batch) {
+        return;
+    }
+
+    for (u = 0; u < batch->count; ++u) {
+        lyd_free_tree(batch->nodes[u]);
+    }
+    free(batch->nodes);
+    free(batch);
+}
+
 /**
  * @brief Create a new term node in the data tree.
  *
@@ -723,7 +1096,7 @@ _lyd_new_term(struct lyd_node *parent, const struct lys_module *module, const ch
     }
     LY_CHECK_ERR_RET(r, LOGERR(ctx, LY_EINVAL, "Term node \"%s\" not found.", name), LY_ENOTFOUND);
 
-    LY_CHECK_RET(lyd_create_term(schema, parent, value, value_size_bits, 0, store_only, NULL, format, NULL,
+    LY_CHECK_RET(lyd_create_term(schema, parent, value, value_size_bits, 0, store_only, 0, NULL, format, NULL,
             LYD_HINT_DATA, NULL, &ret));
     if (ext) {
         ret->flags |= LYD_EXT;
@@ -742,6 +1115,8 @@ LIBYANG_API_DEF LY_ERR
 lyd_new_term(struct lyd_node *parent, const struct lys_module *module, const char *name, const char *value,
         uint32_t options, struct lyd_node **node)
 {
+    LY_CHECK_ARG_RET(parent ? LYD_CTX(parent) : (module ? module->ctx : NULL), !(options & LYD_NEW_VAL_BIN), LY_EINVAL);
+
     return _lyd_new_term(parent, module, name, value, value ? strlen(value) * 8 : 0, options, node);
 }
 
@@ -1166,6 +1541,11 @@ lyd_change_term_val(struct lyd_node *term, struct lyd_value *val, ly_bool use_va
         dflt_change = 0;
     }
 
+    if (val_change || dflt_change) {
+        /* cached digests are no longer valid */
+        lyd_digest_invalidate(term);
+    }
+
     if (!val_change) {
         /* only default flag change or no change */
         rc = dflt_change ? LY_EEXIST : LY_ENOT;
@@ -1198,7 +1578,7 @@ _lyd_change_term(struct lyd_node *term, const void *value, uint64_t value_size_b
 
     /* parse the new value */
     LY_CHECK_RET(lyd_value_store(LYD_CTX(term), term, &val, ((struct lysc_node_leaf *)term->schema)->type, value,
-            value_size_bits, 0, 0, NULL, format, NULL, LYD_HINT_DATA, term->schema, NULL));
+            value_size_bits, 0, 0, 0, NULL, format, NULL, LYD_HINT_DATA, term->schema, NULL));
 
     /* change it */
     return lyd_change_term_val(term, &val, 1, 0);
@@ -1245,6 +1625,7 @@ lyd_change_meta(struct lyd_meta *meta, const char *val_str)
         val = meta->value;
         meta->value = m2->value;
         m2->value = val;
+        lyd_digest_invalidate(meta->parent);
         val_change = 1;
     } else {
         val_change = 0;
@@ -1437,7 +1818,7 @@ lyd_new_path_check_find_lypath(struct ly_path *path, const char *str_path, const
                 LOG_LOCBACK(1);
                 return LY_EINVAL;
             }
-        } else if ((schema->nodetype == LYS_LIST) &&
+        } else if ((schema->nodetype == LYS_LIST) && !path[u].inst &&
                 (!path[u].predicates || (path[u].predicates[0].type != LY_PATH_PREDTYPE_LIST))) {
             if ((u < LY_ARRAY_COUNT(path) - 1) || !(options & LYD_NEW_PATH_OPAQ)) {
                 LOG_LOCSET(schema);
@@ -1579,6 +1960,10 @@ lyd_new_path_create(struct lyd_node *parent, const struct ly_ctx *ctx, struct ly
                 LY_CHECK_GOTO(ret = lyd_create_opaq(ctx, schema->name, strlen(schema->name), NULL, 0,
                         schema->module->name, strlen(schema->module->name), NULL, 0, NULL, LY_VALUE_JSON, NULL,
                         LYD_NODEHINT_LIST, &node), cleanup);
+            } else if (p[path_idx].inst) {
+                /* use the prepared list instance */
+                node = p[path_idx].inst;
+                p[path_idx].inst = NULL;
             } else {
                 /* create standard list instance */
                 LY_CHECK_GOTO(ret = lyd_create_list(schema, p[path_idx].predicates, NULL, store_only, &node), cleanup);
@@ -1619,10 +2004,10 @@ lyd_new_path_create(struct lyd_node *parent, const struct ly_ctx *ctx, struct ly
 
             /* create a leaf-list instance */
             if (val) {
-                LY_CHECK_GOTO(ret = lyd_create_term(schema, nnode, val, strlen(val) * 8, 0, store_only, NULL, format,
+                LY_CHECK_GOTO(ret = lyd_create_term(schema, nnode, val, strlen(val) * 8, 0, store_only, 0, NULL, format,
                         NULL, LYD_HINT_DATA, NULL, &node), cleanup);
             } else {
-                LY_CHECK_GOTO(ret = lyd_create_term(schema, nnode, value, value_size_bits, 0, store_only, NULL, format,
+                LY_CHECK_GOTO(ret = lyd_create_term(schema, nnode, value, value_size_bits, 0, store_only, 0, NULL, format,
                         NULL, LYD_HINT_DATA, NULL, &node), cleanup);
             }
             break;
@@ -1656,7 +2041,7 @@ lyd_new_path_create(struct lyd_node *parent, const struct ly_ctx *ctx, struct ly
             }
 
             /* create a leaf instance */
-            LY_CHECK_GOTO(ret = lyd_create_term(schema, nnode, value, value_size_bits, 0, store_only, NULL, format, NULL,
+            LY_CHECK_GOTO(ret = lyd_create_term(schema, nnode, value, value_size_bits, 0, store_only, 0, NULL, format, NULL,
                     LYD_HINT_DATA, NULL, &node), cleanup);
             break;
         case LYS_ANYDATA:
@@ -1777,7 +2162,7 @@ LIBYANG_API_DEF LY_ERR
 lyd_new_path(struct lyd_node *parent, const struct ly_ctx *ctx, const char *path, const char *value, uint32_t options,
         struct lyd_node **node)
 {
-    LY_CHECK_ARG_RET(ctx, parent || ctx, path, (path[0] == '/') || parent, LY_EINVAL);
+    LY_CHECK_ARG_RET(ctx, parent || ctx, path, (path[0] == '/') || parent, !(options & LYD_NEW_VAL_BIN), LY_EINVAL);
     LY_CHECK_CTX_EQUAL_RET(__func__, parent ? LYD_CTX(parent) : NULL, ctx, LY_EINVAL);
 
     return lyd_new_path_(parent, ctx, path, value, value ? strlen(value) * 8 : 0, 0, options, node, NULL);
@@ -1798,6 +2183,47 @@ lyd_new_path2(struct lyd_node *parent, const struct ly_ctx *ctx, const char *pat
     return lyd_new_path_(parent, ctx, path, value, value_size_bits, any_hints, options, new_parent, new_node);
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_new_compiled_path(struct lyd_node *parent, const struct ly_path *lypath, const char *value, uint32_t options,
+        struct lyd_node **node)
+{
+    LY_ERR ret = LY_SUCCESS;
+    const struct ly_ctx *ctx;
+    struct ly_path *p = NULL;
+    const char *var;
+    char *path = NULL;
+    LY_ARRAY_COUNT_TYPE u;
+
+    LY_CHECK_ARG_RET(NULL, lypath, parent || lypath[0].doc_root, !(options & LYD_NEW_VAL_BIN), LY_EINVAL);
+    ctx = lypath[0].node->module->ctx;
+    LY_CHECK_CTX_EQUAL_RET(__func__, parent ? LYD_CTX(parent) : NULL, ctx, LY_EINVAL);
+
+    if ((var = ly_path_unbound_var(lypath))) {
+        LOGERR(ctx, LY_EINVAL, "Variable \"%s\" of the compiled path not bound.", var);
+        return LY_EINVAL;
+    }
+
+    /* the path may be adjusted and its prepared instances are linked into the data, use a copy */
+    LY_CHECK_GOTO(ret = ly_path_dup(ctx, lypath, &p), cleanup);
+    LY_ARRAY_FOR(lypath, u) {
+        if (lypath[u].inst && (lypath[u].node->nodetype == LYS_LIST)) {
+            LY_CHECK_GOTO(ret = lyd_dup_single(lypath[u].inst, NULL, LYD_DUP_RECURSIVE, &p[u].inst), cleanup);
+        }
+    }
+
+    /* path used only for logging */
+    path = lysc_path(lypath[LY_ARRAY_COUNT(lypath) - 1].node, LYSC_PATH_DATA, NULL, 0);
+    LY_CHECK_ERR_GOTO(!path, LOGMEM(ctx); ret = LY_EMEM, cleanup);
+
+    /* create nodes */
+    ret = lyd_new_path_create(parent, ctx, p, path, value, value ? strlen(value) * 8 : 0, 0, options, node, NULL);
+
+cleanup:
+    ly_path_free(p);
+    free(path);
+    return ret;
+}
+
 LY_ERR
 lyd_new_implicit(struct lyd_node *parent, struct lyd_node **first, const struct lysc_node *sparent,
         const struct lys_module *mod, struct ly_set *node_when, struct ly_set *node_types, struct ly_set *ext_val,
@@ -1883,7 +2309,7 @@ lyd_new_implicit(struct lyd_node *parent, struct lyd_node **first, const struct
                     lyd_find_sibling_val(*first, snode, NULL, 0, NULL)) {
                 /* create default leaf */
                 LY_CHECK_RET(lyd_create_term(snode, parent, ((struct lysc_node_leaf *)snode)->dflt.str,
-                        strlen(((struct lysc_node_leaf *)snode)->dflt.str) * 8, 1, 1, NULL, LY_VALUE_SCHEMA_RESOLVED,
+                        strlen(((struct lysc_node_leaf *)snode)->dflt.str) * 8, 1, 1, 0, NULL, LY_VALUE_SCHEMA_RESOLVED,
                         ((struct lysc_node_leaf *)snode)->dflt.prefixes, LYD_HINT_SCHEMA, &incomplete, &node));
                 if (incomplete && node_types) {
                     /* remember to resolve type */
@@ -1912,7 +2338,7 @@ lyd_new_implicit(struct lyd_node *parent, struct lyd_node **first, const struct
                 /* create all default leaf-lists */
                 dflts = ((struct lysc_node_leaflist *)snode)->dflts;
                 LY_ARRAY_FOR(dflts, u) {
-                    LY_CHECK_RET(lyd_create_term(snode, parent, dflts[u].str, strlen(dflts[u].str) * 8, 1, 1, NULL,
+                    LY_CHECK_RET(lyd_create_term(snode, parent, dflts[u].str, strlen(dflts[u].str) * 8, 1, 1, 0, NULL,
                             LY_VALUE_SCHEMA_RESOLVED, dflts[u].prefixes, LYD_HINT_SCHEMA, &incomplete, &node));
                     if (incomplete && node_types) {
                         /* remember to resolve type */
@@ -86,6 +86,8 @@ struct rb_node {
     struct rb_node *left;       /**< left node with a lower value */
     struct rb_node *right;      /**< left node with a greater value */
     struct lyd_node *dnode;     /**< assigned libyang data node */
+    uint8_t *skey;              /**< sort key of a list instance comparable by memcmp(), NULL if not available */
+    uint32_t skey_len;          /**< length of the sort key */
     uint8_t color;              /**< color for red-black node */
 };
 
@@ -102,6 +104,8 @@ struct rb_node {
 #define RBN_RIGHT(NODE) ((NODE)->right)
 #define RBN_PARENT(NODE) ((NODE)->parent)
 #define RBN_DNODE(NODE) ((NODE)->dnode)
+#define RBN_SKEY(NODE) ((NODE)->skey)
+#define RBN_SKEY_LEN(NODE) ((NODE)->skey_len)
 #define RBN_COLOR(NODE) ((NODE)->color)
 /** @} rbngetters */
 
@@ -124,8 +128,10 @@ struct rb_node {
  * @param[in] DNODE New dnode value for @p rbn.
  */
 #define RBN_RESET(RBN, DNODE) \
+    free(RBN_SKEY(RBN)); \
     *(RBN) = (const struct rb_node){0}; \
-    RBN_DNODE(RBN) = DNODE;
+    RBN_DNODE(RBN) = DNODE; \
+    rb_set_sort_key(RBN);
 
 /**
  * @brief Get red-black root from metadata.
@@ -269,6 +275,196 @@ rb_compare_lists(const struct lyd_node *n1, const struct lyd_node *n2)
     return cmp;
 }
 
+/**
+ * @brief Encode a list key value so that the encodings compare by memcmp() the same way as the values are sorted.
+ *
+ * Only the values of built-in types whose sort callback can be expressed this way are encoded. Integers
+ * are stored big-endian with the sign bit flipped and strings including their terminating zero, so every
+ * encoding is prefix-free and the encodings of all the keys can be concatenated.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] val Key value to encode.
+ * @param[out] buf Buffer to write the encoding into, NULL to only learn its length.
+ * @return Length of the encoding, 0 if @p val cannot be encoded.
+ */
+static uint32_t
+rb_sort_key_value(const struct ly_ctx *ctx, const struct lyd_value *val, uint8_t *buf)
+{
+    struct lyplg_type *plg;
+    const char *str;
+    uint64_t num;
+    uint32_t len, i;
+
+    plg = LYSC_GET_TYPE_PLG(val->realtype->plugin_ref);
+    if (!plg || !plg->id) {
+        return 0;
+    }
+
+    if (!strcmp(plg->id, "ly2 integers")) {
+        switch (val->realtype->basetype) {
+        case LY_TYPE_UINT8:
+            len = 1;
+            num = val->uint8;
+            break;
+        case LY_TYPE_UINT16:
+            len = 2;
+            num = val->uint16;
+            break;
+        case LY_TYPE_UINT32:
+            len = 4;
+            num = val->uint32;
+            break;
+        case LY_TYPE_UINT64:
+            len = 8;
+            num = val->uint64;
+            break;
+        case LY_TYPE_INT8:
+            len = 1;
+            num = (uint8_t)val->int8 ^ 0x80;
+            break;
+        case LY_TYPE_INT16:
+            len = 2;
+            num = (uint16_t)val->int16 ^ 0x8000;
+            break;
+        case LY_TYPE_INT32:
+            len = 4;
+            num = (uint32_t)val->int32 ^ 0x80000000;
+            break;
+        case LY_TYPE_INT64:
+            len = 8;
+            num = (uint64_t)val->int64 ^ 0x8000000000000000ULL;
+            break;
+        default:
+            return 0;
+        }
+    } else if (!strcmp(plg->id, "ly2 boolean")) {
+        len = 1;
+        num = val->boolean ? 1 : 0;
+    } else if (!strcmp(plg->id, "ly2 enumeration")) {
+        len = 4;
+        num = (uint32_t)val->enum_item->value ^ 0x80000000;
+    } else if (!strcmp(plg->id, "ly2 string")) {
+        str = lyd_value_get_canonical(ctx, val);
+        if (!str) {
+            return 0;
+        }
+        len = strlen(str) + 1;
+        if (buf) {
+            memcpy(buf, str, len);
+        }
+        return len;
+    } else {
+        return 0;
+    }
+
+    if (buf) {
+        for (i = 0; i < len; ++i) {
+            buf[i] = (uint8_t)(num >> (8 * (len - 1 - i)));
+        }
+    }
+    return len;
+}
+
+/**
+ * @brief Encode all the keys of a list instance into its sort key.
+ *
+ * @param[in] node List instance.
+ * @param[out] buf Buffer to write the sort key into, NULL to only learn its length.
+ * @return Length of the sort key, 0 if it cannot be created.
+ */
+static uint32_t
+rb_sort_key(const struct lyd_node *node, uint8_t *buf)
+{
+    const struct lyd_node *key;
+    uint32_t len = 0, r;
+
+    /* lyd_child() is not called due to optimization */
+    for (key = ((const struct lyd_node_inner *)node)->child;
+            key && key->schema && (key->schema->flags & LYS_KEY);
+            key = key->next) {
+        r = rb_sort_key_value(LYD_CTX(node), &((struct lyd_node_term *)key)->value, buf ? buf + len : NULL);
+        if (!r) {
+            return 0;
+        }
+        len += r;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Create the sort key of the red-black node of a list instance, if possible.
+ *
+ * Failing to create the sort key is not an error, the keys are compared by their type plugins then.
+ *
+ * @param[in] rbn Red-black node without a sort key.
+ */
+static void
+rb_set_sort_key(struct rb_node *rbn)
+{
+    uint32_t len;
+
+    if (!RBN_DNODE(rbn) || (RBN_DNODE(rbn)->schema->nodetype != LYS_LIST)) {
+        return;
+    }
+
+    len = rb_sort_key(RBN_DNODE(rbn), NULL);
+    if (!len) {
+        return;
+    }
+
+    RBN_SKEY(rbn) = malloc(len);
+    if (!RBN_SKEY(rbn)) {
+        return;
+    }
+    rb_sort_key(RBN_DNODE(rbn), RBN_SKEY(rbn));
+    RBN_SKEY_LEN(rbn) = len;
+}
+
+/**
+ * @brief Compare two sort keys.
+ *
+ * @param[in] skey1 First sort key.
+ * @param[in] len1 Length of @p skey1.
+ * @param[in] skey2 Second sort key.
+ * @param[in] len2 Length of @p skey2.
+ * @return Negative number if skey1 < skey2,
+ * @return Zero if skey1 == skey2,
+ * @return Positive number if skey1 > skey2.
+ */
+static int
+rb_compare_sort_keys(const uint8_t *skey1, uint32_t len1, const uint8_t *skey2, uint32_t len2)
+{
+    int cmp;
+
+    cmp = memcmp(skey1, skey2, len1 < len2 ? len1 : len2);
+    if (cmp || (len1 == len2)) {
+        return cmp;
+    }
+    return len1 < len2 ? -1 : 1;
+}
+
+/**
+ * @brief Compare red-black nodes from the same Red-black tree, use their sort keys if available.
+ *
+ * @param[in] rbn1 First red-black node.
+ * @param[in] rbn2 Second red-black node.
+ * @return Negative number if val1 < val2,
+ * @return Zero if val1 == val2,
+ * @return Positive number if val1 > val2.
+ */
+static int
+rb_compare_nodes(const struct rb_node *rbn1, const struct rb_node *rbn2)
+{
+    if (RBN_SKEY(rbn1) && RBN_SKEY(rbn2)) {
+        return rb_compare_sort_keys(RBN_SKEY(rbn1), RBN_SKEY_LEN(rbn1), RBN_SKEY(rbn2), RBN_SKEY_LEN(rbn2));
+    } else if (RBN_DNODE(rbn1)->schema->nodetype == LYS_LEAFLIST) {
+        return rb_compare_leaflists(RBN_DNODE(rbn1), RBN_DNODE(rbn2));
+    } else {
+        return rb_compare_lists(RBN_DNODE(rbn1), RBN_DNODE(rbn2));
+    }
+}
+
 /**
  * @brief Release unlinked red-black node.
  *
@@ -277,6 +473,9 @@ rb_compare_lists(const struct lyd_node *n1, const struct lyd_node *n2)
 static void
 rb_free_node(struct rb_node **rbn)
 {
+    if (*rbn) {
+        free(RBN_SKEY(*rbn));
+    }
     free(*rbn);
     *rbn = NULL;
 }
@@ -673,20 +872,12 @@ rb_insert_node(struct rb_node **rbt, struct rb_node *rbn, ly_bool *max_p)
     struct rb_node *parent = NULL;
     int comp = 0;
 
-    int (*rb_compare)(const struct lyd_node *n1, const struct lyd_node *n2);
-
-    if (RBN_DNODE(*rbt)->schema->nodetype == LYS_LEAFLIST) {
-        rb_compare = rb_compare_leaflists;
-    } else {
-        rb_compare = rb_compare_lists;
-    }
-
     max = 1;
     tmp = *rbt;
     while (tmp != NULL) {
         parent = tmp;
 
-        comp = rb_compare(RBN_DNODE(tmp), RBN_DNODE(rbn));
+        comp = rb_compare_nodes(tmp, rbn);
         if (comp > 0) {
             tmp = RBN_LEFT(tmp);
             max = 0;
@@ -774,6 +965,25 @@ rb_next(struct rb_node *rbn)
     return rbn;
 }
 
+uint64_t
+lyds_tree_mem_usage(struct rb_node *rbt)
+{
+    struct rb_node *rbn;
+    uint64_t size = 0;
+
+    if (!rbt) {
+        return 0;
+    }
+
+    /* traverse in order, the rb_iter_* functions destroy the tree */
+    for (rbn = rbt; RBN_LEFT(rbn); rbn = RBN_LEFT(rbn)) {}
+    for ( ; rbn; rbn = rb_next(rbn)) {
+        size += sizeof *rbn + RBN_SKEY_LEN(rbn);
+    }
+
+    return size;
+}
+
 /**
  * @brief Find @p target value in the Red-black tree.
  *
@@ -784,58 +994,67 @@ rb_next(struct rb_node *rbn)
 static struct rb_node *
 rb_find(struct rb_node *rbt, struct lyd_node *target)
 {
-    struct rb_node *iter, *pivot;
+    struct rb_node *iter, *pivot, trg = {0};
+    uint8_t skey_buf[64];
+    uint32_t len = 0;
     int comp;
 
-    int (*rb_compare)(const struct lyd_node *n1, const struct lyd_node *n2);
-
     if (RBN_DNODE(rbt) == target) {
         return rbt;
     }
 
-    if (RBN_DNODE(rbt)->schema->nodetype == LYS_LEAFLIST) {
-        rb_compare = rb_compare_leaflists;
-    } else {
-        rb_compare = rb_compare_lists;
+    /* prepare the searched node with the sort key of @p target */
+    RBN_DNODE(&trg) = target;
+    if (RBN_SKEY(rbt) && (len = rb_sort_key(target, NULL))) {
+        RBN_SKEY(&trg) = (len > sizeof skey_buf) ? malloc(len) : skey_buf;
+        if (RBN_SKEY(&trg)) {
+            rb_sort_key(target, RBN_SKEY(&trg));
+            RBN_SKEY_LEN(&trg) = len;
+        }
     }
 
     iter = rbt;
     do {
-        comp = rb_compare(RBN_DNODE(iter), target);
+        comp = rb_compare_nodes(iter, &trg);
         if (comp > 0) {
             iter = RBN_LEFT(iter);
         } else if (comp < 0) {
             iter = RBN_RIGHT(iter);
         } else if (RBN_DNODE(iter) == target) {
-            return iter;
+            break;
         } else {
             /* sequential search in nodes having the same value */
             pivot = iter;
 
             /* search in predecessors */
             for (iter = rb_prev(pivot); iter; iter = rb_prev(iter)) {
-                if (rb_compare(RBN_DNODE(iter), target) != 0) {
+                if (rb_compare_nodes(iter, &trg) != 0) {
                     break;
                 } else if (RBN_DNODE(iter) == target) {
-                    return iter;
+                    goto cleanup;
                 }
             }
 
             /* search in successors */
             for (iter = rb_next(pivot); iter; iter = rb_next(iter)) {
-                if (rb_compare(RBN_DNODE(iter), target) != 0) {
+                if (rb_compare_nodes(iter, &trg) != 0) {
                     break;
                 } else if (RBN_DNODE(iter) == target) {
-                    return iter;
+                    goto cleanup;
                 }
             }
 
             /* node not found */
+            iter = NULL;
             break;
         }
     } while (iter != NULL);
 
-    return NULL;
+cleanup:
+    if (RBN_SKEY(&trg) != skey_buf) {
+        free(RBN_SKEY(&trg));
+    }
+    return iter;
 }
 
 LY_ERR
@@ -844,6 +1063,7 @@ lyds_create_node(struct lyd_node *node, struct rb_node **rbn)
     *rbn = calloc(1, sizeof **rbn);
     LY_CHECK_ERR_RET(!(*rbn), LOGERR(LYD_CTX(node), LY_EMEM, "Allocation of red-black node failed."), LY_EMEM);
     RBN_DNODE(*rbn) = node;
+    rb_set_sort_key(*rbn);
 
     return LY_SUCCESS;
 }
@@ -1074,32 +1294,216 @@ lyds_additionally_create_rb_nodes(struct lyd_node **first_sibling, struct lyd_no
 }
 
 /**
- * @brief Additionally create the Red-black tree for the sorted nodes.
+ * @brief Sort red-black nodes by merge sort, the order of equal nodes is kept.
+ *
+ * @param[in,out] nodes Array of red-black nodes to sort.
+ * @param[in] buf Auxiliary array, must be able to hold at least half of @p count items.
+ * @param[in] count Number of items in @p nodes.
+ */
+static void
+lyds_sort_nodes(struct rb_node **nodes, struct rb_node **buf, uint32_t count)
+{
+    uint32_t half, i, j, k;
+
+    if (count < 2) {
+        return;
+    }
+
+    half = count / 2;
+    lyds_sort_nodes(nodes, buf, half);
+    lyds_sort_nodes(nodes + half, buf, count - half);
+    if (rb_compare_nodes(nodes[half - 1], nodes[half]) <= 0) {
+        /* both halves are already in order */
+        return;
+    }
+
+    /* merge, the first half is moved aside so that the result can be written in place */
+    memcpy(buf, nodes, half * sizeof *buf);
+    i = 0;
+    j = half;
+    k = 0;
+    while ((i < half) && (j < count)) {
+        if (rb_compare_nodes(buf[i], nodes[j]) <= 0) {
+            nodes[k++] = buf[i++];
+        } else {
+            nodes[k++] = nodes[j++];
+        }
+    }
+    while (i < half) {
+        nodes[k++] = buf[i++];
+    }
+}
+
+/**
+ * @brief Relink consecutive sibling data nodes in a new order.
+ *
+ * @param[in,out] first_sibling First sibling node, is updated if the first node changes.
+ * @param[in] before Sibling preceding all the nodes, NULL if they begin the siblings.
+ * @param[in] after Sibling following all the nodes, NULL if they end the siblings.
+ * @param[in] last Last sibling, used only if the nodes begin but do not end the siblings.
+ * @param[in] nodes Array of all the consecutive data nodes in their new order.
+ * @param[in] count Number of items in @p nodes.
+ */
+static void
+lyds_relink_nodes(struct lyd_node **first_sibling, struct lyd_node *before, struct lyd_node *after,
+        struct lyd_node *last, struct lyd_node **nodes, uint32_t count)
+{
+    struct lyd_node *parent, *first;
+    uint32_t i;
+
+    parent = nodes[0]->parent;
+    for (i = 0; i + 1 < count; ++i) {
+        nodes[i]->next = nodes[i + 1];
+        nodes[i + 1]->prev = nodes[i];
+    }
+
+    nodes[count - 1]->next = after;
+    if (after) {
+        after->prev = nodes[count - 1];
+    }
+
+    if (before) {
+        before->next = nodes[0];
+        nodes[0]->prev = before;
+    } else {
+        /* the first sibling changed */
+        nodes[0]->prev = after ? last : nodes[count - 1];
+        if (parent) {
+            ((struct lyd_node_inner *)parent)->child = nodes[0];
+        }
+        if (first_sibling) {
+            *first_sibling = nodes[0];
+        }
+    }
+
+    if (!after && before) {
+        /* the last sibling changed, update the "last" pointer from the first node */
+        first = (first_sibling && *first_sibling) ? *first_sibling : lyd_first_sibling(before);
+        first->prev = nodes[count - 1];
+    }
+
+    lyd_digest_invalidate(parent);
+    lyd_desc_index_invalidate(parent);
+}
+
+/**
+ * @brief Build a balanced Red-black tree from sorted red-black nodes.
+ *
+ * All the levels of the built tree are complete except the last one, whose nodes are colored red.
+ *
+ * @param[in] rbns Array of sorted red-black nodes.
+ * @param[in] count Number of items in @p rbns.
+ * @param[in] parent Parent of the built subtree.
+ * @param[in] depth Depth of the built subtree root.
+ * @param[in] red_depth Depth of the incomplete last level.
+ * @return Root of the built subtree, NULL if @p count is 0.
+ */
+static struct rb_node *
+rb_build_r(struct rb_node **rbns, uint32_t count, struct rb_node *parent, uint32_t depth, uint32_t red_depth)
+{
+    struct rb_node *rbn;
+    uint32_t mid;
+
+    if (!count) {
+        return NULL;
+    }
+
+    mid = count / 2;
+    rbn = rbns[mid];
+    RBN_PARENT(rbn) = parent;
+    RBN_COLOR(rbn) = (depth == red_depth) ? RB_RED : RB_BLACK;
+    RBN_LEFT(rbn) = rb_build_r(rbns, mid, rbn, depth + 1, red_depth);
+    RBN_RIGHT(rbn) = rb_build_r(rbns + mid + 1, count - mid - 1, rbn, depth + 1, red_depth);
+
+    return rbn;
+}
+
+/**
+ * @brief Additionally create the Red-black tree for all the (leaf-)list instances at once.
+ *
+ * The instances are sorted first unless they already are, then the tree is built from them in linear time.
  *
  * @param[in,out] first_sibling First sibling node.
  * @param[in,out] leader First instance of the (leaf-)list.
  * @param[in] root_meta From the @p leader, metadata in which is the root of the Red-black tree.
- * @param[in] rbt From the @p root_meta, root of the Red-black tree.
+ * @param[out] rbt From the @p root_meta, root of the Red-black tree.
  * @return LY_ERR value.
  */
 static LY_ERR
 lyds_additionally_create_rb_tree(struct lyd_node **first_sibling, struct lyd_node **leader,
         struct lyd_meta *root_meta, struct rb_node **rbt)
 {
-    LY_ERR ret;
-    struct rb_node *rbn;
+    LY_ERR ret = LY_SUCCESS;
+    struct lyd_node *iter, *before, *after, *last, **nodes = NULL;
+    struct rb_node **rbns = NULL, **buf = NULL;
+    uint32_t count = 0, i, red_depth;
+    ly_bool sorted = 1;
+
+    /* count the instances */
+    for (iter = *leader; iter && (iter->schema == (*leader)->schema); iter = iter->next) {
+        ++count;
+    }
+    after = iter;
+
+    /* create all the red-black nodes and learn whether they are sorted */
+    rbns = malloc(count * sizeof *rbns);
+    LY_CHECK_ERR_GOTO(!rbns, LOGMEM(LYD_CTX(*leader)); ret = LY_EMEM, cleanup);
+    for (i = 0, iter = *leader; i < count; ++i, iter = iter->next) {
+        ret = lyds_create_node(iter, &rbns[i]);
+        if (ret) {
+            while (i) {
+                rb_free_node(&rbns[--i]);
+            }
+            goto cleanup;
+        }
+        if (i && sorted && (rb_compare_nodes(rbns[i - 1], rbns[i]) > 0)) {
+            sorted = 0;
+        }
+    }
 
-    /* let's begin with the leader */
-    ret = lyds_create_node(*leader, &rbn);
-    LY_CHECK_RET(ret);
-    *rbt = rbn;
+    if (!sorted) {
+        nodes = malloc(count * sizeof *nodes);
+        buf = malloc((count / 2) * sizeof *buf);
+        if (!nodes || !buf) {
+            LOGMEM(LYD_CTX(*leader));
+            for (i = 0; i < count; ++i) {
+                rb_free_node(&rbns[i]);
+            }
+            ret = LY_EMEM;
+            goto cleanup;
+        }
 
-    /* continue with the rest of the nodes */
-    ret = lyds_additionally_create_rb_nodes(first_sibling, leader, root_meta, rbt, (*leader)->next);
+        /* sort and relink the data nodes */
+        before = (*leader)->prev->next ? (*leader)->prev : NULL;
+        last = (*leader)->prev;
+        lyds_sort_nodes(rbns, buf, count);
+        for (i = 0; i < count; ++i) {
+            nodes[i] = RBN_DNODE(rbns[i]);
+        }
+        lyds_relink_nodes(first_sibling, before, after, last, nodes, count);
+        if (nodes[0] != *leader) {
+            /* the parent HT references the first instance */
+            lyd_hash_first_inst_replace(*leader, nodes[0]);
+
+            /* move metadata from the old leader to the new one */
+            lyds_move_meta(nodes[0], root_meta);
+            *leader = nodes[0];
+        }
+    }
+
+    /* nodes at the depth of the only incomplete level are red */
+    for (red_depth = 0, i = count + 1; i > 1; i >>= 1) {
+        ++red_depth;
+    }
+    *rbt = rb_build_r(rbns, count, NULL, 0, red_depth);
 
     /* store pointer to the root */
     RBT_SET(root_meta, *rbt);
 
+cleanup:
+    free(nodes);
+    free(buf);
+    free(rbns);
     return ret;
 }
 
@@ -1328,6 +1732,46 @@ cleanup:
     return LY_SUCCESS;
 }
 
+ly_bool
+lyds_has_tree(const struct lyd_node *leader)
+{
+    return lyds_get_rb_tree(leader, NULL) ? 1 : 0;
+}
+
+LY_ERR
+lyds_sort_siblings(struct lyd_node **first_sibling)
+{
+    struct lyd_node *iter, *leader;
+    struct lyd_meta *root_meta;
+    struct rb_node *rbt;
+
+    assert(first_sibling);
+
+    for (iter = *first_sibling; iter; iter = iter->next) {
+        if (!lyds_is_supported(iter) || (iter->flags & LYD_EXT) || !iter->next || (iter->next->schema != iter->schema)) {
+            /* not a (leaf-)list with more instances */
+            continue;
+        }
+
+        leader = iter;
+        rbt = lyds_get_rb_tree(leader, &root_meta);
+        if (!rbt) {
+            if (!root_meta) {
+                LY_CHECK_RET(lyds_create_metadata(leader, &root_meta));
+            }
+            LY_CHECK_RET(lyds_additionally_create_rb_tree(first_sibling, &leader, root_meta, &rbt));
+        }
+
+        /* skip the rest of the instances */
+        iter = leader;
+        while (iter->next && (iter->next->schema == leader->schema)) {
+            iter = iter->next;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
 void
 lyds_unlink(struct lyd_node **leader, struct lyd_node *node)
 {
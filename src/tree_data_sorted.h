@@ -114,6 +114,25 @@ LY_ERR lyds_insert(struct lyd_node **first_sibling, struct lyd_node **leader, st
 LY_ERR lyds_insert2(struct lyd_node *parent, struct lyd_node **first_sibling, struct lyd_node **leader,
         struct lyd_node *node, struct lyds_pool *pool);
 
+/**
+ * @brief Check whether the BST of the (leaf-)list instances was already created.
+ *
+ * @param[in] leader First instance of the (leaf-)list.
+ * @return 1 if @p leader has the BST.
+ */
+ly_bool lyds_has_tree(const struct lyd_node *leader);
+
+/**
+ * @brief Sort all the (leaf-)list instances without BST among the siblings and create their BST at once.
+ *
+ * Meant to be called once all the siblings were inserted, for example by a parser. The BST is built in linear
+ * time for instances that are already sorted, otherwise the instances are sorted first.
+ *
+ * @param[in,out] first_sibling First sibling node, is updated.
+ * @return LY_ERR value.
+ */
+LY_ERR lyds_sort_siblings(struct lyd_node **first_sibling);
+
 /**
  * @brief Unlink (remove) the specified data node from BST.
  *
@@ -201,4 +220,12 @@ void lyds_free_metadata(struct lyd_node *node);
  */
 void lyds_free_tree(struct rb_node *rbt);
 
+/**
+ * @brief Get the memory used by all BST nodes.
+ *
+ * @param[in] rbt Root of the Red-black tree.
+ * @return Memory used by the tree in bytes.
+ */
+uint64_t lyds_tree_mem_usage(struct rb_node *rbt);
+
 #endif /* _LYDS_TREE_H_ */
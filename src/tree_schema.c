@@ -31,6 +31,7 @@
 #include "compat.h"
 #include "context.h"
 #include "dict.h"
+#include "hash_table_internal.h"
 #include "in.h"
 #include "in_internal.h"
 #include "log.h"
@@ -537,6 +538,227 @@ lys_find_child_node_ext(const struct ly_ctx *ctx, const struct lys_module *mod,
     return LY_ENOT;
 }
 
+/**
+ * @brief Get hash of a schema child index record.
+ *
+ * @param[in] rec Record to hash.
+ * @return Record hash.
+ */
+static uint32_t
+lysc_child_rec_hash(const struct lysc_child_rec *rec)
+{
+    uint32_t hash;
+
+    hash = lyht_hash_multi(0, (const char *)&rec->parent, sizeof rec->parent);
+    hash = lyht_hash_multi(hash, (const char *)&rec->mod, sizeof rec->mod);
+    hash = lyht_hash_multi(hash, rec->name, rec->name_len);
+    hash = lyht_hash_multi(hash, (const char *)&rec->output, sizeof rec->output);
+    return lyht_hash_multi(hash, NULL, 0);
+}
+
+/**
+ * @brief Index all the children of a schema parent or top-level nodes of a module.
+ *
+ * @param[in] ht Schema child hash table to fill.
+ * @param[in] parent Schema parent, NULL for top-level nodes.
+ * @param[in] mod Module of the top-level nodes.
+ * @param[in] options ORed [lys_getnext options](@ref sgetnextflags) to use.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lysc_child_index_add(struct ly_ht *ht, const struct lysc_node *parent, const struct lys_module *mod, uint32_t options)
+{
+    LY_ERR r;
+    const struct lysc_node *node = NULL;
+    struct lysc_child_rec rec = {0};
+
+    rec.parent = parent ? (const void *)parent : (const void *)mod;
+    rec.output = (options & LYS_GETNEXT_OUTPUT) ? 1 : 0;
+    while ((node = lys_getnext(node, parent, parent ? NULL : mod->compiled, options))) {
+        rec.mod = node->module;
+        rec.name = node->name;
+        rec.name_len = strlen(node->name);
+        rec.node = node;
+
+        /* keep the first node that lys_getnext() returns */
+        r = lyht_insert(ht, &rec, lysc_child_rec_hash(&rec), NULL);
+        if (r && (r != LY_EEXIST)) {
+            return r;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Remove all the children of a schema parent or top-level nodes of a module from the index.
+ *
+ * @param[in] ht Schema child hash table to remove from.
+ * @param[in] parent Schema parent, NULL for top-level nodes.
+ * @param[in] mod Module of the top-level nodes.
+ * @param[in] options ORed [lys_getnext options](@ref sgetnextflags) to use.
+ */
+static void
+lysc_child_index_del(struct ly_ht *ht, const struct lysc_node *parent, const struct lys_module *mod, uint32_t options)
+{
+    const struct lysc_node *node = NULL;
+    struct lysc_child_rec rec = {0};
+    uint32_t hash;
+
+    rec.parent = parent ? (const void *)parent : (const void *)mod;
+    rec.output = (options & LYS_GETNEXT_OUTPUT) ? 1 : 0;
+    while ((node = lys_getnext(node, parent, parent ? NULL : mod->compiled, options))) {
+        rec.mod = node->module;
+        rec.name = node->name;
+        rec.name_len = strlen(node->name);
+
+        /* the node may not have been indexed or its record was already removed */
+        hash = lysc_child_rec_hash(&rec);
+        if (!lyht_find(ht, &rec, hash, NULL)) {
+            lyht_remove(ht, &rec, hash);
+        }
+    }
+}
+
+/**
+ * @brief DFS callback for indexing children of a schema node.
+ */
+static LY_ERR
+lysc_child_index_add_dfs_cb(struct lysc_node *node, void *data, ly_bool *UNUSED(dfs_continue))
+{
+    struct ly_ht *ht = data;
+
+    if (node->nodetype & (LYS_LEAF | LYS_LEAFLIST | LYS_ANYDATA)) {
+        /* no children */
+        return LY_SUCCESS;
+    }
+
+    LY_CHECK_RET(lysc_child_index_add(ht, node, NULL, 0));
+    if (node->nodetype & (LYS_RPC | LYS_ACTION)) {
+        LY_CHECK_RET(lysc_child_index_add(ht, node, NULL, LYS_GETNEXT_OUTPUT));
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief DFS callback for removing children of a schema node from the index.
+ */
+static LY_ERR
+lysc_child_index_del_dfs_cb(struct lysc_node *node, void *data, ly_bool *UNUSED(dfs_continue))
+{
+    struct ly_ht *ht = data;
+
+    if (node->nodetype & (LYS_LEAF | LYS_LEAFLIST | LYS_ANYDATA)) {
+        /* no children */
+        return LY_SUCCESS;
+    }
+
+    lysc_child_index_del(ht, node, NULL, 0);
+    if (node->nodetype & (LYS_RPC | LYS_ACTION)) {
+        lysc_child_index_del(ht, node, NULL, LYS_GETNEXT_OUTPUT);
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Index the top-level nodes and children of all the nodes of a compiled module.
+ *
+ * @param[in] ht Schema child hash table to fill.
+ * @param[in] mod Compiled module to index.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lysc_child_index_module(struct ly_ht *ht, const struct lys_module *mod)
+{
+    /* top-level nodes */
+    LY_CHECK_RET(lysc_child_index_add(ht, NULL, mod, 0));
+
+    /* children of all the nodes */
+    return lysc_module_dfs_full(mod, lysc_child_index_add_dfs_cb, ht);
+}
+
+LY_ERR
+lysc_child_index_build(const struct ly_ctx *ctx, struct ly_ht *ht)
+{
+    const struct lys_module *mod;
+    uint32_t i;
+
+    if (ctx->parent_ctx) {
+        /* ht is in the shared data of the parent context that may outlive the nodes of this context */
+        return LY_SUCCESS;
+    }
+    LY_CHECK_ERR_RET(!ht, LOGMEM(ctx), LY_EMEM);
+
+    for (i = 0; i < ctx->modules.count; ++i) {
+        mod = ctx->modules.objs[i];
+        if (!mod->implemented || !mod->compiled) {
+            continue;
+        }
+
+        LY_CHECK_RET(lysc_child_index_module(ht, mod));
+    }
+
+    return LY_SUCCESS;
+}
+
+LY_ERR
+lysc_child_index_add_module(const struct lys_module *mod)
+{
+    if (mod->ctx->parent_ctx) {
+        /* not indexed, see lysc_child_index_build() */
+        return LY_SUCCESS;
+    }
+
+    return lysc_child_index_module(ly_ctx_shared_data_get(mod->ctx)->schema_child_ht, mod);
+}
+
+void
+lysc_child_index_remove_module(const struct lys_module *mod)
+{
+    struct ly_ht *ht;
+
+    if (mod->ctx->parent_ctx || !mod->compiled) {
+        /* nothing indexed */
+        return;
+    }
+
+    ht = ly_ctx_shared_data_get(mod->ctx)->schema_child_ht;
+    lysc_child_index_del(ht, NULL, mod, 0);
+    lysc_module_dfs_full(mod, lysc_child_index_del_dfs_cb, ht);
+}
+
+const struct lysc_node *
+lysc_child_index_find(const struct lysc_node *parent, const struct lys_module *mod, const char *name,
+        uint32_t name_len, uint32_t options)
+{
+    struct ly_ctx_shared_data *ctx_data;
+    struct lysc_child_rec rec = {0}, *found;
+
+    if (options & ~LYS_GETNEXT_OUTPUT) {
+        /* options changing the returned nodes are not indexed */
+        return NULL;
+    }
+
+    ctx_data = ly_ctx_shared_data_get(mod->ctx);
+    if (!ctx_data->schema_child_ht || !ctx_data->schema_child_ht->used) {
+        /* not built */
+        return NULL;
+    }
+
+    rec.parent = parent ? (const void *)parent : (const void *)mod;
+    rec.mod = mod;
+    rec.name = name;
+    rec.name_len = name_len;
+    rec.output = (parent && (parent->nodetype & (LYS_RPC | LYS_ACTION)) && (options & LYS_GETNEXT_OUTPUT)) ? 1 : 0;
+    if (lyht_find(ctx_data->schema_child_ht, &rec, lysc_child_rec_hash(&rec), (void **)&found)) {
+        return NULL;
+    }
+
+    return found->node;
+}
+
 LY_ERR
 lys_find_child_node(const struct ly_ctx *ctx, const struct lysc_node *parent, const struct lys_module *mod,
         const char *prefix, uint32_t prefix_len, LY_VALUE_FORMAT format, void *prefix_data, const char *name,
@@ -565,6 +787,12 @@ lys_find_child_node(const struct ly_ctx *ctx, const struct lysc_node *parent, co
 
     /* look for a standard schema node */
     if (mod && mod->implemented) {
+        /* try the child index first, it cannot tell there is no such child because it may not be built */
+        if ((node = lysc_child_index_find(parent, mod, name, name_len, options))) {
+            *snode = node;
+            return LY_SUCCESS;
+        }
+
         while ((node = lys_getnext(node, parent, mod->compiled, options))) {
             /* check module */
             if (node->module != mod) {
@@ -1289,6 +1517,7 @@ lys_unres_glob_revert(struct ly_ctx *ctx, struct lys_glob_unres *unres)
         /* make the module correctly non-implemented again */
         mod->implemented = 0;
         lys_precompile_augments_deviations_revert(ctx, mod);
+        lysc_child_index_remove_module(mod);
         lysc_module_free(ctx, mod->compiled);
         mod->compiled = NULL;
 
@@ -1301,6 +1530,7 @@ lys_unres_glob_revert(struct ly_ctx *ctx, struct lys_glob_unres *unres)
 
         /* remove the module from the context */
         ly_set_rm(&ctx->modules, mod, NULL);
+        ly_ctx_mod_ht_remove(ctx, mod);
 
         /* remove it also from dep sets */
         for (j = 0; j < unres->dep_sets.count; ++j) {
@@ -2749,6 +2979,7 @@ lys_parse_in(struct ly_ctx *ctx, struct ly_in *in, LYS_INFORMAT format, const st
     /* add into context */
     rc = ly_set_add(&ctx->modules, mod, 1, NULL);
     LY_CHECK_GOTO(rc, cleanup);
+    LY_CHECK_GOTO(rc = ly_ctx_mod_ht_add(ctx, mod), cleanup);
 
     /* resolve includes and all imports */
     LY_CHECK_GOTO(rc = lysp_resolve_import_include(pctx, mod->parsed, new_mods), cleanup);
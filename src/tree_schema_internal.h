@@ -513,6 +513,61 @@ LY_ERR lys_find_child_node(const struct ly_ctx *ctx, const struct lysc_node *par
         const char *prefix, uint32_t prefix_len, LY_VALUE_FORMAT format, void *prefix_data, const char *name,
         uint32_t name_len, uint32_t options, const struct lysc_node **snode, struct lysc_ext_instance **ext);
 
+/**
+ * @brief Record of the compiled schema child index, see ::ly_ctx_shared_data.schema_child_ht.
+ */
+struct lysc_child_rec {
+    const void *parent;             /**< schema parent node or the module of top-level nodes */
+    const struct lys_module *mod;   /**< module of the child */
+    const char *name;               /**< child name, not necessarily 0-terminated when searching */
+    uint32_t name_len;              /**< length of @p name */
+    ly_bool output;                 /**< whether the child is from the output of an RPC/action parent */
+    const struct lysc_node *node;   /**< indexed child */
+};
+
+/**
+ * @brief Index all the children of compiled schema nodes and top-level nodes of implemented modules.
+ *
+ * Children are indexed the same way ::lys_getnext() returns them with no options (and with ::LYS_GETNEXT_OUTPUT
+ * for RPC/action parents) so choices and cases are transparent.
+ *
+ * @param[in] ctx Context with the compiled modules to index.
+ * @param[in] ht Schema child hash table to fill.
+ * @return LY_ERR value.
+ */
+LY_ERR lysc_child_index_build(const struct ly_ctx *ctx, struct ly_ht *ht);
+
+/**
+ * @brief Index all the children of compiled schema nodes and top-level nodes of a newly compiled module.
+ *
+ * @param[in] mod Compiled implemented module to index.
+ * @return LY_ERR value.
+ */
+LY_ERR lysc_child_index_add_module(const struct lys_module *mod);
+
+/**
+ * @brief Remove all the records of a compiled module from the schema child index.
+ *
+ * Must be called before the compiled module is freed.
+ *
+ * @param[in] mod Module whose compiled nodes to remove, may not be compiled.
+ */
+void lysc_child_index_remove_module(const struct lys_module *mod);
+
+/**
+ * @brief Find a schema child in the compiled schema child index.
+ *
+ * @param[in] parent Parent of the node, NULL for top-level nodes.
+ * @param[in] mod Implemented module of the node.
+ * @param[in] name Node name.
+ * @param[in] name_len Length of @p name.
+ * @param[in] options ORed [lys_getnext options](@ref sgetnextflags), only ::LYS_GETNEXT_OUTPUT is supported.
+ * @return Found schema node;
+ * @return NULL if not found or the index cannot be used, ::lys_getnext() must then be used.
+ */
+const struct lysc_node *lysc_child_index_find(const struct lysc_node *parent, const struct lys_module *mod,
+        const char *name, uint32_t name_len, uint32_t options);
+
 /**
  * @brief When the module comes from YIN format, the argument name is unknown because of missing extension definition
  * (it might come from import modules which is not yet parsed at that time). Therefore, all the attributes are stored
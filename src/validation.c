@@ -261,6 +261,7 @@ cleanup:
  * @param[in] node Node whose relevant when conditions will be evaluated.
  * @param[in] schema Schema node of @p node. It may not be possible to use directly if @p node is opaque.
  * @param[in] xpath_opts Additional XPath options to use.
+ * @param[in] memo Optional XPath memo to use.
  * @param[out] disabled First when that evaluated false, if any.
  * @return LY_SUCCESS on success.
  * @return LY_EINCOMPLETE if a referenced node does not have its when evaluated.
@@ -268,7 +269,7 @@ cleanup:
  */
 static LY_ERR
 lyd_validate_node_when(const struct lyd_node *tree, const struct lyd_node *node, const struct lysc_node *schema,
-        uint32_t xpath_opts, const struct lysc_when **disabled)
+        uint32_t xpath_opts, struct lyxp_memo *memo, const struct lysc_when **disabled)
 {
     LY_ERR r;
     const struct lyd_node *ctx_node;
@@ -297,7 +298,7 @@ lyd_validate_node_when(const struct lyd_node *tree, const struct lyd_node *node,
             /* evaluate when */
             memset(&xp_set, 0, sizeof xp_set);
             r = lyxp_eval(LYD_CTX(node), when->cond, schema->module, LY_VALUE_SCHEMA_RESOLVED, when->prefixes,
-                    ctx_node, ctx_node, tree, NULL, &xp_set, LYXP_SCHEMA | xpath_opts);
+                    ctx_node, ctx_node, tree, NULL, memo, &xp_set, LYXP_SCHEMA | xpath_opts);
             lyxp_set_cast(&xp_set, LYXP_SET_BOOLEAN);
 
             /* return error or LY_EINCOMPLETE for dependant unresolved when */
@@ -409,6 +410,7 @@ lyd_validate_unres_when(struct lyd_node **tree, const struct lys_module *mod, st
     uint32_t i, count;
     const struct lysc_when *disabled;
     struct lyd_node *node = NULL;
+    struct lyxp_memo memo = {0};
 
     if (!node_when->count) {
         return LY_SUCCESS;
@@ -420,7 +422,7 @@ lyd_validate_unres_when(struct lyd_node **tree, const struct lys_module *mod, st
         node = node_when->dnodes[i];
 
         /* evaluate all when expressions that affect this node's existence */
-        r = lyd_validate_node_when(*tree, node, node->schema, xpath_options, &disabled);
+        r = lyd_validate_node_when(*tree, node, node->schema, xpath_options, &memo, &disabled);
         if (!r) {
             if (disabled) {
                 /* when false */
@@ -428,6 +430,7 @@ lyd_validate_unres_when(struct lyd_node **tree, const struct lys_module *mod, st
                     /* autodelete */
                     count = node_when->count;
                     lyd_validate_autodel_node_del(tree, node, mod, 1, NULL, node_when, node_types, diff);
+                    lyxp_memo_clear(&memo);
                     if (count > node_when->count) {
                         /* nested nodes removed, we lost the index */
                         ly_set_contains(node_when, node, &i);
@@ -455,6 +458,7 @@ lyd_validate_unres_when(struct lyd_node **tree, const struct lys_module *mod, st
     } while (i);
 
 cleanup:
+    lyxp_memo_clear(&memo);
     return rc;
 }
 
@@ -1052,7 +1056,7 @@ lyd_validate_dummy_when(const struct lyd_node *first, const struct lyd_node *par
     }
 
     /* evaluate all when */
-    rc = lyd_validate_node_when(tree, dummy, snode, xp_opts, disabled);
+    rc = lyd_validate_node_when(tree, dummy, snode, xp_opts, NULL, disabled);
     if (rc == LY_EINCOMPLETE) {
         /* all other when must be resolved by now */
         LOGINT(snode->module->ctx);
@@ -1627,10 +1631,12 @@ lyd_validate_obsolete(const struct lyd_node *node)
  * @param[in] val_opts Validation options.
  * @param[in] int_opts Internal parser options.
  * @param[in] xpath_opts Additional XPath options to use.
+ * @param[in] memo XPath memo to use.
  * @return LY_ERR value.
  */
 static LY_ERR
-lyd_validate_must(const struct lyd_node *node, uint32_t val_opts, uint32_t int_opts, uint32_t xpath_opts)
+lyd_validate_must(const struct lyd_node *node, uint32_t val_opts, uint32_t int_opts, uint32_t xpath_opts,
+        struct lyxp_memo *memo)
 {
     LY_ERR r, rc = LY_SUCCESS;
     struct lyxp_set xp_set;
@@ -1669,7 +1675,7 @@ lyd_validate_must(const struct lyd_node *node, uint32_t val_opts, uint32_t int_o
 
         /* evaluate must */
         r = lyxp_eval(LYD_CTX(node), musts[u].cond, node->schema->module, LY_VALUE_SCHEMA_RESOLVED,
-                musts[u].prefixes, node, node, tree, NULL, &xp_set, LYXP_SCHEMA | xpath_opts);
+                musts[u].prefixes, node, node, tree, NULL, memo, &xp_set, LYXP_SCHEMA | xpath_opts);
         if (r == LY_EINCOMPLETE) {
             LOGERR(LYD_CTX(node), LY_EINCOMPLETE,
                     "Must \"%s\" depends on a node with a when condition, which has not been evaluated.", musts[u].cond->expr);
@@ -1718,12 +1724,13 @@ cleanup:
  * @param[in] int_opts Internal parser options.
  * @param[in] must_xp_opts Additional XPath options to use for evaluating "must".
  * @param[in,out] getnext_ht Getnext HT to use.
+ * @param[in,out] memo XPath memo to use for evaluating "must".
  * @return LY_ERR value.
  */
 static LY_ERR
 lyd_validate_final_r(struct lyd_node *first, const struct lyd_node *parent, const struct lysc_node *sparent,
         const struct lys_module *mod, const struct lysc_ext_instance *ext, uint32_t val_opts, uint32_t int_opts,
-        uint32_t must_xp_opts, struct ly_ht *getnext_ht)
+        uint32_t must_xp_opts, struct ly_ht *getnext_ht, struct lyxp_memo *memo)
 {
     LY_ERR r, rc = LY_SUCCESS;
     const char *innode;
@@ -1772,7 +1779,7 @@ lyd_validate_final_r(struct lyd_node *first, const struct lyd_node *parent, cons
         lyd_validate_obsolete(node);
 
         /* node's musts */
-        if ((r = lyd_validate_must(node, val_opts, int_opts & ~LYD_INTOPT_SKIP_SIBLINGS, must_xp_opts))) {
+        if ((r = lyd_validate_must(node, val_opts, int_opts & ~LYD_INTOPT_SKIP_SIBLINGS, must_xp_opts, memo))) {
             goto next_iter;
         }
 
@@ -1799,7 +1806,7 @@ next_iter:
 
         /* validate all children recursively */
         r = lyd_validate_final_r(lyd_child(node), node, node->schema, NULL, ext, val_opts,
-                int_opts & ~LYD_INTOPT_SKIP_SIBLINGS, must_xp_opts, getnext_ht);
+                int_opts & ~LYD_INTOPT_SKIP_SIBLINGS, must_xp_opts, getnext_ht, memo);
         LY_VAL_ERR_GOTO(r, rc = r, val_opts, cleanup);
 
         /* set default for containers */
@@ -2026,6 +2033,7 @@ lyd_validate(struct lyd_node **tree, const struct lys_module *module, const stru
     struct lyd_node *first, *next, **first2, *iter;
     const struct lys_module *mod;
     struct ly_set node_types = {0}, meta_types = {0}, node_when = {0}, ext_val = {0}, mod_set = {0}, getnext_ht_set = {0};
+    struct lyxp_memo memo = {0};
     uint32_t i = 0, impl_opts;
     struct ly_ht *getnext_ht = NULL;
 
@@ -2129,12 +2137,13 @@ lyd_validate(struct lyd_node **tree, const struct lys_module *module, const stru
             first = *tree;
             lyd_first_module_sibling(&first, mod);
 
-            r = lyd_validate_final_r(first, NULL, NULL, mod, NULL, val_opts, 0, 0, getnext_ht);
+            r = lyd_validate_final_r(first, NULL, NULL, mod, NULL, val_opts, 0, 0, getnext_ht, &memo);
             LY_VAL_ERR_GOTO(r, rc = r, val_opts, cleanup);
         }
     }
 
 cleanup:
+    lyxp_memo_clear(&memo);
     ly_set_erase(&node_when, NULL);
     ly_set_erase(&node_types, NULL);
     ly_set_erase(&meta_types, NULL);
@@ -2151,6 +2160,7 @@ lyd_validate_ext(struct lyd_node **subtree, const struct lysc_ext_instance *ext,
     LY_ERR r, rc = LY_SUCCESS;
     struct ly_set subtree_skip = {0}, node_types = {0}, meta_types = {0}, node_when = {0}, ext_val = {0};
     struct ly_ht *getnext_ht = NULL;
+    struct lyxp_memo memo = {0};
     struct lyd_node *iter;
 
     LY_CHECK_ARG_RET(NULL, subtree, !*subtree || (*subtree)->flags & LYD_EXT, ext, LY_EINVAL);
@@ -2183,12 +2193,14 @@ lyd_validate_ext(struct lyd_node **subtree, const struct lysc_ext_instance *ext,
                 continue;
             }
 
-            r = lyd_validate_final_r(iter, NULL, NULL, NULL, ext, val_opts, LYD_INTOPT_SKIP_SIBLINGS, 0, getnext_ht);
+            r = lyd_validate_final_r(iter, NULL, NULL, NULL, ext, val_opts, LYD_INTOPT_SKIP_SIBLINGS, 0, getnext_ht,
+                    &memo);
             LY_VAL_ERR_GOTO(r, rc = r, val_opts, cleanup);
         }
     }
 
 cleanup:
+    lyxp_memo_clear(&memo);
     ly_set_erase(&subtree_skip, NULL);
     ly_set_erase(&node_when, NULL);
     ly_set_erase(&node_types, NULL);
@@ -2233,6 +2245,7 @@ lyd_validate_module_final(struct lyd_node *tree, const struct lys_module *module
     const struct lys_module *mod;
     uint32_t i = 0;
     struct ly_ht *getnext_ht = NULL;
+    struct lyxp_memo memo = {0};
 
     LY_CHECK_ARG_RET(NULL, module, !(val_opts & (LYD_VALIDATE_PRESENT | LYD_VALIDATE_NOT_FINAL)), LY_EINVAL);
     LY_CHECK_CTX_EQUAL_RET(__func__, tree ? LYD_CTX(tree) : NULL, module->ctx, LY_EINVAL);
@@ -2246,10 +2259,11 @@ lyd_validate_module_final(struct lyd_node *tree, const struct lys_module *module
     LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
 
     /* perform final validation that assumes the data tree is final */
-    r = lyd_validate_final_r(first, NULL, NULL, mod, NULL, val_opts, 0, 0, getnext_ht);
+    r = lyd_validate_final_r(first, NULL, NULL, mod, NULL, val_opts, 0, 0, getnext_ht, &memo);
     LY_VAL_ERR_GOTO(r, rc = r, val_opts, cleanup);
 
 cleanup:
+    lyxp_memo_clear(&memo);
     lyd_val_getnext_ht_free(getnext_ht);
     return rc;
 }
@@ -2343,6 +2357,7 @@ _lyd_validate_op(struct lyd_node *op_tree, struct lyd_node *op_node, const struc
     struct lyd_node *tree_sibling, *tree_parent, *op_subtree, *op_parent, *op_sibling_before, *op_sibling_after, *child;
     struct ly_set node_types = {0}, meta_types = {0}, node_when = {0}, ext_val = {0};
     struct ly_ht *getnext_ht = NULL;
+    struct lyxp_memo memo = {0};
 
     assert(op_tree && op_node);
     assert((node_when_p && node_types_p && meta_types_p && ext_val_p) ||
@@ -2406,11 +2421,11 @@ _lyd_validate_op(struct lyd_node *op_tree, struct lyd_node *op_node, const struc
 
     /* perform final validation of the operation/notification */
     lyd_validate_obsolete(op_node);
-    LY_CHECK_GOTO(rc = lyd_validate_must(op_node, 0, int_opts, LYXP_IGNORE_WHEN), cleanup);
+    LY_CHECK_GOTO(rc = lyd_validate_must(op_node, 0, int_opts, LYXP_IGNORE_WHEN, &memo), cleanup);
 
     /* final validation of all the descendants */
     rc = lyd_validate_final_r(lyd_child(op_node), op_node, op_node->schema, NULL, NULL, 0, int_opts, LYXP_IGNORE_WHEN,
-            getnext_ht);
+            getnext_ht, &memo);
     LY_CHECK_GOTO(rc, cleanup);
 
 cleanup:
@@ -2426,6 +2441,7 @@ cleanup:
         lyd_insert_node(op_parent, NULL, op_subtree, LYD_INSERT_NODE_DEFAULT);
     }
 
+    lyxp_memo_clear(&memo);
     ly_set_erase(&node_when, NULL);
     ly_set_erase(&node_types, NULL);
     ly_set_erase(&meta_types, NULL);
@@ -44,6 +44,43 @@
         ly_in_skip(c->in, 1);             \
     }
 
+/* character class bits of lyxml_char_class */
+#define LYXML_CC_TEXT 0x01 /**< plain ASCII text character that never ends or escapes a value */
+#define LYXML_CC_NAME 0x02 /**< ASCII name character */
+
+/**
+ * @brief Character classes of single bytes, used to skip runs of plain ASCII characters without UTF-8 decoding.
+ *
+ * Control characters, all the non-ASCII bytes, and the characters '"', '&', ''', '<' have no class and are always
+ * processed one by one.
+ */
+static const uint8_t lyxml_char_class[256] = {
+    /* 0x00 - 0x1f: control characters */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* SP ! " # $ % & ' ( ) * + , - . / */
+    1, 1, 0, 1, 1, 1, 0, 0, 1, 1, 1, 1, 1, 3, 3, 1,
+    /* 0 - 9 : ; < = > ? */
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 0, 1, 1, 1,
+    /* @ A - O */
+    1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    /* P - Z [ \ ] ^ _ */
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 1, 1, 3,
+    /* ` a - o */
+    1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    /* p - z { | } ~ DEL */
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 1, 1, 1,
+    /* 0x80 - 0xff: non-ASCII bytes */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
 static LY_ERR lyxml_next_attr_content(struct lyxml_ctx *xmlctx, const char **value, uint32_t *value_len, ly_bool *ws_only,
         ly_bool *dynamic);
 
@@ -127,6 +164,16 @@ lyxml_parse_identifier(struct lyxml_ctx *xmlctx, const char **start, const char
         /* move only successfully parsed bytes */
         ly_in_skip(xmlctx->in, parsed);
 
+        /* skip a run of ASCII name characters at once */
+        parsed = 0;
+        while (lyxml_char_class[(uint8_t)in[parsed]] & LYXML_CC_NAME) {
+            ++parsed;
+        }
+        if (parsed) {
+            ly_in_skip(xmlctx->in, parsed);
+            in += parsed;
+        }
+
         rc = ly_getutf8(&in, &c, &parsed);
         LY_CHECK_ERR_RET(rc, LOGVAL(xmlctx->ctx, NULL, LY_VCODE_INCHAR, in[0]), LY_EVALID);
     } while (is_xmlqnamechar(c));
@@ -597,6 +644,28 @@ lyxml_parse_value(struct lyxml_ctx *xmlctx, char endchar, char **value, uint32_t
             len += offset;
             in += offset;
             goto success;
+        } else if (lyxml_char_class[(uint8_t)in[offset]] & LYXML_CC_TEXT) {
+            /* a run of plain ASCII characters, no need to decode them */
+            p = &in[offset];
+            do {
+                ++p;
+            } while (lyxml_char_class[(uint8_t)*p] & LYXML_CC_TEXT);
+
+            if (ws) {
+                /* the only plain whitespace character is space */
+                for (in_aux = &in[offset]; in_aux < p; ++in_aux) {
+                    if (*in_aux != ' ') {
+                        ws = 0;
+                        break;
+                    }
+                }
+            }
+
+            if ((uint64_t)(p - in) > UINT32_MAX) {
+                LOGVAL(ctx, NULL, LYVE_SYNTAX, "XML value too long.");
+                goto error;
+            }
+            offset = p - in;
         } else {
             if (!is_xmlws(in[offset])) {
                 /* non WS */
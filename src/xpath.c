@@ -914,6 +914,9 @@ set_init(struct lyxp_set *new, const struct lyxp_set *set)
     new->format = set->format;
     new->prefix_data = set->prefix_data;
     new->vars = set->vars;
+    new->memo = set->memo;
+    new->count_tok_idx = set->count_tok_idx;
+    new->count_exist = set->count_exist;
 }
 
 /**
@@ -3966,6 +3969,12 @@ xpath_count(struct lyxp_set **args, uint32_t UNUSED(arg_count), struct lyxp_set
         return rc;
     }
 
+    if (args[0]->count_tok_idx && (args[0]->type == LYXP_SET_NUMBER)) {
+        /* the nodes were only counted */
+        set_fill_number(set, args[0]->val.num);
+        return LY_SUCCESS;
+    }
+
     if (args[0]->type != LYXP_SET_NODE_SET) {
         LOGVAL_DXPATH(set, LY_VCODE_XP_INARGTYPE, 1, print_set_type(args[0]), "count(node-set)");
         return LY_EVALID;
@@ -6297,9 +6306,12 @@ cleanup:
 /**
  * @brief Move context @p set to child nodes using hashes. Result is LYXP_SET_NODE_SET. Context position aware.
  *
+ * Instances of a list or leaf-list without @p predicates are all found at once because data instances of a schema
+ * node are always stored next to each other.
+ *
  * @param[in,out] set Set to use.
  * @param[in] scnode Matching node schema.
- * @param[in] predicates If @p scnode is ::LYS_LIST or ::LYS_LEAFLIST, the predicates specifying a single instance.
+ * @param[in] predicates If @p scnode is ::LYS_LIST or ::LYS_LEAFLIST, optional predicates specifying a single instance.
  * @param[in] options XPath options.
  * @return LY_ERR (LY_EINCOMPLETE on unresolved when)
  */
@@ -6312,8 +6324,12 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
     const struct lyd_node *siblings;
     struct lyxp_set result;
     struct lyd_node *sub, *inst = NULL;
+    ly_bool all_inst;
+
+    assert(scnode);
 
-    assert(scnode && (!(scnode->nodetype & (LYS_LIST | LYS_LEAFLIST)) || predicates));
+    /* all the instances are matching */
+    all_inst = (scnode->nodetype & (LYS_LIST | LYS_LEAFLIST)) && !predicates;
 
     /* init result set */
     set_init(&result, set);
@@ -6339,11 +6355,13 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
     }
 
     /* create specific data instance if needed */
-    if (scnode->nodetype == LYS_LIST) {
+    if (all_inst) {
+        /* no instance */
+    } else if (scnode->nodetype == LYS_LIST) {
         LY_CHECK_GOTO(ret = lyd_create_list(scnode, predicates, NULL, 1, &inst), cleanup);
     } else if (scnode->nodetype == LYS_LEAFLIST) {
         LY_CHECK_GOTO(ret = lyd_create_term(scnode, NULL, predicates[0].value, strlen(predicates[0].value) * 8, 1, 1,
-                NULL, LY_VALUE_CANON, NULL, LYD_HINT_DATA, NULL, &inst), cleanup);
+                0, NULL, LY_VALUE_CANON, NULL, LYD_HINT_DATA, NULL, &inst), cleanup);
     }
 
     for (i = 0; i < set->used; ++i) {
@@ -6359,9 +6377,11 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
             siblings = lyd_child(set->val.nodes[i].node);
         }
 
-        /* find the node using hashes */
+        /* find the (first) node using hashes */
         if (inst) {
             r = lyd_find_sibling_first(siblings, inst, &sub);
+        } else if (all_inst) {
+            r = lyd_find_sibling_schema(siblings, scnode, &sub);
         } else {
             r = lyd_find_sibling_val(siblings, scnode, NULL, 0, &sub);
         }
@@ -6371,15 +6391,26 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
         }
         LY_CHECK_ERR_GOTO(r && (r != LY_ENOTFOUND), ret = r, cleanup);
 
-        /* when check */
-        if (!(options & LYXP_IGNORE_WHEN) && sub && lysc_has_when(sub->schema) && !(sub->flags & LYD_WHEN_TRUE)) {
-            ret = LY_EINCOMPLETE;
-            goto cleanup;
-        }
+        while (sub) {
+            /* when check */
+            if (!(options & LYXP_IGNORE_WHEN) && lysc_has_when(sub->schema) && !(sub->flags & LYD_WHEN_TRUE)) {
+                ret = LY_EINCOMPLETE;
+                goto cleanup;
+            }
 
-        if (sub) {
             /* pos filled later */
             set_insert_node(&result, sub, 0, LYXP_NODE_ELEM, result.used);
+
+            if (!all_inst) {
+                break;
+            }
+
+            /* following instances */
+            if (sub->schema) {
+                sub = (sub->next && (sub->next->schema == scnode)) ? sub->next : NULL;
+            } else if (lyd_find_sibling_opaq_next(sub->next, scnode->name, &sub)) {
+                sub = NULL;
+            }
         }
     }
 
@@ -6395,6 +6426,118 @@ cleanup:
     return ret;
 }
 
+/**
+ * @brief Count child nodes of context @p set without moving to them. Result is LYXP_SET_NUMBER with the count
+ * or LYXP_SET_BOOLEAN whether there are any.
+ *
+ * The nodes are searched for as in ::moveto_node_hash_child() if @p scnode is set, as in ::moveto_node() otherwise.
+ *
+ * @param[in,out] set Set to use.
+ * @param[in] scnode Matching node schema, NULL if not known.
+ * @param[in] moveto_mod Matching node module, NULL for no prefix. Only if @p scnode is not set.
+ * @param[in] ncname Matching node name, NULL for any. Only if @p scnode is not set.
+ * @param[in] ncname_len Length of @p ncname.
+ * @param[in] exist Whether to only learn whether there are any nodes, stopping on the first one.
+ * @param[in] options XPath options.
+ * @return LY_ERR (LY_EINCOMPLETE on unresolved when)
+ */
+static LY_ERR
+moveto_node_count_child(struct lyxp_set *set, const struct lysc_node *scnode, const struct lys_module *moveto_mod,
+        const char *ncname, uint32_t ncname_len, ly_bool exist, uint32_t options)
+{
+    LY_ERR r;
+    uint32_t i, count = 0;
+    const struct lyd_node *siblings, *iter;
+    enum lyxp_node_type iter_type;
+    struct lyd_node *sub;
+    ly_bool all_inst;
+
+    if (set->type != LYXP_SET_NODE_SET) {
+        LOGVAL_DXPATH(set, LY_VCODE_XP_INOP_1, "path operator", print_set_type(set));
+        return LY_EVALID;
+    }
+
+    /* context check for all the nodes since we have the schema node */
+    if (scnode && (set->root_type == LYXP_NODE_ROOT_CONFIG) && (scnode->flags & LYS_CONFIG_R)) {
+        goto finish;
+    } else if (scnode && set->context_op && (scnode->nodetype & (LYS_RPC | LYS_ACTION | LYS_NOTIF)) &&
+            (scnode != set->context_op)) {
+        goto finish;
+    }
+    all_inst = scnode && (scnode->nodetype & (LYS_LIST | LYS_LEAFLIST));
+
+    for (i = 0; (i < set->used) && !(exist && count); ++i) {
+        if (!scnode) {
+            /* iterate over all the children */
+            iter = NULL;
+            iter_type = 0;
+            while (!moveto_axis_node_next(&iter, &iter_type, set->val.nodes[i].node, set->val.nodes[i].type,
+                    LYXP_AXIS_CHILD, set)) {
+                r = moveto_node_check(iter, iter_type, set, ncname, ncname_len, moveto_mod, options);
+                if (r == LY_EINCOMPLETE) {
+                    return r;
+                } else if (r) {
+                    continue;
+                }
+
+                ++count;
+                if (exist) {
+                    break;
+                }
+            }
+            continue;
+        }
+
+        siblings = NULL;
+        if ((set->val.nodes[i].type == LYXP_NODE_ROOT_CONFIG) || (set->val.nodes[i].type == LYXP_NODE_ROOT)) {
+            /* search in all the trees */
+            siblings = set->tree;
+        } else if (set->val.nodes[i].type == LYXP_NODE_ELEM) {
+            /* search in children */
+            siblings = lyd_child(set->val.nodes[i].node);
+        }
+
+        /* find the first node using hashes */
+        if (all_inst) {
+            r = lyd_find_sibling_schema(siblings, scnode, &sub);
+        } else {
+            r = lyd_find_sibling_val(siblings, scnode, NULL, 0, &sub);
+        }
+        if (r == LY_ENOTFOUND) {
+            /* may still be an opaque node */
+            r = lyd_find_sibling_opaq_next(siblings, scnode->name, &sub);
+        }
+        LY_CHECK_RET(r && (r != LY_ENOTFOUND), r);
+
+        while (sub) {
+            /* when check */
+            if (!(options & LYXP_IGNORE_WHEN) && lysc_has_when(sub->schema) && !(sub->flags & LYD_WHEN_TRUE)) {
+                return LY_EINCOMPLETE;
+            }
+
+            ++count;
+            if (exist || !all_inst) {
+                break;
+            }
+
+            /* following instances */
+            if (sub->schema) {
+                sub = (sub->next && (sub->next->schema == scnode)) ? sub->next : NULL;
+            } else if (lyd_find_sibling_opaq_next(sub->next, scnode->name, &sub)) {
+                sub = NULL;
+            }
+        }
+    }
+
+finish:
+    if (exist) {
+        set_fill_boolean(set, count ? 1 : 0);
+    } else {
+        set_fill_number(set, count);
+    }
+    return LY_SUCCESS;
+}
+
 /**
  * @brief Check @p node as a part of schema NameTest processing.
  *
@@ -6940,6 +7083,50 @@ moveto_scnode(struct lyxp_set *set, const struct lys_module *moveto_mod, const c
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Add a child node and all its descendants matching a name test into a set using the descendant index.
+ *
+ * @param[in] set Set to read general context from.
+ * @param[in] start Child node to add with its descendants.
+ * @param[in] moveto_mod Matching node module, NULL for no prefix.
+ * @param[in] ncname Matching node name.
+ * @param[in] ncname_len Length of @p ncname.
+ * @param[in] options XPath options.
+ * @param[in,out] ret_set Set to add the matching nodes to, in the document order.
+ * @return LY_ERR (LY_EINCOMPLETE on unresolved when)
+ */
+static LY_ERR
+moveto_node_alldesc_child_index(const struct lyxp_set *set, const struct lyd_node *start,
+        const struct lys_module *moveto_mod, const char *ncname, uint32_t ncname_len, uint32_t options,
+        struct lyxp_set *ret_set)
+{
+    struct ly_set *desc;
+    uint32_t i;
+    LY_ERR rc;
+
+    /* the start node itself */
+    rc = moveto_node_check(start, LYXP_NODE_ELEM, set, ncname, ncname_len, moveto_mod, options);
+    if (!rc) {
+        set_insert_node(ret_set, start, 0, LYXP_NODE_ELEM, ret_set->used);
+    } else if (rc == LY_EINCOMPLETE) {
+        return rc;
+    }
+
+    /* all its descendants with the name */
+    LY_CHECK_RET(lyd_desc_index_get(start, ncname, ncname_len, &desc));
+    for (i = 0; desc && (i < desc->count); ++i) {
+        rc = moveto_node_check(desc->dnodes[i], LYXP_NODE_ELEM, set, ncname, ncname_len, moveto_mod, options);
+        if (!rc) {
+            set_insert_node(ret_set, desc->dnodes[i], 0, LYXP_NODE_ELEM, ret_set->used);
+        } else if (rc == LY_EINCOMPLETE) {
+            break;
+        }
+    }
+    ly_set_free(desc, NULL);
+
+    return (rc == LY_EINCOMPLETE) ? rc : LY_SUCCESS;
+}
+
 /**
  * @brief Move context @p set to a child node and all its descendants. Result is LYXP_SET_NODE_SET.
  *        Context position aware.
@@ -6958,6 +7145,7 @@ moveto_node_alldesc_child(struct lyxp_set *set, const struct lys_module *moveto_
     uint32_t i;
     const struct lyd_node *next, *elem, *start;
     struct lyxp_set ret_set;
+    ly_bool use_index;
     LY_ERR rc;
 
     if (options & LYXP_SKIP_EXPR) {
@@ -6969,12 +7157,29 @@ moveto_node_alldesc_child(struct lyxp_set *set, const struct lys_module *moveto_
         return LY_EVALID;
     }
 
+    /* the index can be used for disjoint subtrees of a single context node if no subtrees are skipped */
+    use_index = ncname && (ly_ctx_get_options(set->ctx) & LY_CTX_XPATH_DESC_INDEX) && (set->used == 1) &&
+            ((set->val.nodes[0].type == LYXP_NODE_ELEM) || (set->val.nodes[0].type == LYXP_NODE_ROOT)) &&
+            (set->root_type != LYXP_NODE_ROOT_CONFIG) && !set->context_op;
+
     /* replace the original nodes (and throws away all text and meta nodes, root is replaced by a child) */
     rc = xpath_pi_node(set, LYXP_AXIS_CHILD, options);
     LY_CHECK_RET(rc);
 
-    /* this loop traverses all the nodes in the set and adds/keeps only those that match qname */
     set_init(&ret_set, set);
+    if (use_index) {
+        for (i = 0; i < set->used; ++i) {
+            rc = moveto_node_alldesc_child_index(set, set->val.nodes[i].node, moveto_mod, ncname, ncname_len, options,
+                    &ret_set);
+            if (rc) {
+                lyxp_set_free_content(&ret_set);
+                return rc;
+            }
+        }
+        goto finish;
+    }
+
+    /* this loop traverses all the nodes in the set and adds/keeps only those that match qname */
     for (i = 0; i < set->used; ++i) {
 
         /* TREE DFS */
@@ -7020,6 +7225,7 @@ skip_children:
         }
     }
 
+finish:
     /* make the temporary set the current one */
     ret_set.ctx_pos = set->ctx_pos;
     ret_set.ctx_size = set->ctx_size;
@@ -7362,6 +7568,172 @@ moveto_attr_alldesc(struct lyxp_set *set, const struct lys_module *mod, const ch
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Callback for comparing string values of node-set items.
+ * Implementation of ::lyht_value_equal_cb.
+ */
+static ly_bool
+set_comp_hash_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    return strcmp(*(char **)val1_p, *(char **)val2_p) ? 0 : 1;
+}
+
+/**
+ * @brief Check whether a node-set comparison can be evaluated using a hash table of @p set2 values.
+ *
+ * All the @p set2 items must be elements canonizing the compared values the same way so that every
+ * @p set1 value needs to be canonized only once.
+ *
+ * @param[in] set1 First set.
+ * @param[in] set2 Second set.
+ * @param[in] op Comparison operator.
+ * @return Whether the hash table can be used.
+ */
+static ly_bool
+set_comp_hash_usable(const struct lyxp_set *set1, const struct lyxp_set *set2, const char *op)
+{
+    const struct lysc_node *schema, *prev_schema = NULL;
+    uint32_t i;
+
+    if ((op[0] != '=') && (op[0] != '!')) {
+        /* only (in)equality */
+        return 0;
+    } else if ((set1->type != LYXP_SET_NODE_SET) || (set2->type != LYXP_SET_NODE_SET)) {
+        return 0;
+    } else if (!set1->used || !set2->used) {
+        return 0;
+    }
+
+    for (i = 0; i < set2->used; ++i) {
+        if (set2->val.nodes[i].type != LYXP_NODE_ELEM) {
+            return 0;
+        }
+
+        /* schema node used for canonization, if any */
+        schema = set2->val.nodes[i].node->schema;
+        if (schema && !(schema->nodetype & LYD_NODE_TERM)) {
+            schema = NULL;
+        }
+
+        if (i && (schema != prev_schema)) {
+            return 0;
+        }
+        prev_schema = schema;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Free a hash table of node-set string values.
+ *
+ * @param[in] ht Hash table to free.
+ */
+static void
+set_comp_hash_free(struct ly_ht *ht)
+{
+    struct ly_ht_rec *rec;
+    uint32_t hlist_idx, rec_idx;
+
+    if (!ht) {
+        return;
+    }
+
+    LYHT_ITER_ALL_RECS(ht, hlist_idx, rec_idx, rec) {
+        free(*(char **)rec->val);
+    }
+    lyht_free(ht, NULL);
+}
+
+/**
+ * @brief Create a hash table of all the distinct string values of a node-set.
+ *
+ * @param[in] set Node-set, ::set_comp_hash_usable() must be true for it as the second set.
+ * @param[out] ht Created hash table.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+set_comp_hash_build(const struct lyxp_set *set, struct ly_ht **ht)
+{
+    LY_ERR rc = LY_SUCCESS, r;
+    struct lyxp_set tmp = {0};
+    uint32_t i;
+    char *str;
+
+    *ht = lyht_new(lyht_get_fixed_size(set->used), sizeof str, set_comp_hash_equal_cb, NULL, 1);
+    LY_CHECK_ERR_RET(!*ht, LOGMEM(set->ctx), LY_EMEM);
+
+    for (i = 0; i < set->used; ++i) {
+        LY_CHECK_GOTO(rc = set_comp_cast(&tmp, set, LYXP_SET_STRING, i), cleanup);
+        str = tmp.val.str;
+        tmp.val.str = NULL;
+        lyxp_set_free_content(&tmp);
+
+        r = lyht_insert(*ht, &str, lyht_hash(str, strlen(str)), NULL);
+        if (r) {
+            free(str);
+            if (r != LY_EEXIST) {
+                rc = r;
+                goto cleanup;
+            }
+        }
+    }
+
+cleanup:
+    if (rc) {
+        set_comp_hash_free(*ht);
+        *ht = NULL;
+    }
+    return rc;
+}
+
+/**
+ * @brief Move context @p set1 to the result of a node-set comparison using a hash table of @p set2 values.
+ *
+ * Equivalent to comparing every pair of the items, but O(n) with the table.
+ *
+ * @param[in] set1 First node-set.
+ * @param[in] set2 Second node-set, ::set_comp_hash_usable() must be true.
+ * @param[in] ht Hash table of @p set2 values created by ::set_comp_hash_build().
+ * @param[in] op Comparison operator, '=' or '!='.
+ * @param[out] result Result of the comparison.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+moveto_op_comp_hash(const struct lyxp_set *set1, const struct lyxp_set *set2, struct ly_ht *ht, const char *op,
+        ly_bool *result)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyxp_set tmp = {0};
+    uint32_t i, hash;
+
+    *result = 0;
+
+    /* look up the set1 values */
+    for (i = 0; i < set1->used; ++i) {
+        LY_CHECK_GOTO(rc = set_comp_cast(&tmp, set1, LYXP_SET_STRING, i), cleanup);
+        LY_CHECK_GOTO(rc = set_comp_canonize(&tmp, &set2->val.nodes[0]), cleanup);
+
+        hash = lyht_hash(tmp.val.str, strlen(tmp.val.str));
+        if (op[0] == '=') {
+            *result = lyht_find(ht, &tmp.val.str, hash, NULL) ? 0 : 1;
+        } else {
+            /* there is a different value */
+            *result = ((ht->used > 1) || lyht_find(ht, &tmp.val.str, hash, NULL)) ? 1 : 0;
+        }
+        lyxp_set_free_content(&tmp);
+
+        /* lazy evaluation until true */
+        if (*result) {
+            break;
+        }
+    }
+
+cleanup:
+    lyxp_set_free_content(&tmp);
+    return rc;
+}
+
 /**
  * @brief Move context @p set1 single item to the result of a comparison.
  *
@@ -7455,12 +7827,20 @@ moveto_op_comp(struct lyxp_set *set1, struct lyxp_set *set2, const char *op, ly_
      * NUMBER + BOOLEAN = NUMBER + NUMBER      /(1 NUMBER) 2 NUMBER
      * STRING + BOOLEAN = NUMBER + NUMBER      /(1 NUMBER) 2 NUMBER
      */
+    struct ly_ht *ht;
     uint32_t i;
     LY_ERR rc;
 
     /* iterative evaluation with node-sets */
     if ((set1->type == LYXP_SET_NODE_SET) || (set2->type == LYXP_SET_NODE_SET)) {
-        if (set1->type == LYXP_SET_NODE_SET) {
+        if ((set1->used >= LYXP_COMP_HASH_MIN_ITEMS) && (set2->used >= LYXP_COMP_HASH_MIN_ITEMS) &&
+                set_comp_hash_usable(set1, set2, op)) {
+            /* hash join of large node-sets, building the table pays off only for enough set1 values */
+            LY_CHECK_RET(set_comp_hash_build(set2, &ht));
+            rc = moveto_op_comp_hash(set1, set2, ht, op, result);
+            set_comp_hash_free(ht);
+            return rc;
+        } else if (set1->type == LYXP_SET_NODE_SET) {
             for (i = 0; i < set1->used; ++i) {
                 /* evaluate for the single item */
                 LY_CHECK_RET(moveto_op_comp_item(set1, i, set2, op, 0, result));
@@ -7609,6 +7989,63 @@ moveto_op_math(struct lyxp_set *set1, struct lyxp_set *set2, const char *op)
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Learn whether a subexpression is a location path whose resulting nodes can be only counted.
+ *
+ * @param[in] exp Parsed XPath expression.
+ * @param[in] tok_idx Index of the first token of the subexpression, it ends with an unmatched ')', ']', or ','.
+ * @return Index of the NameTest token of the last step if it is on the child axis without predicates;
+ * @return 0 if the subexpression is not such a location path.
+ */
+static uint32_t
+eval_count_last_step(const struct lyxp_expr *exp, uint32_t tok_idx)
+{
+    uint32_t last = 0, depth = 0;
+
+    for ( ; tok_idx < exp->used; ++tok_idx) {
+        if (depth) {
+            /* skip predicates and function arguments */
+            if ((exp->tokens[tok_idx] == LYXP_TOKEN_BRACK1) || (exp->tokens[tok_idx] == LYXP_TOKEN_PAR1)) {
+                ++depth;
+            } else if ((exp->tokens[tok_idx] == LYXP_TOKEN_BRACK2) || (exp->tokens[tok_idx] == LYXP_TOKEN_PAR2)) {
+                --depth;
+            }
+            continue;
+        }
+
+        switch (exp->tokens[tok_idx]) {
+        case LYXP_TOKEN_NAMETEST:
+            /* '//' is not on the child axis */
+            last = (exp->tokens[tok_idx - 1] == LYXP_TOKEN_OPER_RPATH) ? 0 : tok_idx;
+            break;
+        case LYXP_TOKEN_OPER_PATH:
+        case LYXP_TOKEN_OPER_RPATH:
+            break;
+        case LYXP_TOKEN_DOT:
+        case LYXP_TOKEN_DDOT:
+        case LYXP_TOKEN_FUNCNAME:
+        case LYXP_TOKEN_VARREF:
+            last = 0;
+            break;
+        case LYXP_TOKEN_BRACK1:
+        case LYXP_TOKEN_PAR1:
+            last = 0;
+            depth = 1;
+            break;
+        case LYXP_TOKEN_BRACK2:
+        case LYXP_TOKEN_PAR2:
+        case LYXP_TOKEN_COMMA:
+            /* end of the subexpression */
+            return last;
+        default:
+            /* not a location path */
+            return 0;
+        }
+    }
+
+    return last;
+}
+
 /**
  * @brief Evaluate Predicate. Logs directly on error.
  *
@@ -7625,7 +8062,7 @@ static LY_ERR
 eval_predicate(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_set *set, uint32_t options, enum lyxp_axis axis)
 {
     LY_ERR rc;
-    uint32_t i, orig_exp, orig_pos, orig_size;
+    uint32_t i, orig_exp, orig_pos, orig_size, count_tok_idx;
     int32_t pred_in_ctx;
     ly_bool reverse_axis = 0;
     struct lyxp_set set2 = {0};
@@ -7671,8 +8108,13 @@ only_parse:
         orig_exp = *tok_idx;
         orig_pos = reverse_axis ? set->used + 1 : 0;
         orig_size = set->used;
+
+        /* only whether the resulting nodes of a location path exist is needed */
+        count_tok_idx = eval_count_last_step(exp, orig_exp);
         for (i = 0; i < set->used; ++i) {
             set_init(&set2, set);
+            set2.count_tok_idx = count_tok_idx;
+            set2.count_exist = 1;
             set_insert_node(&set2, set->val.nodes[i].node, set->val.nodes[i].pos, set->val.nodes[i].type, 0);
 
             /* remember the node context position for position() and context size for last() */
@@ -7908,7 +8350,7 @@ eval_name_test_try_compile_predicate_append(const struct lyxp_expr *exp, uint32_
     /* evaluate the value subexpression with the root context node */
     lyxp_set_free_content(&set2);
     LY_CHECK_GOTO(rc = lyxp_eval(set->ctx, val_exp, set->cur_mod, set->format, set->prefix_data, set->cur_node,
-            ctx_node, set->tree, NULL, &set2, 0), cleanup);
+            ctx_node, set->tree, NULL, NULL, &set2, 0), cleanup);
 
     /* cast it into a string */
     LY_CHECK_GOTO(rc = lyxp_set_cast(&set2, LYXP_SET_STRING), cleanup);
@@ -8293,7 +8735,7 @@ eval_name_test_with_predicate(const struct lyxp_expr *exp, uint32_t *tok_idx, en
 {
     LY_ERR rc = LY_SUCCESS, r;
     const char *ncname = NULL;
-    uint32_t i, ncname_len;
+    uint32_t i, ncname_len, name_idx;
     const struct lys_module *moveto_mod = NULL, *moveto_m;
     const struct lysc_node *scnode = NULL;
     struct ly_path_predicate *predicates = NULL;
@@ -8301,6 +8743,7 @@ eval_name_test_with_predicate(const struct lyxp_expr *exp, uint32_t *tok_idx, en
 
     LOGDBG(LY_LDGXPATH, "%-27s %s %s[%u]", __func__, (options & LYXP_SKIP_EXPR ? "skipped" : "parsed"),
             lyxp_token2str(exp->tokens[*tok_idx]), exp->tok_pos[*tok_idx]);
+    name_idx = *tok_idx;
     ++(*tok_idx);
 
     if (options & LYXP_SKIP_EXPR) {
@@ -8346,8 +8789,9 @@ eval_name_test_with_predicate(const struct lyxp_expr *exp, uint32_t *tok_idx, en
         if (scnode && (scnode->nodetype & (LYS_LIST | LYS_LEAFLIST))) {
             /* try to create the predicates */
             if (eval_name_test_try_compile_predicates(exp, tok_idx, scnode, set, &predicates)) {
-                /* hashes cannot be used */
-                scnode = NULL;
+                /* a single instance cannot be found using hashes, find all the instances */
+                ly_path_predicates_free(scnode->module->ctx, predicates);
+                predicates = NULL;
             }
         }
     }
@@ -8428,7 +8872,10 @@ moveto:
                 scnode_skip_pred = 1;
             }
         } else {
-            if (all_desc && (axis == LYXP_AXIS_CHILD)) {
+            if (set->count_tok_idx && (set->count_tok_idx == name_idx) && !all_desc && (axis == LYXP_AXIS_CHILD)) {
+                /* the resulting nodes are not needed, only counted */
+                rc = moveto_node_count_child(set, scnode, moveto_mod, ncname, ncname_len, set->count_exist, options);
+            } else if (all_desc && (axis == LYXP_AXIS_CHILD)) {
                 /* efficient evaluation */
                 rc = moveto_node_alldesc_child(set, moveto_mod, ncname, ncname_len, options);
             } else if (scnode && (axis == LYXP_AXIS_CHILD)) {
@@ -8725,26 +9172,309 @@ eval_absolute_location_path(const struct lyxp_expr *exp, uint32_t *tok_idx, stru
 }
 
 /**
- * @brief Evaluate FunctionCall. Logs directly on error.
- *
- * [11] FunctionCall ::= FunctionName '(' ( Expr ( ',' Expr )* )? ')'
- *
- * @param[in] exp Parsed XPath expression.
- * @param[in] tok_idx Position in the expression @p exp.
- * @param[in,out] set Context and result set.
- * @param[in] options XPath options.
- * @return LY_ERR (LY_EINCOMPLETE on unresolved when)
+ * @brief Memoized result of an absolute location path.
  */
-static LY_ERR
-eval_function_call(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_set *set, uint32_t options)
+struct lyxp_memo_rec {
+    const struct lyxp_expr *exp;        /**< expression of the path */
+    uint32_t tok_idx;                   /**< index of the first token of the path */
+    enum lyxp_node_type root_type;      /**< root type used for the evaluation */
+    const struct lysc_node *context_op; /**< context operation used for the evaluation */
+
+    uint32_t end_idx;                   /**< index of the first token following the path */
+    struct lyxp_set *set;               /**< result of the path, NULL if it depends on the context */
+    struct ly_ht *comp_ht;              /**< hash table of the string values of the result, created by the first
+                                             (in)equality comparison with it */
+};
+
+/**
+ * @brief Callback for comparing two memo records.
+ */
+static ly_bool
+lyxp_memo_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
 {
-    LY_ERR rc;
+    struct lyxp_memo_rec *rec1 = val1_p, *rec2 = val2_p;
 
-    LY_ERR (*xpath_func)(struct lyxp_set **, uint32_t, struct lyxp_set *, uint32_t) = NULL;
-    uint32_t arg_count = 0, i;
-    struct lyxp_set **args = NULL, **args_aux;
+    return (rec1->exp == rec2->exp) && (rec1->tok_idx == rec2->tok_idx) && (rec1->root_type == rec2->root_type) &&
+           (rec1->context_op == rec2->context_op);
+}
 
-    if (!(options & LYXP_SKIP_EXPR)) {
+/**
+ * @brief Free a memo record, callback for ::lyht_free().
+ *
+ * @param[in] val_p Pointer to the record.
+ */
+static void
+lyxp_memo_rec_free(void *val_p)
+{
+    struct lyxp_memo_rec *rec = val_p;
+
+    lyxp_set_free(rec->set);
+    set_comp_hash_free(rec->comp_ht);
+}
+
+void
+lyxp_memo_clear(struct lyxp_memo *memo)
+{
+    lyht_free(memo->ht, lyxp_memo_rec_free);
+    memo->ht = NULL;
+}
+
+/**
+ * @brief Find a memo record of an AbsoluteLocationPath.
+ *
+ * @param[in] exp Parsed XPath expression.
+ * @param[in] tok_idx Index of the first token of the path.
+ * @param[in] set Set with the memo, its root type and context operation.
+ * @param[out] rec Filled record to find, used for inserting it, optional.
+ * @param[out] hash Hash of the record, optional.
+ * @return Found memo record, NULL if none.
+ */
+static struct lyxp_memo_rec *
+lyxp_memo_find(const struct lyxp_expr *exp, uint32_t tok_idx, const struct lyxp_set *set, struct lyxp_memo_rec *rec,
+        uint32_t *hash)
+{
+    struct lyxp_memo_rec rec_l = {0}, *match;
+    uint32_t hash_l;
+
+    if (!rec) {
+        rec = &rec_l;
+    }
+    if (!hash) {
+        hash = &hash_l;
+    }
+
+    rec->exp = exp;
+    rec->tok_idx = tok_idx;
+    rec->root_type = set->root_type;
+    rec->context_op = set->context_op;
+    *hash = lyht_hash_multi(0, (const char *)&exp, sizeof exp);
+    *hash = lyht_hash_multi(*hash, (const char *)&tok_idx, sizeof tok_idx);
+    *hash = lyht_hash_multi(*hash, NULL, 0);
+
+    if (!set->memo->ht || lyht_find(set->memo->ht, rec, *hash, (void **)&match)) {
+        return NULL;
+    }
+    return match;
+}
+
+/**
+ * @brief Check whether a comparison can use a memoized hash table of the values of its right operand.
+ *
+ * @param[in] set1 First compared set.
+ * @param[in] op Comparison operator.
+ * @return Whether the table can be used.
+ */
+static ly_bool
+lyxp_memo_comp_usable(const struct lyxp_set *set1, const char *op)
+{
+    return set1->memo && (set1->type == LYXP_SET_NODE_SET) && set1->used && ((op[0] == '=') || (op[0] == '!'));
+}
+
+/**
+ * @brief Find a memo record of the right operand of an (in)equality comparison with a hash table of its values.
+ *
+ * The table is created only if the whole operand is the memoized AbsoluteLocationPath so the operand then does not
+ * need to be evaluated.
+ *
+ * @param[in] exp Parsed XPath expression.
+ * @param[in] start_idx Index of the first token of the operand.
+ * @param[in] set1 First compared set.
+ * @param[in] op Comparison operator.
+ * @return Found memo record, NULL if none.
+ */
+static struct lyxp_memo_rec *
+lyxp_memo_comp_find(const struct lyxp_expr *exp, uint32_t start_idx, const struct lyxp_set *set1, const char *op)
+{
+    struct lyxp_memo_rec *match;
+
+    if (!lyxp_memo_comp_usable(set1, op)) {
+        return NULL;
+    }
+
+    match = lyxp_memo_find(exp, start_idx, set1, NULL, NULL);
+    if (!match || !match->comp_ht) {
+        return NULL;
+    }
+    return match;
+}
+
+/**
+ * @brief Create a memoized hash table of the values of the right operand of an (in)equality comparison.
+ *
+ * The table is created if the whole operand is a memoized context-independent AbsoluteLocationPath with enough
+ * items and is used until the memo is cleared.
+ *
+ * @param[in] exp Parsed XPath expression.
+ * @param[in] start_idx Index of the first token of the operand.
+ * @param[in] end_idx Index of the first token following the operand.
+ * @param[in] set1 First compared set.
+ * @param[in] set2 Second compared set, result of the operand.
+ * @param[in] op Comparison operator.
+ * @param[out] ht Created hash table of @p set2 values, NULL if not created.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyxp_memo_comp_build(const struct lyxp_expr *exp, uint32_t start_idx, uint32_t end_idx, const struct lyxp_set *set1,
+        const struct lyxp_set *set2, const char *op, struct ly_ht **ht)
+{
+    struct lyxp_memo_rec *match;
+
+    *ht = NULL;
+
+    if (!lyxp_memo_comp_usable(set1, op) || (set2->type != LYXP_SET_NODE_SET) ||
+            (set2->used < LYXP_COMP_HASH_MIN_ITEMS)) {
+        /* not worth creating the table even once */
+        return LY_SUCCESS;
+    }
+
+    match = lyxp_memo_find(exp, start_idx, set2, NULL, NULL);
+    if (!match || !match->set || match->comp_ht || (match->end_idx != end_idx) ||
+            !set_comp_hash_usable(set1, set2, op)) {
+        /* not (only) a memoized path */
+        return LY_SUCCESS;
+    }
+
+    LY_CHECK_RET(set_comp_hash_build(set2, &match->comp_ht));
+    *ht = match->comp_ht;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Check whether a subexpression is independent of the context, so that its result depends only on the data.
+ *
+ * Context nodes of all the steps and predicates are derived from the root, only the current node and variables
+ * are taken from the outside.
+ *
+ * @param[in] exp Parsed XPath expression.
+ * @param[in] start_idx Index of the first token of the subexpression.
+ * @param[in] end_idx Index of the first token following the subexpression.
+ * @return Whether the subexpression is context-independent.
+ */
+static ly_bool
+eval_subexpr_is_ctx_independent(const struct lyxp_expr *exp, uint32_t start_idx, uint32_t end_idx)
+{
+    uint32_t i;
+
+    for (i = start_idx; i < end_idx; ++i) {
+        if (exp->tokens[i] == LYXP_TOKEN_VARREF) {
+            return 0;
+        } else if ((exp->tokens[i] == LYXP_TOKEN_FUNCNAME) && (exp->tok_len[i] == 7) &&
+                !strncmp(&exp->expr[exp->tok_pos[i]], "current", 7)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Evaluate AbsoluteLocationPath using the memo of the set, if any. Logs directly on error.
+ *
+ * @param[in] exp Parsed XPath expression.
+ * @param[in] tok_idx Position in the expression @p exp.
+ * @param[in,out] set Context and result set.
+ * @param[in] options XPath options.
+ * @return LY_ERR (LY_EINCOMPLETE on unresolved when)
+ */
+static LY_ERR
+eval_absolute_location_path_memo(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_set *set,
+        uint32_t options)
+{
+    struct lyxp_memo_rec rec = {0}, *match;
+    const struct lyd_node *cur_node;
+    uint32_t hash;
+    LY_ERR r;
+
+    if (!set->memo || (options & (LYXP_SKIP_EXPR | LYXP_SCNODE_ALL))) {
+        return eval_absolute_location_path(exp, tok_idx, set, options);
+    }
+
+    match = lyxp_memo_find(exp, *tok_idx, set, &rec, &hash);
+    if (match) {
+        if (!match->set) {
+            /* context-dependent */
+            return eval_absolute_location_path(exp, tok_idx, set, options);
+        }
+
+        /* use the memoized result */
+        if (match->set->type == LYXP_SET_NUMBER) {
+            /* only counted */
+            set_fill_number(set, match->set->val.num);
+            *tok_idx = match->end_idx;
+            return LY_SUCCESS;
+        } else if (match->set->type == LYXP_SET_BOOLEAN) {
+            set_fill_boolean(set, match->set->val.bln);
+            *tok_idx = match->end_idx;
+            return LY_SUCCESS;
+        }
+        lyxp_set_free_content(set);
+        set->val.nodes = malloc(match->set->used * sizeof *set->val.nodes);
+        LY_CHECK_ERR_RET(!set->val.nodes && match->set->used, LOGMEM(set->ctx), LY_EMEM);
+        memcpy(set->val.nodes, match->set->val.nodes, match->set->used * sizeof *set->val.nodes);
+        set->used = set->size = match->set->used;
+        set->ctx_pos = match->set->ctx_pos;
+        set->ctx_size = match->set->ctx_size;
+        set->non_child_axis = match->set->non_child_axis;
+        set->not_found |= match->set->not_found;
+        if (match->set->ht) {
+            set->ht = lyht_dup(match->set->ht);
+            LY_CHECK_ERR_RET(!set->ht, LOGMEM(set->ctx), LY_EMEM);
+        }
+
+        *tok_idx = match->end_idx;
+        return LY_SUCCESS;
+    }
+
+    /* evaluate */
+    LY_CHECK_RET(eval_absolute_location_path(exp, tok_idx, set, options));
+
+    /* the current node is accepted even with an unresolved when so the result would depend on it */
+    cur_node = set->cur_node;
+    if (cur_node && cur_node->schema && !(options & LYXP_IGNORE_WHEN) && lysc_has_when(cur_node->schema) &&
+            !(cur_node->flags & LYD_WHEN_TRUE)) {
+        return LY_SUCCESS;
+    }
+
+    /* memoize the result */
+    if (!set->memo->ht) {
+        set->memo->ht = lyht_new(LYHT_MIN_SIZE, sizeof rec, lyxp_memo_equal_cb, NULL, 1);
+        LY_CHECK_ERR_RET(!set->memo->ht, LOGMEM(set->ctx), LY_EMEM);
+    }
+    rec.end_idx = *tok_idx;
+    if (eval_subexpr_is_ctx_independent(exp, rec.tok_idx, rec.end_idx)) {
+        rec.set = set_copy(set);
+        LY_CHECK_RET(!rec.set, LY_EMEM);
+    }
+    r = lyht_insert(set->memo->ht, &rec, hash, NULL);
+    if (r) {
+        lyxp_set_free(rec.set);
+        return r;
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Evaluate FunctionCall. Logs directly on error.
+ *
+ * [11] FunctionCall ::= FunctionName '(' ( Expr ( ',' Expr )* )? ')'
+ *
+ * @param[in] exp Parsed XPath expression.
+ * @param[in] tok_idx Position in the expression @p exp.
+ * @param[in,out] set Context and result set.
+ * @param[in] options XPath options.
+ * @return LY_ERR (LY_EINCOMPLETE on unresolved when)
+ */
+static LY_ERR
+eval_function_call(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_set *set, uint32_t options)
+{
+    LY_ERR rc;
+
+    LY_ERR (*xpath_func)(struct lyxp_set **, uint32_t, struct lyxp_set *, uint32_t) = NULL;
+    uint32_t arg_count = 0, i;
+    struct lyxp_set **args = NULL, **args_aux;
+
+    if (!(options & LYXP_SKIP_EXPR)) {
         /* FunctionName */
         switch (exp->tok_len[*tok_idx]) {
         case 3:
@@ -8885,6 +9615,14 @@ eval_function_call(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_s
                 goto cleanup;
             }
 
+            args[0]->count_tok_idx = 0;
+            if (!(options & LYXP_SCNODE_ALL) &&
+                    ((xpath_func == &xpath_count) || (xpath_func == &xpath_boolean) || (xpath_func == &xpath_not))) {
+                /* only the number of the resulting nodes or whether there are any is needed */
+                args[0]->count_tok_idx = eval_count_last_step(exp, *tok_idx);
+                args[0]->count_exist = (xpath_func == &xpath_count) ? 0 : 1;
+            }
+
             rc = eval_expr_select(exp, tok_idx, 0, args[0], options);
             LY_CHECK_GOTO(rc, cleanup);
             set->not_found = args[0]->not_found;
@@ -8908,6 +9646,7 @@ eval_function_call(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_s
                 rc = LY_EMEM;
                 goto cleanup;
             }
+            args[arg_count - 1]->count_tok_idx = 0;
 
             rc = eval_expr_select(exp, tok_idx, 0, args[arg_count - 1], options);
             LY_CHECK_GOTO(rc, cleanup);
@@ -9032,6 +9771,7 @@ eval_variable_reference(const struct lyxp_expr *exp, uint32_t *tok_idx, struct l
     const char *name;
     struct lyxp_var *var;
     struct lyxp_expr *tokens = NULL;
+    struct lyxp_memo *memo;
     uint32_t token_index, name_len;
 
     /* find out the name and value of the variable */
@@ -9044,9 +9784,12 @@ eval_variable_reference(const struct lyxp_expr *exp, uint32_t *tok_idx, struct l
     ret = lyxp_expr_parse(set->ctx, !(options & LYXP_SCNODE_ALL) ? set->cur_node : NULL, var->value, 0, 1, &tokens);
     LY_CHECK_GOTO(ret, cleanup);
 
-    /* evaluate value */
+    /* evaluate value, the temporary expression cannot be memoized */
     token_index = 0;
+    memo = set->memo;
+    set->memo = NULL;
     ret = eval_expr_select(tokens, &token_index, 0, set, options);
+    set->memo = memo;
     LY_CHECK_GOTO(ret, cleanup);
 
 cleanup:
@@ -9126,7 +9869,7 @@ eval_path_expr(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_set *
     case LYXP_TOKEN_OPER_PATH:
     case LYXP_TOKEN_OPER_RPATH:
         /* AbsoluteLocationPath */
-        rc = eval_absolute_location_path(exp, tok_idx, set, options);
+        rc = eval_absolute_location_path_memo(exp, tok_idx, set, options);
         LY_CHECK_RET(rc);
         break;
 
@@ -9546,6 +10289,9 @@ eval_equality_expr(const struct lyxp_expr *exp, uint32_t *tok_idx, uint32_t repe
     LY_ERR rc = LY_SUCCESS;
     uint32_t i, this_op;
     struct lyxp_set orig_set, set2;
+    struct lyxp_memo_rec *memo_rec;
+    struct ly_ht *comp_ht;
+    const char *op;
 
     assert(repeat);
 
@@ -9572,6 +10318,21 @@ eval_equality_expr(const struct lyxp_expr *exp, uint32_t *tok_idx, uint32_t repe
             continue;
         }
 
+        op = &exp->expr[exp->tok_pos[this_op]];
+        if (!(options & LYXP_SCNODE_ALL) && (memo_rec = lyxp_memo_comp_find(exp, *tok_idx, set, op))) {
+            ly_bool result;
+
+            /* compare with the hashed values of the memoized operand, no need to evaluate it */
+            rc = moveto_op_comp_hash(set, memo_rec->set, memo_rec->comp_ht, op, &result);
+            LY_CHECK_GOTO(rc, cleanup);
+            if (memo_rec->set->not_found) {
+                set->not_found = 1;
+            }
+            set_fill_boolean(set, result);
+            *tok_idx = memo_rec->end_idx;
+            continue;
+        }
+
         set_fill_set(&set2, &orig_set);
         rc = eval_expr_select(exp, tok_idx, LYXP_EXPR_EQUALITY, &set2, options);
         LY_CHECK_GOTO(rc, cleanup);
@@ -9589,7 +10350,15 @@ eval_equality_expr(const struct lyxp_expr *exp, uint32_t *tok_idx, uint32_t repe
         } else {
             ly_bool result;
 
-            rc = moveto_op_comp(set, &set2, &exp->expr[exp->tok_pos[this_op]], &result);
+            /* hash the values of a memoized operand for the next comparisons */
+            rc = lyxp_memo_comp_build(exp, this_op + 1, *tok_idx, set, &set2, op, &comp_ht);
+            LY_CHECK_GOTO(rc, cleanup);
+
+            if (comp_ht) {
+                rc = moveto_op_comp_hash(set, &set2, comp_ht, op, &result);
+            } else {
+                rc = moveto_op_comp(set, &set2, op, &result);
+            }
             LY_CHECK_GOTO(rc, cleanup);
             set_fill_boolean(set, result);
         }
@@ -9872,15 +10641,27 @@ lyxp_get_root_type(const struct lyd_node *ctx_node, const struct lysc_node *ctx_
     return LYXP_NODE_ROOT;
 }
 
-LY_ERR
-lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct lys_module *cur_mod,
-        LY_VALUE_FORMAT format, void *prefix_data, const struct lyd_node *cur_node, const struct lyd_node *ctx_node,
-        const struct lyd_node *tree, const struct lyxp_var *vars, struct lyxp_set *set, uint32_t options)
+/**
+ * @brief Prepare a set for evaluation of an expression on data.
+ *
+ * @param[out] set Set to prepare.
+ * @param[in] ctx libyang context to use.
+ * @param[in] cur_mod Current module for the expression (where it was "instantiated").
+ * @param[in] format Format of the XPath expression (more specifically, of any used prefixes).
+ * @param[in] prefix_data Format-specific prefix data (see ::ly_resolve_prefix).
+ * @param[in] cur_node Current data node, NULL in case of the root node.
+ * @param[in] ctx_node Starting context data node, NULL in case of the root node.
+ * @param[in] tree Data tree on which to perform the evaluation, is adjusted.
+ * @param[in] vars [Sized array](@ref sizedarrays) of XPath variables.
+ * @param[in] memo Optional memo of context-independent subexpression results.
+ * @param[in] options XPath options.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+set_init_eval(struct lyxp_set *set, const struct ly_ctx *ctx, const struct lys_module *cur_mod, LY_VALUE_FORMAT format,
+        void *prefix_data, const struct lyd_node *cur_node, const struct lyd_node *ctx_node, const struct lyd_node *tree,
+        const struct lyxp_var *vars, struct lyxp_memo *memo, uint32_t options)
 {
-    uint32_t tok_idx = 0;
-    LY_ERR rc;
-
-    LY_CHECK_ARG_RET(ctx, ctx, exp, set, LY_EINVAL);
     if (!cur_mod && ((format == LY_VALUE_SCHEMA) || (format == LY_VALUE_SCHEMA_RESOLVED))) {
         LOGERR(ctx, LY_EINVAL, "Current module must be set if schema format is used.");
         return LY_EINVAL;
@@ -9901,7 +10682,6 @@ lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct ly
         }
     }
 
-    /* prepare set for evaluation */
     memset(set, 0, sizeof *set);
     set->type = LYXP_SET_NODE_SET;
     set->root_type = lyxp_get_root_type(ctx_node, NULL, options);
@@ -9917,6 +10697,24 @@ lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct ly
     set->format = format;
     set->prefix_data = prefix_data;
     set->vars = vars;
+    set->memo = memo;
+
+    return LY_SUCCESS;
+}
+
+LY_ERR
+lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct lys_module *cur_mod,
+        LY_VALUE_FORMAT format, void *prefix_data, const struct lyd_node *cur_node, const struct lyd_node *ctx_node,
+        const struct lyd_node *tree, const struct lyxp_var *vars, struct lyxp_memo *memo, struct lyxp_set *set,
+        uint32_t options)
+{
+    uint32_t tok_idx = 0;
+    LY_ERR rc;
+
+    LY_CHECK_ARG_RET(ctx, ctx, exp, set, LY_EINVAL);
+
+    /* prepare set for evaluation */
+    LY_CHECK_RET(set_init_eval(set, ctx, cur_mod, format, prefix_data, cur_node, ctx_node, tree, vars, memo, options));
 
     /* evaluate */
     rc = eval_expr_select(exp, &tok_idx, 0, set, options);
@@ -9930,6 +10728,332 @@ lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct ly
     return rc;
 }
 
+/**
+ * @brief Find the only schema node that a name test of an iterator step can match in the children of a schema node,
+ * the same way as the path evaluation.
+ *
+ * @param[in] iter XPath iterator.
+ * @param[in] at_root Whether the context node of the step is the root.
+ * @param[in] sparent Schema node of the context node, NULL if unknown.
+ * @param[in] mod Module of the step, NULL if not set.
+ * @param[in] name Name of the step.
+ * @param[in] name_len Length of @p name.
+ * @return Found schema node, NULL if there is none or several.
+ */
+static const struct lysc_node *
+lyxp_iter_step_scnode(const struct lyd_xpath_iter *iter, ly_bool at_root, const struct lysc_node *sparent,
+        const struct lys_module *mod, const char *name, uint32_t name_len)
+{
+    const struct lysc_node *scnode = NULL, *scnode2;
+
+    if (!mod && (iter->set.format != LY_VALUE_JSON)) {
+        return NULL;
+    }
+
+    if (at_root) {
+        if (eval_name_test_with_predicate_get_scnode(iter->set.ctx, NULL, name, name_len, mod, iter->set.root_type,
+                iter->set.format, &scnode)) {
+            scnode = NULL;
+        }
+        return scnode;
+    } else if (!sparent) {
+        return NULL;
+    }
+
+    if (!mod) {
+        /* inherit the module of the context node */
+        mod = sparent->module;
+    } else if ((mod->ctx != sparent->module->ctx) || !mod->implemented) {
+        return NULL;
+    }
+
+    scnode = eval_name_test_with_predicate_find_scnode(sparent, mod, name, name_len, 0);
+    if (sparent->nodetype & (LYS_RPC | LYS_ACTION)) {
+        /* the node must be unique, whether in input or output */
+        scnode2 = eval_name_test_with_predicate_find_scnode(sparent, mod, name, name_len, LYS_GETNEXT_OUTPUT);
+        if (scnode && scnode2) {
+            scnode = NULL;
+        } else if (scnode2) {
+            scnode = scnode2;
+        }
+    }
+
+    return scnode;
+}
+
+/**
+ * @brief Learn whether an expression is a location path that can be evaluated by an iterator lazily
+ * and prepare its steps.
+ *
+ * Only location paths with name tests on the child and descendant axes are supported.
+ *
+ * @param[in,out] iter Iterator with the prepared set and expression, its steps are filled.
+ * @return LY_SUCCESS if the path is supported;
+ * @return LY_ENOT if not;
+ * @return LY_ERR value on error.
+ */
+static LY_ERR
+lyxp_iter_prepare_steps(struct lyd_xpath_iter *iter)
+{
+    const struct lyxp_expr *exp = iter->exp;
+    struct lyxp_iter_step *step;
+    const struct lysc_node *sparent, *scnode;
+    const char *name;
+    uint32_t tok_idx = 0, name_len;
+    ly_bool child_axis, inherit_mod, at_root, single;
+
+    if ((iter->set.root_type != LYXP_NODE_ROOT) || iter->set.context_op) {
+        return LY_ENOT;
+    }
+
+    /* check the expression */
+    if ((exp->tokens[0] == LYXP_TOKEN_OPER_PATH) || (exp->tokens[0] == LYXP_TOKEN_OPER_RPATH)) {
+        ++tok_idx;
+    }
+    while (1) {
+        if ((tok_idx >= exp->used) || (exp->tokens[tok_idx] != LYXP_TOKEN_NAMETEST)) {
+            return LY_ENOT;
+        }
+        if (++tok_idx == exp->used) {
+            break;
+        }
+        if ((exp->tokens[tok_idx] != LYXP_TOKEN_OPER_PATH) && (exp->tokens[tok_idx] != LYXP_TOKEN_OPER_RPATH)) {
+            return LY_ENOT;
+        }
+        ++tok_idx;
+    }
+    if ((exp->used + 1) / 2 > 63) {
+        /* too many steps for the bitmaps */
+        return LY_ENOT;
+    }
+
+    iter->steps = calloc((exp->used + 1) / 2, sizeof *iter->steps);
+    LY_CHECK_ERR_RET(!iter->steps, LOGMEM(iter->set.ctx), LY_EMEM);
+
+    /* resolve the steps, track whether all the context nodes of a step are instances of a single schema node */
+    tok_idx = 0;
+    child_axis = 1;
+    at_root = (exp->tokens[0] != LYXP_TOKEN_NAMETEST) || !iter->set.cur_node;
+    sparent = at_root ? NULL : iter->set.cur_node->schema;
+    single = 1;
+    do {
+        if (exp->tokens[tok_idx] != LYXP_TOKEN_NAMETEST) {
+            child_axis = (exp->tokens[tok_idx] == LYXP_TOKEN_OPER_PATH) ? 1 : 0;
+            ++tok_idx;
+        }
+
+        step = &iter->steps[iter->step_count];
+        ++iter->step_count;
+        if (child_axis) {
+            iter->child_steps |= 1ULL << iter->step_count;
+        }
+
+        name = &exp->expr[exp->tok_pos[tok_idx]];
+        name_len = exp->tok_len[tok_idx];
+        ++tok_idx;
+        if ((name[0] == '*') && (name_len == 1)) {
+            /* all nodes will match */
+            single = 0;
+            continue;
+        }
+
+        /* parse (and skip) module name */
+        LY_CHECK_RET(moveto_resolve_module(&name, &name_len, &iter->set, NULL, &step->mod));
+        if ((name[0] == '*') && (name_len == 1)) {
+            /* all nodes from the module will match */
+            single = 0;
+            continue;
+        }
+
+        step->name = name;
+        step->name_len = name_len;
+        inherit_mod = (iter->set.format == LY_VALUE_JSON) && !step->mod && child_axis;
+        if (!child_axis || !single) {
+            if (inherit_mod) {
+                /* the module is learned from all the context nodes at once, which may be instances of
+                 * different schema nodes, so the module of a single parent cannot be used */
+                return LY_ENOT;
+            }
+            single = 0;
+            continue;
+        }
+
+        scnode = lyxp_iter_step_scnode(iter, at_root, sparent, step->mod, name, name_len);
+        if (inherit_mod) {
+            /* the module is inherited from the parent as when evaluating the path, any module if not found */
+            step->mod = scnode ? scnode->module : NULL;
+        }
+        at_root = 0;
+        sparent = scnode;
+        single = scnode ? 1 : 0;
+    } while (tok_idx < exp->used);
+
+    return LY_SUCCESS;
+}
+
+LY_ERR
+lyxp_iter_init(struct lyd_xpath_iter *iter, const struct ly_ctx *ctx, const struct lys_module *cur_mod,
+        LY_VALUE_FORMAT format, void *prefix_data, const struct lyd_node *ctx_node, const struct lyd_node *tree,
+        const struct lyxp_var *vars)
+{
+    LY_ERR r;
+
+    assert(iter->exp);
+
+    /* prepare set for evaluation */
+    LY_CHECK_RET(set_init_eval(&iter->set, ctx, cur_mod, format, prefix_data, ctx_node, ctx_node, tree, vars, NULL,
+            LYXP_IGNORE_WHEN));
+
+    r = lyxp_iter_prepare_steps(iter);
+    if (!r) {
+        /* start the traversal from the root for absolute paths or from the context node */
+        iter->frames = malloc(8 * sizeof *iter->frames);
+        LY_CHECK_ERR_RET(!iter->frames, LOGMEM(ctx), LY_EMEM);
+        iter->frame_size = 8;
+        iter->frames[0].node = (iter->exp->tokens[0] == LYXP_TOKEN_NAMETEST) ? ctx_node : NULL;
+        iter->frames[0].matched = 1;
+        iter->frames[0].reached = 1;
+        iter->lazy = 1;
+        return LY_SUCCESS;
+    } else if (r != LY_ENOT) {
+        return r;
+    }
+
+    /* evaluate the whole expression */
+    lyxp_set_free_content(&iter->set);
+    LY_CHECK_RET(lyxp_eval(ctx, iter->exp, cur_mod, format, prefix_data, ctx_node, ctx_node, tree, vars, NULL,
+            &iter->set, LYXP_IGNORE_WHEN));
+    if (iter->set.type != LYXP_SET_NODE_SET) {
+        LOGERR(ctx, LY_EINVAL, "XPath \"%s\" result is not a node set.", iter->exp->expr);
+        return LY_EINVAL;
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Get the bitmap of the steps that the children of a traversed node are to be checked for.
+ *
+ * @param[in] iter XPath iterator.
+ * @param[in] frame Frame of the traversed node.
+ * @return Bitmap of the steps.
+ */
+static uint64_t
+lyxp_iter_pending_steps(const struct lyd_xpath_iter *iter, const struct lyxp_iter_frame *frame)
+{
+    uint64_t all_steps = (1ULL << (iter->step_count + 1)) - 2;
+
+    return ((frame->matched << 1) & iter->child_steps) | ((frame->reached << 1) & ~iter->child_steps & all_steps);
+}
+
+/**
+ * @brief Check a node reached by the traversal against the steps pending for it.
+ *
+ * @param[in] iter XPath iterator.
+ * @param[in] parent Frame of the parent of @p node.
+ * @param[in] node Node to check.
+ * @return Bitmap of the steps matched by @p node.
+ */
+static uint64_t
+lyxp_iter_match_steps(struct lyd_xpath_iter *iter, const struct lyxp_iter_frame *parent, const struct lyd_node *node)
+{
+    uint64_t pending, matched = 0;
+    const struct lyxp_iter_step *step;
+    uint32_t i;
+
+    pending = lyxp_iter_pending_steps(iter, parent);
+    for (i = 1; i <= iter->step_count; ++i) {
+        if (!(pending & (1ULL << i))) {
+            continue;
+        }
+
+        step = &iter->steps[i - 1];
+        if (!moveto_node_check(node, LYXP_NODE_ELEM, &iter->set, step->name, step->name_len, step->mod,
+                LYXP_IGNORE_WHEN)) {
+            matched |= 1ULL << i;
+        }
+    }
+
+    return matched;
+}
+
+LY_ERR
+lyxp_iter_next(struct lyd_xpath_iter *iter, const struct lyd_node **node)
+{
+    struct lyxp_iter_frame *frame, *parent;
+    const struct lyd_node *next;
+    void *mem;
+
+    if (!iter->lazy) {
+        /* return the next node from the evaluated set */
+        for ( ; iter->set_idx < iter->set.used; ++iter->set_idx) {
+            if (iter->set.val.nodes[iter->set_idx].type == LYXP_NODE_ELEM) {
+                *node = iter->set.val.nodes[iter->set_idx++].node;
+                return LY_SUCCESS;
+            }
+        }
+        return LY_ENOTFOUND;
+    }
+
+    while (!iter->finished) {
+        /* next node in the pre-order traversal, skip subtrees with no pending steps */
+        frame = &iter->frames[iter->depth];
+        next = NULL;
+        if (lyxp_iter_pending_steps(iter, frame)) {
+            if (!frame->node) {
+                next = lyxp_node_first_doc_root_child(iter->set.cur_node, iter->set.tree);
+            } else {
+                next = lyd_child_any(frame->node);
+            }
+        }
+        if (next) {
+            ++iter->depth;
+        } else {
+            while (iter->depth && !(next = iter->frames[iter->depth].node->next)) {
+                --iter->depth;
+            }
+            if (!iter->depth) {
+                iter->finished = 1;
+                break;
+            }
+        }
+
+        if (iter->depth == iter->frame_size) {
+            mem = realloc(iter->frames, (iter->frame_size * 2) * sizeof *iter->frames);
+            LY_CHECK_ERR_RET(!mem, LOGMEM(iter->set.ctx), LY_EMEM);
+            iter->frames = mem;
+            iter->frame_size *= 2;
+        }
+
+        /* check the node */
+        parent = &iter->frames[iter->depth - 1];
+        frame = &iter->frames[iter->depth];
+        frame->node = next;
+        frame->matched = lyxp_iter_match_steps(iter, parent, next);
+        frame->reached = frame->matched | parent->reached;
+
+        if (frame->matched & (1ULL << iter->step_count)) {
+            /* matches the whole path */
+            *node = next;
+            return LY_SUCCESS;
+        }
+    }
+
+    return LY_ENOTFOUND;
+}
+
+void
+lyxp_iter_clean(struct lyd_xpath_iter *iter)
+{
+    if (!iter) {
+        return;
+    }
+
+    lyxp_set_free_content(&iter->set);
+    free(iter->steps);
+    free(iter->frames);
+}
+
 #if 0
 
 /* full xml printing of set elements, not used currently */
@@ -90,6 +90,9 @@ struct lyd_node;
 #define LYXP_STRING_CAST_SIZE_START 64
 #define LYXP_STRING_CAST_SIZE_STEP 16
 
+/* minimal number of items of both node-sets to compare using a transient hash table of the values */
+#define LYXP_COMP_HASH_MIN_ITEMS 16
+
 /* Maximum number of nested expressions. */
 #define LYXP_MAX_BLOCK_DEPTH 100
 
@@ -315,6 +318,21 @@ struct lyxp_set {
     void *prefix_data;                      /**< Format-specific prefix data (see ::ly_resolve_prefix). */
     const struct lyxp_var *vars;            /**< XPath variables. [Sized array](@ref sizedarrays).
                                                  Set of variable bindings. */
+    struct lyxp_memo *memo;                 /**< Optional memo of context-independent subexpression results. */
+    uint32_t count_tok_idx;                 /**< Index of the NameTest token of the last location path step whose
+                                                 resulting nodes are only counted, the result is a number, 0 if none. */
+    ly_bool count_exist;                    /**< Whether only the existence of the nodes of @p count_tok_idx is learned,
+                                                 the result is a boolean. */
+};
+
+/**
+ * @brief Memo of the results of context-independent XPath subexpressions (absolute location paths).
+ *
+ * The results are valid only for a single data tree and only until it is changed, so the memo must be cleared
+ * on any change of the tree. Zeroed structure is an empty memo.
+ */
+struct lyxp_memo {
+    struct ly_ht *ht;   /**< hash table of the memoized results, created when first needed */
 };
 
 /**
@@ -343,6 +361,7 @@ const char *lyxp_token2str(enum lyxp_token tok);
  * @param[in] tree Data tree on which to perform the evaluation, it must include all the available data (including
  * the tree of @p ctx_node). Can be any node of the tree, it is adjusted.
  * @param[in] vars [Sized array](@ref sizedarrays) of XPath variables.
+ * @param[in] memo Optional memo of context-independent subexpression results to use and fill.
  * @param[out] set Result set.
  * @param[in] options Whether to apply some evaluation restrictions.
  * @return LY_EVALID for invalid argument types/count,
@@ -351,7 +370,89 @@ const char *lyxp_token2str(enum lyxp_token tok);
  */
 LY_ERR lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct lys_module *cur_mod,
         LY_VALUE_FORMAT format, void *prefix_data, const struct lyd_node *cur_node, const struct lyd_node *ctx_node,
-        const struct lyd_node *tree, const struct lyxp_var *vars, struct lyxp_set *set, uint32_t options);
+        const struct lyd_node *tree, const struct lyxp_var *vars, struct lyxp_memo *memo, struct lyxp_set *set,
+        uint32_t options);
+
+/**
+ * @brief Clear an XPath memo, free all its results.
+ *
+ * @param[in] memo Memo to clear.
+ */
+void lyxp_memo_clear(struct lyxp_memo *memo);
+
+/**
+ * @brief Name test of a single step of a location path evaluated during a traversal.
+ */
+struct lyxp_iter_step {
+    const struct lys_module *mod;   /**< expected module of the node, NULL for any */
+    const char *name;               /**< expected name of the node, NULL for any */
+    uint32_t name_len;              /**< length of @p name */
+};
+
+/**
+ * @brief Node on the path of the XPath iterator traversal.
+ */
+struct lyxp_iter_frame {
+    const struct lyd_node *node;    /**< data node, NULL for the root */
+    uint64_t matched;               /**< bitmap of the steps matched by the node, bit 0 is the context node */
+    uint64_t reached;               /**< bitmap of the steps matched by the node or any of its ancestors */
+};
+
+/**
+ * @brief XPath iterator returning the resulting nodes of an expression one by one in the document order.
+ *
+ * Location paths of only child and descendant steps with name tests are evaluated lazily during a single
+ * pre-order traversal of the data, the results of all the other expressions are evaluated first.
+ */
+struct lyd_xpath_iter {
+    struct lyxp_expr *exp;          /**< evaluated expression */
+    struct lyxp_set set;            /**< general context, the result if the expression is not evaluated lazily */
+    uint32_t set_idx;               /**< index of the next node in @p set */
+
+    ly_bool lazy;                   /**< whether the expression is evaluated lazily */
+    struct lyxp_iter_step *steps;   /**< steps of the location path */
+    uint32_t step_count;            /**< number of @p steps */
+    uint64_t child_steps;           /**< bitmap of the steps on the child axis, the others are on the descendant one */
+    struct lyxp_iter_frame *frames; /**< frames of the traversal path, the first is the context node */
+    uint32_t frame_size;            /**< number of allocated @p frames */
+    uint32_t depth;                 /**< index of the frame of the last traversed node */
+    ly_bool finished;               /**< whether the traversal has finished */
+};
+
+/**
+ * @brief Prepare an XPath iterator for evaluating an expression on data.
+ *
+ * @param[in] iter Iterator to prepare, with the expression set.
+ * @param[in] ctx libyang context to use.
+ * @param[in] cur_mod Current module for the expression (where it was "instantiated").
+ * @param[in] format Format of the XPath expression (more specifically, of any used prefixes).
+ * @param[in] prefix_data Format-specific prefix data (see ::ly_resolve_prefix).
+ * @param[in] ctx_node Starting context data node, NULL in case of the root node.
+ * @param[in] tree Data tree on which to perform the evaluation.
+ * @param[in] vars [Sized array](@ref sizedarrays) of XPath variables.
+ * @return LY_ERR value.
+ */
+LY_ERR lyxp_iter_init(struct lyd_xpath_iter *iter, const struct ly_ctx *ctx, const struct lys_module *cur_mod,
+        LY_VALUE_FORMAT format, void *prefix_data, const struct lyd_node *ctx_node, const struct lyd_node *tree,
+        const struct lyxp_var *vars);
+
+/**
+ * @brief Get the next resulting node of an XPath iterator.
+ *
+ * @param[in] iter Iterator to use.
+ * @param[out] node Next resulting data node.
+ * @return LY_SUCCESS on success.
+ * @return LY_ENOTFOUND if there are no more results.
+ * @return LY_ERR value on error.
+ */
+LY_ERR lyxp_iter_next(struct lyd_xpath_iter *iter, const struct lyd_node **node);
+
+/**
+ * @brief Free the content of an XPath iterator, except for its expression.
+ *
+ * @param[in] iter Iterator to clean.
+ */
+void lyxp_iter_clean(struct lyd_xpath_iter *iter);
 
 /**
  * @brief Get all the partial XPath nodes (atoms) that are required for @p exp to be evaluated.
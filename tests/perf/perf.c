@@ -341,6 +341,31 @@ setup_data_offset_tree(const struct lys_module *mod, uint32_t count, struct test
     return LY_SUCCESS;
 }
 
+static LY_ERR
+setup_data_ref_tree(const struct lys_module *mod, uint32_t count, struct test_state *state)
+{
+    LY_ERR ret;
+    uint32_t i;
+    char ref_val[32];
+
+    state->mod = mod;
+    state->count = count;
+
+    if ((ret = create_list_inst(mod, 0, count, &state->data1))) {
+        return ret;
+    }
+
+    /* "ref" leaf-list with @p count terms, each referencing a list instance */
+    for (i = 0; i < count; ++i) {
+        sprintf(ref_val, "%" PRIu32, i);
+        if ((ret = lyd_new_term(state->data1, NULL, "ref", ref_val, 0, NULL))) {
+            return ret;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
 /* TEST CB */
 static LY_ERR
 test_create_new_text(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end, uint32_t *size)
@@ -725,6 +750,27 @@ test_xpath_find_hash(struct test_state *state, struct timespec *ts_start, struct
     return LY_SUCCESS;
 }
 
+static LY_ERR
+test_xpath_find_comp_single(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end, uint32_t *size)
+{
+    LY_ERR r;
+    struct ly_set *set;
+
+    *size = 0;
+
+    TEST_START(ts_start);
+
+    if ((r = lyd_find_xpath(state->data1, "/perf:cont/ref[. < 100][. = /perf:cont/lst/k1]", &set))) {
+        return r;
+    }
+
+    TEST_END(ts_end);
+
+    ly_set_free(set, NULL);
+
+    return LY_SUCCESS;
+}
+
 static LY_ERR
 test_compare_same(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end, uint32_t *size)
 {
@@ -857,6 +903,7 @@ struct test tests[] = {
     {"create new bin", setup_basic, test_create_new_bin},
     {"create path", setup_basic, test_create_path},
     {"validate", setup_data_single_tree, test_validate},
+    {"validate must comparison single", setup_data_ref_tree, test_validate},
     {"parse xml mem validate", setup_data_single_tree, test_parse_xml_mem_validate},
     {"parse xml mem no validate", setup_data_single_tree, test_parse_xml_mem_no_validate},
     {"parse xml file no validate format", setup_data_single_tree, test_parse_xml_file_no_validate_format},
@@ -875,6 +922,7 @@ struct test tests[] = {
     {"free", setup_basic, test_free},
     {"xpath find", setup_data_single_tree, test_xpath_find},
     {"xpath find hash", setup_data_single_tree, test_xpath_find_hash},
+    {"xpath find comparison single", setup_data_ref_tree, test_xpath_find_comp_single},
     {"compare same", setup_data_same_trees, test_compare_same},
     {"diff same", setup_data_same_trees, test_diff_same},
     {"diff no same", setup_data_no_same_trees, test_diff_no_same},
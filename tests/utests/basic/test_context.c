@@ -1117,6 +1117,65 @@ test_explicit_compile(void **state)
     assert_non_null(mod);
 }
 
+static void
+test_get_models_hashed(void **state)
+{
+    struct ly_ctx *printed_ctx;
+    struct lys_module *mod;
+    char str[128], name[16], ns[16];
+    void *mem, *mem_end;
+    int size;
+    uint32_t i;
+
+    /* recreate the context, using builtin/static plugins only */
+    ly_ctx_destroy(UTEST_LYCTX);
+    assert_int_equal(LY_SUCCESS, ly_ctx_new(NULL, LY_CTX_BUILTIN_PLUGINS_ONLY | LY_CTX_STATIC_PLUGINS_ONLY, &UTEST_LYCTX));
+
+    /* many modules */
+    for (i = 0; i < 100; ++i) {
+        sprintf(str, "module m%" PRIu32 " {namespace urn:m%" PRIu32 ";prefix m;}", i, i);
+        assert_int_equal(LY_SUCCESS, lys_parse_mem(UTEST_LYCTX, str, LYS_IN_YANG, NULL));
+    }
+    for (i = 0; i < 100; ++i) {
+        sprintf(name, "m%" PRIu32, i);
+        sprintf(ns, "urn:m%" PRIu32, i);
+        mod = ly_ctx_get_module_implemented(UTEST_LYCTX, name);
+        assert_non_null(mod);
+        assert_string_equal(mod->name, name);
+        assert_ptr_equal(mod, ly_ctx_get_module_implemented_ns(UTEST_LYCTX, ns));
+        assert_ptr_equal(mod, ly_ctx_get_module(UTEST_LYCTX, name, NULL));
+        assert_ptr_equal(mod, ly_ctx_get_module_latest_ns(UTEST_LYCTX, ns));
+    }
+    assert_null(ly_ctx_get_module(UTEST_LYCTX, "m100", NULL));
+    assert_null(ly_ctx_get_module_ns(UTEST_LYCTX, "urn:m", NULL));
+
+    /* failed module is removed */
+    assert_int_equal(LY_EVALID, lys_parse_mem(UTEST_LYCTX, "module x {namespace urn:x;prefix x;leaf l {type unknown;}}",
+            LYS_IN_YANG, NULL));
+    CHECK_LOG_CTX("Referenced type \"unknown\" not found.", "/x:l", 0);
+    assert_null(ly_ctx_get_module(UTEST_LYCTX, "x", NULL));
+    assert_null(ly_ctx_get_module_ns(UTEST_LYCTX, "urn:x", NULL));
+
+    /* printed context */
+    size = ly_ctx_compiled_size(UTEST_LYCTX);
+    mem = malloc(size);
+    assert_non_null(mem);
+    assert_int_equal(LY_SUCCESS, ly_ctx_compiled_print(UTEST_LYCTX, mem, &mem_end));
+    assert_int_equal(LY_SUCCESS, ly_ctx_new_printed(mem, &printed_ctx));
+    for (i = 0; i < 100; i += 7) {
+        sprintf(name, "m%" PRIu32, i);
+        sprintf(ns, "urn:m%" PRIu32, i);
+        mod = ly_ctx_get_module_implemented(printed_ctx, name);
+        assert_non_null(mod);
+        assert_ptr_equal(mod->ctx, printed_ctx);
+        assert_ptr_equal(mod, ly_ctx_get_module_implemented_ns(printed_ctx, ns));
+    }
+    assert_null(ly_ctx_get_module(printed_ctx, "x", NULL));
+
+    ly_ctx_destroy(printed_ctx);
+    free(mem);
+}
+
 static void
 test_free_parsed(void **state)
 {
@@ -1135,6 +1194,7 @@ main(void)
         UTEST(test_imports),
         UTEST(test_includes),
         UTEST(test_get_models),
+        UTEST(test_get_models_hashed),
         UTEST(test_ylmem),
         UTEST(test_set_priv_parsed),
         UTEST(test_explicit_compile),
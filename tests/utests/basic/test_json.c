@@ -535,6 +535,31 @@ test_string(void **state)
     CHECK_LOG_CTX("Missing quotation-mark at the end of a JSON string.", NULL, 1);
     CHECK_LOG_CTX("Unexpected end-of-input.", NULL, 1);
 
+    /* plain string is referenced directly */
+    str = "\"plain {string}, with: [structural] characters\"";
+    assert_non_null(ly_in_memory(in, str));
+    assert_int_equal(LY_SUCCESS, lyjson_ctx_new(UTEST_LYCTX, in, &jsonctx));
+    assert_int_equal(LYJSON_STRING, lyjson_ctx_status(jsonctx));
+    assert_int_equal(0, jsonctx->dynamic);
+    assert_int_equal(45, jsonctx->value_len);
+    assert_ptr_equal(str + 1, jsonctx->value);
+    lyjson_ctx_free(jsonctx);
+
+    /* plain runs around escapes and non-ASCII characters */
+    str = "\"first run\\u0041second run\\néthird run\"";
+    assert_non_null(ly_in_memory(in, str));
+    assert_int_equal(LY_SUCCESS, lyjson_ctx_new(UTEST_LYCTX, in, &jsonctx));
+    assert_int_equal(LYJSON_STRING, lyjson_ctx_status(jsonctx));
+    assert_int_equal(1, jsonctx->dynamic);
+    assert_string_equal("first runAsecond run\néthird run", jsonctx->value);
+    lyjson_ctx_free(jsonctx);
+
+    /* control character in a plain run */
+    str = "\"plain\x01\"";
+    assert_non_null(ly_in_memory(in, str));
+    assert_int_equal(LY_EVALID, lyjson_ctx_new(UTEST_LYCTX, in, &jsonctx));
+    CHECK_LOG_CTX("Invalid character 0x1.", NULL, 1);
+
     ly_in_free(in, 0);
 }
 
@@ -526,8 +526,36 @@ test_text(void **state)
     CHECK_LOG_CTX("Invalid character reference \"&#xffff;\'\" (0x0000ffff).", NULL, 1);
     ly_in_free(in, 0);
 
+    /* runs of plain ASCII characters */
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory("=\'    \'", &in));
+    xmlctx->in = in;
+    ly_log_location(NULL, NULL, in);
+    xmlctx->status = LYXML_ATTRIBUTE;
+    assert_int_equal(LY_SUCCESS, lyxml_ctx_next(xmlctx));
+    assert_int_equal(4, xmlctx->value_len);
+    assert_int_equal(xmlctx->ws_only, 1);
+    ly_in_free(in, 0);
+
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory("=\'  a-b \"c\"\'", &in));
+    xmlctx->in = in;
+    ly_log_location(NULL, NULL, in);
+    xmlctx->status = LYXML_ATTRIBUTE;
+    assert_int_equal(LY_SUCCESS, lyxml_ctx_next(xmlctx));
+    assert_true(!strncmp("  a-b \"c\"", xmlctx->value, xmlctx->value_len));
+    assert_int_equal(xmlctx->ws_only, 0);
+    assert_int_equal(xmlctx->dynamic, 0);
+    ly_in_free(in, 0);
+
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory("=\'abc\x01" "def\'", &in));
+    xmlctx->in = in;
+    ly_log_location(NULL, NULL, in);
+    xmlctx->status = LYXML_ATTRIBUTE;
+    assert_int_equal(LY_EVALID, lyxml_ctx_next(xmlctx));
+    CHECK_LOG_CTX("Invalid character 0x1.", NULL, 1);
+    ly_in_free(in, 0);
+
     lyxml_ctx_free(xmlctx);
-    ly_log_location_revert(0, 0, 9);
+    ly_log_location_revert(0, 0, 12);
 }
 
 static void
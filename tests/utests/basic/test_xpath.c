@@ -14,6 +14,8 @@
 #define _UTEST_MAIN_
 #include "utests.h"
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "context.h"
@@ -648,6 +650,395 @@ test_canonize(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_comp_hash(void **state)
+{
+    const char *schema =
+            "module h {namespace urn:tests:h;prefix h;yang-version 1.1;"
+            "list l {key k; leaf k {type uint16;} leaf ref {type string;}}"
+            "leaf-list s {type string;}"
+            "leaf-list r {type uint16; must \". = /h:l/k\";}}";
+    char *data, *ptr, buf[8];
+    struct lys_module *mod;
+    struct lyd_node *tree, *node;
+    struct ly_set *set;
+    uint32_t i;
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, &mod);
+
+    data = malloc(100 * 96);
+    assert_non_null(data);
+    ptr = data;
+    for (i = 0; i < 100; ++i) {
+        ptr += sprintf(ptr, "<l xmlns=\"urn:tests:h\"><k>%u</k><ref>0%u</ref></l><s xmlns=\"urn:tests:h\">s%u</s>",
+                i, i * 2, i);
+    }
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX, data, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &tree));
+    free(data);
+
+    /* values canonized by the uint16 type */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/h:l[ref = /h:l/k]", &set));
+    assert_int_equal(50, set->count);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/h:l[ref != /h:l/k]", &set));
+    assert_int_equal(100, set->count);
+    ly_set_free(set, NULL);
+
+    /* values compared as strings */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/h:l[k = /h:l/ref]", &set));
+    assert_int_equal(0, set->count);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/h:l[concat('s', k) = /h:s]", &set));
+    assert_int_equal(100, set->count);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/h:s[. = /h:s[. = 's7']]", &set));
+    assert_int_equal(1, set->count);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/h:s[/h:s != /h:s]", &set));
+    assert_int_equal(100, set->count);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/h:s[/h:l/k = /h:s]", &set));
+    assert_int_equal(0, set->count);
+    ly_set_free(set, NULL);
+
+    /* single values compared with the memoized table of the same path during validation */
+    for (i = 0; i < 100; i += 3) {
+        sprintf(buf, "0%u", i);
+        assert_int_equal(LY_SUCCESS, lyd_new_term(NULL, mod, "r", buf, 0, &node));
+        assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+    }
+    assert_int_equal(LY_SUCCESS, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_new_term(NULL, mod, "r", "100", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX("Must condition \". = /h:l/k\" not satisfied.", "/h:r[.='100']", 0);
+
+    lyd_free_all(tree);
+}
+
+static void
+test_child_instances(void **state)
+{
+    const char *schema =
+            "module c {namespace urn:tests:c;prefix c;yang-version 1.1;"
+            "container cont {leaf a {type string;} list l {key k; leaf k {type uint16;} leaf v {type string;}}"
+            "leaf-list ll {type uint16;} list kl {config false; leaf x {type string;}} leaf z {type string;}}}";
+    char *data, *ptr;
+    struct lyd_node *tree;
+    struct ly_set *set;
+    uint32_t i;
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+
+    data = malloc(50 * 160 + 128);
+    assert_non_null(data);
+    ptr = data;
+    ptr += sprintf(ptr, "<cont xmlns=\"urn:tests:c\"><a>a</a><z>z</z>");
+    for (i = 0; i < 50; ++i) {
+        ptr += sprintf(ptr, "<l><k>%u</k><v>%s</v></l><ll>%u</ll><kl><x>%u</x></kl>", i, (i % 5) ? "x" : "y", i, i);
+    }
+    sprintf(ptr, "</cont>");
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX, data, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &tree));
+    free(data);
+
+    /* all the instances */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:cont/l", &set));
+    assert_int_equal(50, set->count);
+    assert_string_equal("0", lyd_get_value(lyd_child(set->dnodes[0])));
+    assert_string_equal("49", lyd_get_value(lyd_child(set->dnodes[49])));
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:cont/ll", &set));
+    assert_int_equal(50, set->count);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:cont/kl/x", &set));
+    assert_int_equal(50, set->count);
+    ly_set_free(set, NULL);
+
+    /* non-key predicates and positions */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:cont/l[v='y']/k", &set));
+    assert_int_equal(10, set->count);
+    assert_string_equal("45", lyd_get_value(set->dnodes[9]));
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:cont/l[last()]/k", &set));
+    assert_int_equal(1, set->count);
+    assert_string_equal("49", lyd_get_value(set->dnodes[0]));
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:cont/ll[. > 47]", &set));
+    assert_int_equal(2, set->count);
+    ly_set_free(set, NULL);
+
+    /* steps inside predicates */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:cont[count(l) = 50][count(kl) = count(ll)]/a", &set));
+    assert_int_equal(1, set->count);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:cont/l[k = ../kl/x][v = 'y']", &set));
+    assert_int_equal(10, set->count);
+    ly_set_free(set, NULL);
+
+    lyd_free_all(tree);
+}
+
+static void
+test_desc_index(void **state)
+{
+    const char *schema =
+            "module d {namespace urn:tests:d;prefix d;yang-version 1.1;"
+            "container top {leaf v {type string;} list l {key k; leaf k {type uint16;} leaf v {type string;}"
+            "container in {leaf v {type string;} leaf w {type string;}}} container st {config false; leaf v {type string;}}}"
+            "leaf v {type string;}}";
+    const char *paths[] = {"//v", "//d:v", "/d:top//v", "//l/in/v", "//w", "//k[. > 25]", "//none"};
+    char *data, *ptr;
+    struct lyd_node *tree, *node;
+    struct ly_set *set, *sets[7];
+    uint32_t i, j;
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+
+    data = malloc(30 * 128 + 256);
+    assert_non_null(data);
+    ptr = data;
+    ptr += sprintf(ptr, "<top xmlns=\"urn:tests:d\"><v>top</v>");
+    for (i = 0; i < 30; ++i) {
+        ptr += sprintf(ptr, "<l><k>%u</k><v>l%u</v><in><v>in%u</v>%s</in></l>", i, i, i, (i % 3) ? "" : "<w>w</w>");
+    }
+    sprintf(ptr, "<st><v>st</v></st></top><v xmlns=\"urn:tests:d\">v</v>");
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX, data, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &tree));
+    free(data);
+
+    /* the same results in the same order with the index */
+    for (i = 0; i < 7; ++i) {
+        assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, paths[i], &sets[i]));
+    }
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_XPATH_DESC_INDEX));
+    for (i = 0; i < 7; ++i) {
+        assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, paths[i], &set));
+        assert_int_equal(sets[i]->count, set->count);
+        for (j = 0; j < set->count; ++j) {
+            assert_ptr_equal(sets[i]->dnodes[j], set->dnodes[j]);
+        }
+        ly_set_free(set, NULL);
+        ly_set_free(sets[i], NULL);
+    }
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "//v", &set));
+    assert_int_equal(63, set->count);
+    assert_string_equal("top", lyd_get_value(set->dnodes[0]));
+    assert_string_equal("in0", lyd_get_value(set->dnodes[2]));
+    assert_string_equal("v", lyd_get_value(set->dnodes[62]));
+    ly_set_free(set, NULL);
+
+    /* context node */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/d:top/l[k='5']", &set));
+    assert_int_equal(1, set->count);
+    node = set->dnodes[0];
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(node, ".//v", &set));
+    assert_int_equal(2, set->count);
+    assert_string_equal("in5", lyd_get_value(set->dnodes[1]));
+    ly_set_free(set, NULL);
+
+    /* changes invalidate the index */
+    assert_int_equal(LY_SUCCESS, lyd_new_path(node, NULL, "in/w", "new", 0, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "//w", &set));
+    assert_int_equal(11, set->count);
+    assert_string_equal("new", lyd_get_value(set->dnodes[2]));
+    ly_set_free(set, NULL);
+    lyd_free_tree(lyd_child(lyd_child(node)->next->next));
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(node, ".//v", &set));
+    assert_int_equal(1, set->count);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "//v", &set));
+    assert_int_equal(62, set->count);
+    ly_set_free(set, NULL);
+    lyd_free_tree(node);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "//v", &set));
+    assert_int_equal(61, set->count);
+    ly_set_free(set, NULL);
+
+    /* changes without the option are not tracked, the indexes must not be reused */
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_XPATH_DESC_INDEX));
+    lyd_free_tree(lyd_child(tree));
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_XPATH_DESC_INDEX));
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "//v", &set));
+    assert_int_equal(60, set->count);
+    assert_string_equal("l0", lyd_get_value(set->dnodes[0]));
+    ly_set_free(set, NULL);
+
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_XPATH_DESC_INDEX));
+    lyd_free_all(tree);
+}
+
+static void
+test_iter(void **state)
+{
+    const char *schema_d =
+            "module d {namespace urn:tests:d;prefix d;yang-version 1.1;"
+            "container top {leaf v {type string;} list l {key k; leaf k {type uint16;} leaf v {type string;}"
+            "container in {leaf v {type string;}}}}"
+            "container top2 {leaf v {type string;}} leaf v {type string;}}";
+    const char *schema_e =
+            "module e {namespace urn:tests:e;prefix e;yang-version 1.1;import d {prefix d;}"
+            "augment /d:top {leaf v {type string;}}}";
+    const char *paths[] = {"/d:top/v", "/d:top/e:v", "//v", "//e:v", "/d:top//v", "//l/in/v", "/d:top/l//d:v", "*",
+        "/d:top/*", "/e:*", "//l[k > 5]/v", "/d:top/l/in/v | /d:top/v", "//none", "/*/v", "//l/v", "/d:*/v"};
+    struct lyd_xpath_iter *iter;
+    struct lyd_node *tree, *node;
+    struct ly_set *set;
+    char *data, *ptr;
+    uint32_t i, j;
+
+    UTEST_ADD_MODULE(schema_d, LYS_IN_YANG, NULL, NULL);
+    UTEST_ADD_MODULE(schema_e, LYS_IN_YANG, NULL, NULL);
+
+    data = malloc(10 * 128 + 256);
+    assert_non_null(data);
+    ptr = data;
+    ptr += sprintf(ptr, "<top xmlns=\"urn:tests:d\"><v>top</v><v xmlns=\"urn:tests:e\">e</v>");
+    for (i = 0; i < 10; ++i) {
+        ptr += sprintf(ptr, "<l><k>%u</k><v>l%u</v><in><v>in%u</v></in></l>", i, i, i);
+    }
+    sprintf(ptr, "</top><top2 xmlns=\"urn:tests:d\"><v>top2</v></top2><v xmlns=\"urn:tests:d\">v</v>");
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX, data, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &tree));
+    free(data);
+
+    /* the same results in the same order as when evaluated at once */
+    for (i = 0; i < sizeof paths / sizeof *paths; ++i) {
+        assert_int_equal(LY_SUCCESS, lyd_find_xpath3(NULL, tree, paths[i], LY_VALUE_JSON, NULL, NULL, &set));
+        assert_int_equal(LY_SUCCESS, lyd_xpath_iter_new(NULL, tree, paths[i], LY_VALUE_JSON, NULL, NULL, &iter));
+        for (j = 0; j < set->count; ++j) {
+            assert_int_equal(LY_SUCCESS, lyd_xpath_iter_next(iter, &node));
+            assert_ptr_equal(set->dnodes[j], node);
+        }
+        assert_int_equal(LY_ENOTFOUND, lyd_xpath_iter_next(iter, &node));
+        assert_int_equal(LY_ENOTFOUND, lyd_xpath_iter_next(iter, &node));
+        lyd_xpath_iter_free(iter);
+        ly_set_free(set, NULL);
+    }
+
+    /* unprefixed name inherits the module of the parent */
+    assert_int_equal(LY_SUCCESS, lyd_xpath_iter_new(NULL, tree, "/d:top/v", LY_VALUE_JSON, NULL, NULL, &iter));
+    assert_int_equal(LY_SUCCESS, lyd_xpath_iter_next(iter, &node));
+    assert_string_equal("top", lyd_get_value(node));
+    assert_int_equal(LY_ENOTFOUND, lyd_xpath_iter_next(iter, &node));
+    lyd_xpath_iter_free(iter);
+
+    /* unprefixed name after a wildcard matches any module if its parents differ */
+    assert_int_equal(LY_SUCCESS, lyd_xpath_iter_new(NULL, tree, "/*/v", LY_VALUE_JSON, NULL, NULL, &iter));
+    assert_int_equal(LY_SUCCESS, lyd_xpath_iter_next(iter, &node));
+    assert_string_equal("top", lyd_get_value(node));
+    assert_int_equal(LY_SUCCESS, lyd_xpath_iter_next(iter, &node));
+    assert_string_equal("e", lyd_get_value(node));
+    assert_int_equal(LY_SUCCESS, lyd_xpath_iter_next(iter, &node));
+    assert_string_equal("top2", lyd_get_value(node));
+    assert_int_equal(LY_ENOTFOUND, lyd_xpath_iter_next(iter, &node));
+    lyd_xpath_iter_free(iter);
+
+    /* context node and stopping early */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/d:top/l[k='3']", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_xpath_iter_new(node, tree, "in/v", LY_VALUE_JSON, NULL, NULL, &iter));
+    assert_int_equal(LY_SUCCESS, lyd_xpath_iter_next(iter, &node));
+    assert_string_equal("in3", lyd_get_value(node));
+    assert_int_equal(LY_ENOTFOUND, lyd_xpath_iter_next(iter, &node));
+    lyd_xpath_iter_free(iter);
+    assert_int_equal(LY_SUCCESS, lyd_xpath_iter_new(NULL, tree, "//v", LY_VALUE_JSON, NULL, NULL, &iter));
+    assert_int_equal(LY_SUCCESS, lyd_xpath_iter_next(iter, &node));
+    assert_string_equal("top", lyd_get_value(node));
+    lyd_xpath_iter_free(iter);
+
+    /* errors */
+    assert_int_equal(LY_EINVAL, lyd_xpath_iter_new(NULL, tree, "count(//v)", LY_VALUE_JSON, NULL, NULL, &iter));
+    CHECK_LOG_CTX("XPath \"count(//v)\" result is not a node set.", NULL, 0);
+    assert_null(iter);
+    assert_int_equal(LY_EVALID, lyd_xpath_iter_new(NULL, tree, "/x:top", LY_VALUE_JSON, NULL, NULL, &iter));
+    CHECK_LOG_CTX("Unknown/non-implemented module \"x\".", NULL, 0);
+
+    lyd_free_all(tree);
+}
+
+static void
+test_count_exist(void **state)
+{
+    const char *schema =
+            "module c {namespace urn:tests:c;prefix c;yang-version 1.1;"
+            "container top {list entry {key k; leaf k {type uint16;} leaf disabled {type empty;}"
+            "leaf-list tag {type string;}} leaf max {type uint16;}}"
+            "container srt {leaf-list ll {type string;} leaf a {type string;} leaf b {type string;}"
+            "leaf d {type string;}}}";
+    const struct {
+        const char *xpath;
+        double num;
+    } nums[] = {
+        {"count(/c:top/entry)", 20}, {"count(/c:top/c:entry/tag)", 30}, {"count(/c:top/entry/disabled)", 5},
+        {"count(/c:top/*)", 21}, {"count(/c:top/entry[k < 10]/tag)", 15}, {"count(/c:top/none)", 0},
+        {"count(//tag)", 30}, {"count(/c:top/entry[disabled])", 5}, {"count(/c:top/entry[not(disabled)])", 15},
+        {"count(/c:top/entry[tag]/..)", 1}, {"count(/c:top/entry/tag/../k)", 10}
+    };
+    const struct {
+        const char *xpath;
+        ly_bool bln;
+    } blns[] = {
+        {"boolean(/c:top/entry)", 1}, {"not(/c:top/entry)", 0}, {"boolean(/c:top/entry/disabled)", 1},
+        {"not(/c:top/none)", 1}, {"boolean(/c:top/entry[k = 3]/disabled)", 0}, {"/c:top/max <= count(/c:top/entry)", 1}
+    };
+    struct lyd_node *tree;
+    struct ly_set *set;
+    char *data, *ptr;
+    long double num;
+    ly_bool bln;
+    uint32_t i;
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+
+    data = malloc(20 * 128 + 128);
+    assert_non_null(data);
+    ptr = data;
+    ptr += sprintf(ptr, "<top xmlns=\"urn:tests:c\">");
+    for (i = 0; i < 20; ++i) {
+        ptr += sprintf(ptr, "<entry><k>%u</k>%s%s</entry>", i, (i % 4) ? "" : "<disabled/>",
+                (i % 2) ? "" : "<tag>a</tag><tag>b</tag><tag>c</tag>");
+    }
+    sprintf(ptr, "<max>20</max></top>");
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX, data, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &tree));
+    free(data);
+
+    /* counted or tested for existence without creating the node sets */
+    for (i = 0; i < sizeof nums / sizeof *nums; ++i) {
+        assert_int_equal(LY_SUCCESS, lyd_eval_xpath4(tree, tree, NULL, nums[i].xpath, LY_VALUE_JSON, NULL, NULL, NULL,
+                NULL, NULL, &num, NULL));
+        assert_true(num == nums[i].num);
+    }
+    for (i = 0; i < sizeof blns / sizeof *blns; ++i) {
+        assert_int_equal(LY_SUCCESS, lyd_eval_xpath(tree, blns[i].xpath, &bln));
+        assert_int_equal(blns[i].bln, bln);
+    }
+
+    /* existence-only predicates */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:top/entry[disabled]/k", &set));
+    assert_int_equal(5, set->count);
+    assert_string_equal("4", lyd_get_value(set->dnodes[1]));
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:top/entry[not(../max)]", &set));
+    assert_int_equal(0, set->count);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/c:top/entry[tag][not(disabled)]", &set));
+    assert_int_equal(5, set->count);
+    ly_set_free(set, NULL);
+
+    /* not a node set */
+    assert_int_equal(LY_EVALID, lyd_eval_xpath(tree, "count(5)", &bln));
+    CHECK_LOG_CTX("Wrong type of argument #1 (number) for the XPath function count(node-set).", "/c:top", 0);
+
+    lyd_free_all(tree);
+
+    /* sorted leaf-list instances under a parent with a children hash table */
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX,
+            "{\"c:srt\":{\"ll\":[\"z\",\"y\",\"a\"],\"a\":\"1\",\"b\":\"2\",\"d\":\"3\"}}", LYD_JSON,
+            LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &tree));
+    assert_int_equal(LY_SUCCESS, lyd_eval_xpath4(tree, tree, NULL, "count(/c:srt/ll)", LY_VALUE_JSON, NULL, NULL, NULL,
+            NULL, NULL, &num, NULL));
+    assert_true(num == 3);
+    lyd_free_all(tree);
+}
+
 static void
 test_derived_from(void **state)
 {
@@ -1301,6 +1692,11 @@ main(void)
         UTEST(test_toplevel, setup),
         UTEST(test_atomize, setup),
         UTEST(test_canonize, setup),
+        UTEST(test_comp_hash, setup),
+        UTEST(test_child_instances, setup),
+        UTEST(test_desc_index, setup),
+        UTEST(test_iter, setup),
+        UTEST(test_count_exist, setup),
         UTEST(test_derived_from, setup),
         UTEST(test_augment, setup),
         UTEST(test_variables, setup),
@@ -16,6 +16,7 @@
 #include "utests.h"
 
 #include "libyang.h"
+#include "tree_data_internal.h"
 
 #define CHECK_PARSE_LYD(INPUT, OUTPUT) \
         CHECK_PARSE_LYD_PARAM(INPUT, LYD_XML, LYD_PARSE_ONLY, 0, LY_SUCCESS, OUTPUT)
@@ -624,6 +625,247 @@ test_nested_list(void **state)
     lyd_free_all(diff);
 }
 
+static void
+test_digest(void **state)
+{
+    struct lyd_node *data1, *data2, *diff1, *diff2;
+    const char *xml1, *xml2;
+    char *str1, *str2;
+    uint64_t d1, d2;
+
+    (void) state;
+
+    xml1 =
+            "<df xmlns=\"urn:libyang:tests:defaults\">"
+            "  <list>"
+            "    <name>n0</name>"
+            "    <value>26</value>"
+            "    <list2>"
+            "      <name2>n22</name2>"
+            "      <value2>26</value2>"
+            "    </list2>"
+            "  </list>"
+            "  <list>"
+            "    <name>n1</name>"
+            "    <value>25</value>"
+            "    <list2>"
+            "      <name2>n22</name2>"
+            "      <value2>26</value2>"
+            "    </list2>"
+            "  </list>"
+            "  <list>"
+            "    <name>n2</name>"
+            "    <value>25</value>"
+            "  </list>"
+            "</df>";
+    xml2 =
+            "<df xmlns=\"urn:libyang:tests:defaults\">"
+            "  <list>"
+            "    <name>n0</name>"
+            "    <value>26</value>"
+            "    <list2>"
+            "      <name2>n22</name2>"
+            "      <value2>26</value2>"
+            "    </list2>"
+            "  </list>"
+            "  <list>"
+            "    <name>n1</name>"
+            "    <value>25</value>"
+            "    <list2>"
+            "      <name2>n22</name2>"
+            "      <value2>27</value2>"
+            "    </list2>"
+            "  </list>"
+            "  <list>"
+            "    <name>n2</name>"
+            "    <value>25</value>"
+            "  </list>"
+            "</df>";
+
+    CHECK_PARSE_LYD(xml1, data1);
+    CHECK_PARSE_LYD(xml2, data2);
+
+    /* pruning equal subtrees must not change the diff */
+    CHECK_PARSE_LYD_DIFF(data1, data2, 0, diff1);
+    CHECK_PARSE_LYD_DIFF(data1, data2, LYD_DIFF_DIGEST, diff2);
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str1, diff1, LYD_XML, LYD_PRINT_SIBLINGS));
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str2, diff2, LYD_XML, LYD_PRINT_SIBLINGS));
+    assert_string_equal(str1, str2);
+    free(str1);
+    free(str2);
+    assert_int_equal(LY_SUCCESS, lyd_digest(data1, &d1));
+    assert_int_equal(LY_SUCCESS, lyd_digest(data2, &d2));
+    assert_true(d1 != d2);
+
+    /* cached digests are invalidated by applying the diff */
+    assert_int_equal(lyd_diff_apply_all(&data1, diff1), LY_SUCCESS);
+    assert_int_equal(LY_SUCCESS, lyd_digest(data1, &d1));
+    assert_true(d1 == d2);
+    lyd_free_all(diff2);
+    assert_int_equal(LY_SUCCESS, lyd_diff_siblings(data1, data2, LYD_DIFF_DIGEST, &diff2));
+    assert_null(diff2);
+
+    lyd_free_all(data1);
+    lyd_free_all(data2);
+    lyd_free_all(diff1);
+}
+
+static void
+test_parallel(void **state)
+{
+    const struct lys_module *mod;
+    struct lyd_node *data1, *data2, *diff1, *diff2, *node;
+    char *str1, *str2, name[16], value[16];
+    int i;
+
+    (void) state;
+
+    mod = ly_ctx_get_module_implemented(UTEST_LYCTX, "defaults");
+    assert_non_null(mod);
+
+    /* many list instances to be split into several tasks */
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, mod, "df", 0, &data1));
+    for (i = 0; i < 1000; ++i) {
+        sprintf(name, "n%d", i);
+        sprintf(value, "%d", i);
+        assert_int_equal(LY_SUCCESS, lyd_new_list(data1, NULL, "list", 0, &node, name));
+        assert_int_equal(LY_SUCCESS, lyd_new_term(node, NULL, "value", value, 0, NULL));
+    }
+    assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, UTEST_LYCTX, "/defaults:hidden/foo", "1", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_insert_sibling(data1, node, &data1));
+    assert_int_equal(LY_SUCCESS, lyd_dup_siblings(data1, NULL, LYD_DUP_RECURSIVE, &data2));
+
+    /* change some of them */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data2, "/defaults:df/list[name='n10']/value", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "100"));
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data2, "/defaults:df/list[name='n500']", 0, &node));
+    lyd_free_tree(node);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data2, "/defaults:df/list[name='n999']", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_new_list(node, NULL, "list2", 0, NULL, "x"));
+    assert_int_equal(LY_SUCCESS, lyd_new_path(data2, NULL, "/defaults:df/list[name='n1000']/value", "1000", 0, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_new_path(data2, NULL, "/defaults:hidden/foo", "2", LYD_NEW_PATH_UPDATE, NULL));
+
+    /* the diff must be the same */
+    CHECK_PARSE_LYD_DIFF(data1, data2, 0, diff1);
+    CHECK_PARSE_LYD_DIFF(data1, data2, LYD_DIFF_PARALLEL, diff2);
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str1, diff1, LYD_XML, LYD_PRINT_SIBLINGS));
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str2, diff2, LYD_XML, LYD_PRINT_SIBLINGS));
+    assert_string_equal(str1, str2);
+    free(str1);
+    free(str2);
+
+    /* and it must be applicable */
+    assert_int_equal(LY_SUCCESS, lyd_diff_apply_all(&data1, diff2));
+    CHECK_LYD(data1, data2);
+
+    lyd_free_all(data1);
+    lyd_free_all(data2);
+    lyd_free_all(diff1);
+    lyd_free_all(diff2);
+}
+
+static LY_ERR
+apply_batch_cb(const struct lyd_node *UNUSED(diff_node), struct lyd_node *UNUSED(data_node), void *cb_data)
+{
+    ++*(uint32_t *)cb_data;
+    return LY_SUCCESS;
+}
+
+static void
+test_apply_batch(void **state)
+{
+    const struct lys_module *mod;
+    struct lyd_node *data1, *data2, *data3, *diff, *node;
+    char name[16];
+    uint32_t count = 0;
+    int i;
+
+    (void) state;
+
+    mod = ly_ctx_get_module_implemented(UTEST_LYCTX, "defaults");
+    assert_non_null(mod);
+
+    /* even instances in the first tree, every third instance in the second tree, in reverse order */
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, mod, "df", 0, &data1));
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, mod, "df", 0, &data2));
+    for (i = 0; i < 600; ++i) {
+        sprintf(name, "n%d", i);
+        if (!(i % 2)) {
+            assert_int_equal(LY_SUCCESS, lyd_new_list(data1, NULL, "list", 0, &node, name));
+            assert_int_equal(LY_SUCCESS, lyd_new_term(node, NULL, "value", "1", 0, NULL));
+        }
+        sprintf(name, "n%d", 599 - i);
+        if (!((599 - i) % 3)) {
+            assert_int_equal(LY_SUCCESS, lyd_new_list(data2, NULL, "list", 0, &node, name));
+            assert_int_equal(LY_SUCCESS, lyd_new_term(node, NULL, "value", "2", 0, NULL));
+        }
+    }
+    assert_int_equal(LY_SUCCESS, lyd_dup_siblings(data1, NULL, LYD_DUP_RECURSIVE, &data3));
+
+    CHECK_PARSE_LYD_DIFF(data1, data2, 0, diff);
+
+    /* batched */
+    assert_int_equal(LY_SUCCESS, lyd_diff_apply_all(&data1, diff));
+    CHECK_LYD(data1, data2);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data1, "/defaults:df/list[name='n3']/value", 0, &node));
+    assert_string_equal(lyd_get_value(node), "2");
+    assert_int_equal(LY_EINCOMPLETE, lyd_find_path(data1, "/defaults:df/list[name='n2']", 0, &node));
+
+    /* in order with a callback */
+    assert_int_equal(LY_SUCCESS, lyd_diff_apply_module(&data3, diff, NULL, apply_batch_cb, &count));
+    CHECK_LYD(data3, data2);
+    assert_true(count > 0);
+
+    lyd_free_all(data1);
+    lyd_free_all(data2);
+    lyd_free_all(data3);
+    lyd_free_all(diff);
+}
+
+static void
+test_apply_batch_fail(void **state)
+{
+    const struct lys_module *mod;
+    struct lyd_node *data1, *data2, *data3, *diff, *node, *hidden;
+    char name[16];
+    int i;
+
+    (void) state;
+
+    mod = ly_ctx_get_module_implemented(UTEST_LYCTX, "defaults");
+    assert_non_null(mod);
+
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, mod, "df", 0, &data1));
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, mod, "df", 0, &data2));
+    for (i = 0; i < 20; ++i) {
+        sprintf(name, "n%d", i);
+        if (!(i % 2)) {
+            assert_int_equal(LY_SUCCESS, lyd_new_list(data1, NULL, "list", 0, NULL, name));
+        }
+        assert_int_equal(LY_SUCCESS, lyd_new_list(data2, NULL, "list", 0, NULL, name));
+    }
+    assert_int_equal(LY_SUCCESS, lyd_dup_siblings(data1, NULL, LYD_DUP_RECURSIVE, &data3));
+    CHECK_PARSE_LYD_DIFF(data1, data2, 0, diff);
+
+    /* the last created node cannot be inserted into the parent */
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, mod, "hidden", 0, &hidden));
+    assert_int_equal(LY_SUCCESS, lyd_new_term(hidden, NULL, "foo", "1", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_unlink_tree(node));
+    assert_int_equal(LY_SUCCESS, lyd_new_meta(UTEST_LYCTX, node, NULL, "yang:operation", "create", 0, NULL));
+    lyd_insert_node(diff, NULL, node, LYD_INSERT_NODE_LAST);
+
+    /* no created node is inserted */
+    assert_int_equal(LY_EINVAL, lyd_diff_apply_all(&data1, diff));
+    CHECK_LOG_CTX("Cannot insert, parent of \"foo\" is not \"df\".", NULL, 0);
+    CHECK_LYD(data1, data3);
+
+    lyd_free_all(data1);
+    lyd_free_all(data2);
+    lyd_free_all(data3);
+    lyd_free_all(diff);
+    lyd_free_all(hidden);
+}
+
 static void
 test_userord_llist(void **state)
 {
@@ -1746,6 +1988,10 @@ main(void)
         UTEST(test_leaf, setup),
         UTEST(test_list, setup),
         UTEST(test_nested_list, setup),
+        UTEST(test_digest, setup),
+        UTEST(test_parallel, setup),
+        UTEST(test_apply_batch, setup),
+        UTEST(test_apply_batch_fail, setup),
         UTEST(test_userord_llist, setup),
         UTEST(test_userord_llist2, setup),
         UTEST(test_userord_mix, setup),
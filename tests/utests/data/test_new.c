@@ -203,6 +203,204 @@ test_top_level(void **state)
     lyd_free_tree(rpc);
 }
 
+static void
+test_bin_keys(void **state)
+{
+    struct lys_module *mod;
+    struct lyd_node *tree, *cont, *node, *match;
+    const struct lysc_node *schema;
+    const struct lyd_value *vals[2];
+    const uint8_t key_bin[4] = {42, 0, 0, 0};
+    const void *key_vals[] = {key_bin};
+    uint32_t val_sizes[] = {32, 0};
+    char buf[8];
+    uint32_t i;
+
+    UTEST_ADD_MODULE(schema_a, LYS_IN_YANG, NULL, &mod);
+
+    /* binary key values */
+    assert_int_equal(lyd_new_list3(NULL, mod, "l11", key_vals, val_sizes, LYD_NEW_VAL_BIN, &tree), LY_SUCCESS);
+    assert_string_equal(lyd_get_value(lyd_child(tree)), "42");
+    assert_int_equal(lyd_new_list(NULL, mod, "l11", LYD_NEW_VAL_BIN, &node, "\x07\0\0\0", 32), LY_SUCCESS);
+    assert_int_equal(lyd_insert_sibling(tree, node, &tree), LY_SUCCESS);
+    assert_int_equal(lyd_new_term(NULL, mod, "foo", "1", LYD_NEW_VAL_BIN, &node), LY_EINVAL);
+    CHECK_LOG_CTX("Invalid argument !(options & 0x0200) (lyd_new_term()).", NULL, 0);
+
+    schema = tree->schema;
+    assert_int_equal(lyd_find_sibling_bin(tree, schema, key_vals, val_sizes, &match), LY_SUCCESS);
+    assert_string_equal(lyd_get_value(lyd_child(match)), "42");
+    key_vals[0] = "\x07\0\0\0";
+    assert_int_equal(lyd_find_sibling_bin(tree, schema, key_vals, val_sizes, &match), LY_SUCCESS);
+    assert_string_equal(lyd_get_value(lyd_child(match)), "7");
+    key_vals[0] = "\x08\0\0\0";
+    assert_int_equal(lyd_find_sibling_bin(tree, schema, key_vals, val_sizes, &match), LY_ENOTFOUND);
+    assert_null(match);
+
+    /* stored key values */
+    vals[0] = &((struct lyd_node_term *)lyd_child(tree))->value;
+    assert_int_equal(lyd_find_sibling_stored(tree, schema, vals, &match), LY_SUCCESS);
+    assert_ptr_equal(match, tree);
+    lyd_free_all(tree);
+    assert_int_equal(lyd_new_list_stored(NULL, mod, "l11", NULL, 0, &tree), LY_EINVAL);
+    CHECK_LOG_CTX("Missing list \"l11\" keys.", NULL, 0);
+
+    /* hashed siblings */
+    assert_int_equal(lyd_new_inner(NULL, mod, "c", 0, &cont), LY_SUCCESS);
+    for (i = 0; i < 20; ++i) {
+        sprintf(buf, "x%" PRIu32, i);
+        assert_int_equal(lyd_new_term(cont, NULL, "x", buf, 0, NULL), LY_SUCCESS);
+    }
+    schema = lyd_child(cont)->schema;
+    key_vals[0] = "x13";
+    val_sizes[0] = 24;
+    assert_int_equal(lyd_find_sibling_bin(lyd_child(cont), schema, key_vals, val_sizes, &match), LY_SUCCESS);
+    assert_string_equal(lyd_get_value(match), "x13");
+    vals[0] = &((struct lyd_node_term *)match)->value;
+    assert_int_equal(lyd_find_sibling_stored(lyd_child(cont), schema, vals, &node), LY_SUCCESS);
+    assert_ptr_equal(match, node);
+    key_vals[0] = "x20";
+    assert_int_equal(lyd_find_sibling_bin(lyd_child(cont), schema, key_vals, val_sizes, &match), LY_ENOTFOUND);
+
+    /* list created from the stored values of another list */
+    assert_int_equal(lyd_new_list(NULL, mod, "l1", 0, &tree, "a", "b"), LY_SUCCESS);
+    vals[0] = &((struct lyd_node_term *)lyd_child(tree))->value;
+    vals[1] = &((struct lyd_node_term *)lyd_child(tree)->next)->value;
+    assert_int_equal(lyd_new_list_stored(NULL, mod, "l1", vals, 0, &node), LY_SUCCESS);
+    assert_int_equal(lyd_compare_single(tree, node, 0), LY_SUCCESS);
+    assert_int_equal(tree->hash, node->hash);
+    lyd_free_tree(node);
+    assert_int_equal(lyd_find_sibling_stored(tree, tree->schema, vals, &match), LY_SUCCESS);
+    assert_ptr_equal(match, tree);
+
+    lyd_free_all(tree);
+    lyd_free_all(cont);
+}
+
+static void
+test_batch(void **state)
+{
+    struct lys_module *mod;
+    struct lyd_node *tree = NULL, *cont, *node, *iter;
+    struct lyd_batch *batch;
+    struct ly_set *set;
+    char buf[8];
+    const void *key_vals[] = {buf};
+    uint32_t i, val;
+
+    UTEST_ADD_MODULE(schema_a, LYS_IN_YANG, NULL, &mod);
+
+    /* existing instances with a sorting tree */
+    for (i = 1000; i < 1003; ++i) {
+        sprintf(buf, "%" PRIu32, i);
+        assert_int_equal(lyd_new_list3(NULL, mod, "l11", key_vals, NULL, 0, &node), LY_SUCCESS);
+        assert_int_equal(lyd_insert_sibling(tree, node, &tree), LY_SUCCESS);
+    }
+    assert_int_equal(lyd_new_term(NULL, mod, "foo", "1", 0, &node), LY_SUCCESS);
+    assert_int_equal(lyd_insert_sibling(tree, node, &tree), LY_SUCCESS);
+
+    /* new instances in reverse order */
+    assert_int_equal(lyd_batch_new(UTEST_LYCTX, NULL, 10, LYD_BATCH_DUP_CHECK, &batch), LY_SUCCESS);
+    for (i = 100; i > 0; --i) {
+        sprintf(buf, "%" PRIu32, i - 1);
+        assert_int_equal(lyd_batch_new_list(batch, mod, "l11", key_vals, NULL, 0, &node), LY_SUCCESS);
+        assert_int_equal(lyd_new_term(node, NULL, "b", buf, 0, NULL), LY_SUCCESS);
+    }
+    assert_int_equal(lyd_batch_insert(batch, &tree), LY_SUCCESS);
+
+    /* all sorted */
+    i = 0;
+    LY_LIST_FOR(tree, iter) {
+        if (iter->schema->nodetype != LYS_LIST) {
+            continue;
+        }
+        val = ((struct lyd_node_term *)lyd_child(iter))->value.uint32;
+        assert_int_equal(val, (i < 100) ? i : 900 + i);
+        ++i;
+    }
+    assert_int_equal(i, 103);
+    assert_int_equal(lyd_find_sibling_val(tree, tree->schema, "[a='42']", 0, &node), LY_SUCCESS);
+    assert_string_equal(lyd_get_value(lyd_child(node)->next), "42");
+    assert_int_equal(lyd_new_list(NULL, mod, "l11", 0, &node, "50"), LY_SUCCESS);
+    assert_int_equal(lyd_find_sibling_first(tree, node, &iter), LY_SUCCESS);
+    lyd_free_tree(node);
+
+    /* duplicates */
+    assert_int_equal(lyd_batch_new(UTEST_LYCTX, NULL, 0, LYD_BATCH_DUP_CHECK, &batch), LY_SUCCESS);
+    assert_int_equal(lyd_batch_new_list(batch, mod, "l11", key_vals, NULL, 0, NULL), LY_SUCCESS);
+    assert_int_equal(lyd_batch_new_list(batch, mod, "l11", key_vals, NULL, 0, NULL), LY_SUCCESS);
+    assert_int_equal(lyd_batch_insert(batch, &tree), LY_EVALID);
+    CHECK_LOG_CTX("Duplicate instance of \"l11\".", "/a:l11[a='0']", 0);
+    lyd_batch_free(batch);
+
+    assert_int_equal(lyd_batch_new(UTEST_LYCTX, NULL, 0, LYD_BATCH_DUP_CHECK, &batch), LY_SUCCESS);
+    key_vals[0] = "1001";
+    assert_int_equal(lyd_batch_new_list(batch, mod, "l11", key_vals, NULL, 0, NULL), LY_SUCCESS);
+    assert_int_equal(lyd_batch_insert(batch, &tree), LY_EVALID);
+    CHECK_LOG_CTX("Duplicate instance of \"l11\".", "/a:l11[a='1001']", 0);
+    lyd_batch_free(batch);
+
+    /* few instances inserted into the existing sorting tree */
+    assert_int_equal(lyd_batch_new(UTEST_LYCTX, NULL, 0, 0, &batch), LY_SUCCESS);
+    key_vals[0] = "500";
+    assert_int_equal(lyd_batch_new_list(batch, mod, "l11", key_vals, NULL, 0, &node), LY_SUCCESS);
+    assert_int_equal(lyd_batch_insert(batch, &tree), LY_SUCCESS);
+    assert_string_equal(lyd_get_value(lyd_child(node->prev)), "99");
+    assert_string_equal(lyd_get_value(lyd_child(node->next)), "1000");
+
+    /* nested nodes */
+    assert_int_equal(lyd_new_inner(NULL, mod, "c2", 0, &cont), LY_SUCCESS);
+    assert_int_equal(lyd_batch_new(NULL, cont, 0, LYD_BATCH_DUP_CHECK, &batch), LY_SUCCESS);
+    for (i = 0; i < 10; ++i) {
+        assert_int_equal(lyd_batch_new_list(batch, NULL, "l3", NULL, NULL, 0, &node), LY_SUCCESS);
+    }
+    assert_int_equal(lyd_new_term(NULL, mod, "foo", "2", 0, &node), LY_SUCCESS);
+    assert_int_equal(lyd_batch_add(batch, node), LY_EINVAL);
+    CHECK_LOG_CTX("Cannot insert, parent of \"foo\" is not \"c2\".", NULL, 0);
+    lyd_free_tree(node);
+    assert_int_equal(lyd_batch_insert(batch, NULL), LY_SUCCESS);
+    i = 0;
+    LY_LIST_FOR(lyd_child(cont), iter) {
+        ++i;
+    }
+    assert_int_equal(i, 10);
+    assert_non_null(((struct lyd_node_inner *)cont)->children_ht);
+
+    lyd_free_all(tree);
+    lyd_free_all(cont);
+
+    /* out-of-order instances under a parent with a children HT */
+    UTEST_ADD_MODULE("module b {namespace urn:tests:b;prefix b;"
+            "container c {leaf a {type string;} leaf b {type string;} leaf d {type string;}"
+            "list l {key k; leaf k {type uint32;}}}}", LYS_IN_YANG, NULL, &mod);
+    key_vals[0] = buf;
+    for (i = 0; i < 2; ++i) {
+        assert_int_equal(lyd_new_path(NULL, UTEST_LYCTX, "/b:c/a", "1", 0, &cont), LY_SUCCESS);
+        assert_int_equal(lyd_new_term(cont, NULL, "b", "2", 0, NULL), LY_SUCCESS);
+        assert_int_equal(lyd_new_term(cont, NULL, "d", "3", 0, NULL), LY_SUCCESS);
+        if (i) {
+            assert_int_equal(lyd_new_list(cont, NULL, "l", 0, NULL, "50"), LY_SUCCESS);
+        }
+
+        assert_int_equal(lyd_batch_new(NULL, cont, 9, LYD_BATCH_DUP_CHECK, &batch), LY_SUCCESS);
+        for (val = 9; val > 0; --val) {
+            sprintf(buf, "%" PRIu32, val);
+            assert_int_equal(lyd_batch_new_list(batch, NULL, "l", key_vals, NULL, 0, NULL), LY_SUCCESS);
+        }
+        assert_int_equal(lyd_batch_insert(batch, NULL), LY_SUCCESS);
+        assert_non_null(((struct lyd_node_inner *)cont)->children_ht);
+
+        assert_int_equal(lyd_find_xpath(cont, "/b:c/l", &set), LY_SUCCESS);
+        assert_int_equal(set->count, i ? 10 : 9);
+        ly_set_free(set, NULL);
+        node = lyd_child(cont)->next->next->next;
+        assert_int_equal(lyd_find_sibling_val(lyd_child(cont), node->schema, NULL, 0, &node), LY_SUCCESS);
+        assert_string_equal(lyd_get_value(lyd_child(node)), "1");
+
+        lyd_free_all(cont);
+        CHECK_LOG_CTX(NULL, NULL, 0);
+    }
+}
+
 static void
 test_opaq(void **state)
 {
@@ -566,6 +764,8 @@ main(void)
 {
     const struct CMUnitTest tests[] = {
         UTEST(test_top_level),
+        UTEST(test_bin_keys),
+        UTEST(test_batch),
         UTEST(test_opaq),
         UTEST(test_path),
         UTEST(test_path_ext),
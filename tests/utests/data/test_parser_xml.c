@@ -22,6 +22,7 @@
 #include "printer_data.h"
 #include "tree_data_internal.h"
 #include "tree_schema.h"
+#include "tree_schema_internal.h"
 
 static int
 setup(void **state)
@@ -1102,6 +1103,83 @@ test_subtree(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_snode_index(void **state)
+{
+    const char *data;
+    struct ly_in *in;
+    struct lyd_node *tree, *op, *node, *child;
+
+    /* sibling list instances resolve the same schema nodes repeatedly, all of them are in the schema child index */
+    data = "<l1 xmlns=\"urn:tests:a\"><a>one</a><b>one</b><c>1</c><d>x</d></l1>\n"
+            "<l1 xmlns=\"urn:tests:a\"><a>two</a><b>two</b><c>2</c><d>y</d></l1>\n"
+            "<l1 xmlns=\"urn:tests:a\"><a>three</a><b>three</b><c>3</c><d>z</d></l1>\n";
+    CHECK_PARSE_LYD(data, 0, LYD_VALIDATE_PRESENT, tree);
+    LY_LIST_FOR(tree, node) {
+        LY_LIST_FOR(lyd_child(node), child) {
+            assert_ptr_equal(child->schema, lysc_child_index_find(node->schema, child->schema->module,
+                    child->schema->name, strlen(child->schema->name), 0));
+        }
+    }
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/a:l1[a='three'][b='three'][c='3']/d", 0, &node));
+    assert_string_equal("z", lyd_get_value(node));
+    lyd_free_all(tree);
+
+    /* the input and output leaves of an action share a name, but not a schema node nor an index record */
+    data = "<c xmlns=\"urn:tests:a\"><act><al>value</al></act></c>";
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+    assert_int_equal(LY_SUCCESS, lyd_parse_op(UTEST_LYCTX, NULL, in, LYD_XML, LYD_TYPE_RPC_YANG, 0, &tree, &op));
+    ly_in_free(in, 0);
+    assert_int_equal(LYS_INPUT, lyd_child(op)->schema->parent->nodetype);
+    assert_ptr_equal(lyd_child(op)->schema, lysc_child_index_find(op->schema, op->schema->module, "al", 2, 0));
+
+    data = "<c xmlns=\"urn:tests:a\"><act><al>25</al></act></c>";
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+    lyd_free_all(tree);
+    assert_int_equal(LY_SUCCESS, lyd_parse_op(UTEST_LYCTX, NULL, in, LYD_XML, LYD_TYPE_REPLY_YANG, 0, &tree, &op));
+    ly_in_free(in, 0);
+    assert_int_equal(LYS_OUTPUT, lyd_child(op)->schema->parent->nodetype);
+    assert_ptr_equal(lyd_child(op)->schema, lysc_child_index_find(op->schema, op->schema->module, "al", 2,
+            LYS_GETNEXT_OUTPUT));
+    assert_int_equal(25, ((struct lyd_node_term *)lyd_child(op))->value.uint8);
+    lyd_free_all(tree);
+}
+
+static void
+test_ref_input(void **state)
+{
+    char *data;
+    struct lyd_node *tree, *dup;
+    struct lyd_node_term *leaf;
+
+    data = strdup("<foo xmlns=\"urn:tests:a\">foo value</foo><foo2 xmlns=\"urn:tests:a\">a &amp; b</foo2>");
+    assert_non_null(data);
+    CHECK_PARSE_LYD(data, LYD_PARSE_REF_INPUT, LYD_VALIDATE_PRESENT, tree);
+
+    /* value without escapes is only referenced */
+    leaf = (struct lyd_node_term *)tree;
+    assert_string_equal("foo", leaf->schema->name);
+    assert_null(leaf->value._canonical);
+
+    /* escaped value is in the dictionary */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/a:foo2", 0, (struct lyd_node **)&leaf));
+    assert_string_equal("a & b", leaf->value._canonical);
+
+    /* duplicate does not reference the input */
+    assert_int_equal(LY_SUCCESS, lyd_dup_single(tree, NULL, 0, &dup));
+    assert_string_equal("foo value", ((struct lyd_node_term *)dup)->value._canonical);
+
+    /* inserted into the dictionary when needed */
+    leaf = (struct lyd_node_term *)tree;
+    assert_string_equal("foo value", lyd_get_value(tree));
+    assert_ptr_equal(leaf->value._canonical, ((struct lyd_node_term *)dup)->value._canonical);
+    assert_int_equal(LY_SUCCESS, lyd_compare_single(tree, dup, 0));
+
+    lyd_free_tree(dup);
+    lyd_free_all(tree);
+    free(data);
+}
+
 int
 main(void)
 {
@@ -1126,6 +1204,8 @@ main(void)
         UTEST(test_data_skip, setup),
         UTEST(test_metadata, setup),
         UTEST(test_subtree, setup),
+        UTEST(test_snode_index, setup),
+        UTEST(test_ref_input, setup),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -372,6 +372,190 @@ test_dup(void **state)
     lyd_free_all(tree1);
 }
 
+static void
+test_snapshot(void **state)
+{
+    struct lyd_node *tree, *node;
+    const struct lyd_node *first;
+    struct lyd_snapshot *snap1, *snap2;
+    const char *data;
+
+    data = "<foo xmlns=\"urn:tests:a\">x</foo><l1 xmlns=\"urn:tests:a\"><a>a</a><b>b</b><c>c</c></l1>";
+    CHECK_PARSE_LYD(data, 0, LYD_VALIDATE_PRESENT, tree);
+    assert_int_equal(LY_SUCCESS, lyd_snapshot_new(tree->next, &snap1));
+    first = lyd_snapshot_tree(snap1);
+    assert_ptr_equal(tree, first);
+
+    /* single reference, edited in place */
+    assert_int_equal(LY_SUCCESS, lyd_snapshot_unshare(snap1, &tree));
+    assert_ptr_equal(tree, first);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/a:foo", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "y"));
+    assert_int_equal(LY_SUCCESS, lyd_snapshot_new(tree, &snap1));
+
+    /* shared reference, copied on edit */
+    assert_int_equal(LY_SUCCESS, lyd_snapshot_dup(snap1, &snap2));
+    assert_ptr_equal(snap1, snap2);
+    assert_int_equal(LY_SUCCESS, lyd_snapshot_unshare(snap2, &tree));
+    assert_ptr_not_equal(tree, first);
+    assert_int_equal(LY_SUCCESS, lyd_compare_siblings(tree, first, LYD_COMPARE_FULL_RECURSION));
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/a:l1[a='a'][b='b']/c", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "d"));
+    assert_int_equal(LY_SUCCESS, lyd_snapshot_new(tree, &snap2));
+
+    /* original snapshot unchanged */
+    CHECK_LYD_STRING_PARAM(lyd_snapshot_tree(snap1),
+            "<l1 xmlns=\"urn:tests:a\"><a>a</a><b>b</b><c>c</c></l1><foo xmlns=\"urn:tests:a\">y</foo>",
+            LYD_XML, LYD_PRINT_SIBLINGS | LYD_PRINT_SHRINK);
+    CHECK_LYD_STRING_PARAM(lyd_snapshot_tree(snap2),
+            "<l1 xmlns=\"urn:tests:a\"><a>a</a><b>b</b><c>d</c></l1><foo xmlns=\"urn:tests:a\">y</foo>",
+            LYD_XML, LYD_PRINT_SIBLINGS | LYD_PRINT_SHRINK);
+    lyd_snapshot_free(snap1);
+    lyd_snapshot_free(snap2);
+
+    /* empty */
+    assert_int_equal(LY_SUCCESS, lyd_snapshot_new(NULL, &snap1));
+    assert_null(lyd_snapshot_tree(snap1));
+    assert_int_equal(LY_SUCCESS, lyd_snapshot_dup(snap1, &snap2));
+    assert_int_equal(LY_SUCCESS, lyd_snapshot_unshare(snap1, &tree));
+    assert_null(tree);
+    lyd_snapshot_free(snap2);
+}
+
+static void
+test_freeze(void **state)
+{
+    struct lyd_node *tree, *thawed, *node, *diff;
+    const struct lyd_node *frozen_tree;
+    struct lyd_frozen *frozen;
+    struct ly_set *set;
+    const char *data;
+
+    data = "<ll xmlns=\"urn:tests:a\">2</ll><ll xmlns=\"urn:tests:a\">1</ll><foo xmlns=\"urn:tests:a\">x</foo>"
+            "<l1 xmlns=\"urn:tests:a\"><a>b</a><b>b</b><c>1</c></l1><l1 xmlns=\"urn:tests:a\"><a>a</a><b>b</b></l1>"
+            "<c xmlns=\"urn:tests:a\"><x>1</x><x>2</x><x>3</x><x>4</x><x>5</x></c>";
+    CHECK_PARSE_LYD(data, 0, LYD_VALIDATE_PRESENT, tree);
+    assert_int_equal(LY_SUCCESS, lyd_freeze(tree, &frozen));
+    frozen_tree = lyd_frozen_tree(frozen);
+
+    /* equal data without the internal sorting metadata */
+    assert_int_equal(LY_SUCCESS, lyd_compare_siblings(tree, frozen_tree, LYD_COMPARE_FULL_RECURSION | LYD_COMPARE_OPAQ));
+    assert_int_equal(LY_SUCCESS, lyd_diff_siblings(tree, frozen_tree, 0, &diff));
+    assert_null(diff);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(frozen_tree, "/a:ll[.='1']", 0, &node));
+    assert_null(node->meta);
+    assert_non_null(((struct lyd_node_inner *)frozen_tree->prev)->children_ht);
+
+    /* readable */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(frozen_tree, "/a:l1[a='b'][b='b']/c", 0, &node));
+    assert_string_equal(lyd_get_value(node), "1");
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(frozen_tree, "/a:c/x[. > 2]", &set));
+    assert_int_equal(3, set->count);
+    ly_set_free(set, NULL);
+    CHECK_LYD_STRING_PARAM(frozen_tree, "<l1 xmlns=\"urn:tests:a\"><a>a</a><b>b</b></l1>"
+            "<l1 xmlns=\"urn:tests:a\"><a>b</a><b>b</b><c>1</c></l1><foo xmlns=\"urn:tests:a\">x</foo>"
+            "<ll xmlns=\"urn:tests:a\">1</ll><ll xmlns=\"urn:tests:a\">2</ll>"
+            "<c xmlns=\"urn:tests:a\"><x>1</x><x>2</x><x>3</x><x>4</x><x>5</x></c>", LYD_XML, LYD_PRINT_SIBLINGS | LYD_PRINT_SHRINK);
+
+    /* modifiable again */
+    assert_int_equal(LY_SUCCESS, lyd_thaw(frozen, &thawed));
+    lyd_frozen_free(frozen);
+    assert_int_equal(LY_SUCCESS, lyd_compare_siblings(tree, thawed, LYD_COMPARE_FULL_RECURSION));
+    assert_int_equal(LY_SUCCESS, lyd_new_term(NULL, thawed->schema->module, "ll", "0", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_insert_sibling(thawed, node, &thawed));
+    assert_string_equal(lyd_get_value(node->next), "1");
+    lyd_free_all(thawed);
+    lyd_free_all(tree);
+
+    /* empty */
+    assert_int_equal(LY_SUCCESS, lyd_freeze(NULL, &frozen));
+    assert_null(lyd_frozen_tree(frozen));
+    assert_int_equal(LY_SUCCESS, lyd_thaw(frozen, &thawed));
+    assert_null(thawed);
+    lyd_frozen_free(frozen);
+}
+
+static void
+test_mem_usage(void **state)
+{
+    struct lyd_node *tree, *node;
+    struct lyd_mem_usage usage, usage2;
+    struct lyd_mem_usage_schema *schemas;
+    struct ly_ctx_mem_usage ctx_usage;
+    struct ly_set *set;
+    uint32_t count, i;
+    uint64_t total;
+    const char *data;
+
+    data = "<ll xmlns=\"urn:tests:a\">2</ll><ll xmlns=\"urn:tests:a\">1</ll><foo xmlns=\"urn:tests:a\">x</foo>"
+            "<l1 xmlns=\"urn:tests:a\"><a>b</a><b>b</b><c>1</c></l1><l1 xmlns=\"urn:tests:a\"><a>a</a><b>b</b></l1>"
+            "<c xmlns=\"urn:tests:a\"><x>1</x><x>2</x><x>3</x><x>4</x><x>5</x></c>";
+    CHECK_PARSE_LYD(data, 0, LYD_VALIDATE_PRESENT, tree);
+
+    /* single node */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/a:foo", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_mem_usage(node, 0, &usage, NULL, NULL));
+    assert_int_equal(1, usage.node_count);
+    assert_int_equal(sizeof(struct lyd_node_term), usage.nodes);
+
+    /* all the nodes, per schema node */
+    assert_int_equal(LY_SUCCESS, lyd_mem_usage(tree, 1, &usage, &schemas, &count));
+    assert_int_equal(16, usage.node_count);
+    assert_true(usage.hash_tables > 0);
+    assert_true(usage.lyds > 0);
+    assert_int_equal(0, usage.leafref_links);
+    assert_int_equal(8, count);
+    total = 0;
+    for (i = 0; i < count; ++i) {
+        if (i) {
+            assert_true(schemas[i - 1].size >= schemas[i].size);
+        }
+        if (!strcmp(schemas[i].schema->name, "x")) {
+            assert_int_equal(5, schemas[i].count);
+        }
+        total += schemas[i].size;
+    }
+    assert_int_equal(usage.nodes + usage.values + usage.meta + usage.hash_tables + usage.lyds + usage.leafref_links,
+            total);
+    free(schemas);
+
+    /* the same without the per-schema statistics */
+    assert_int_equal(LY_SUCCESS, lyd_mem_usage(tree, 1, &usage2, NULL, NULL));
+    assert_int_equal(0, memcmp(&usage, &usage2, sizeof usage));
+    lyd_free_all(tree);
+
+    /* empty tree */
+    assert_int_equal(LY_SUCCESS, lyd_mem_usage(NULL, 1, &usage, &schemas, &count));
+    assert_int_equal(0, usage.node_count);
+    assert_null(schemas);
+    assert_int_equal(0, count);
+
+    /* context */
+    assert_int_equal(LY_SUCCESS, ly_ctx_mem_usage(UTEST_LYCTX, &ctx_usage));
+    assert_true(ctx_usage.compiled > 0);
+    assert_true(ctx_usage.dict > 0);
+    assert_true(ctx_usage.data_digests > 0);
+    assert_int_equal(0, ctx_usage.data_desc_index);
+
+    /* context with a descendant index */
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_XPATH_DESC_INDEX));
+    CHECK_PARSE_LYD(data, 0, LYD_VALIDATE_PRESENT, tree);
+    assert_int_equal(LY_SUCCESS, ly_ctx_mem_usage(UTEST_LYCTX, &ctx_usage));
+    total = ctx_usage.data_desc_index;
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "//x", &set));
+    assert_int_equal(5, set->count);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, ly_ctx_mem_usage(UTEST_LYCTX, &ctx_usage));
+    assert_true(ctx_usage.data_desc_index > total);
+    lyd_free_all(tree);
+    assert_int_equal(LY_SUCCESS, ly_ctx_mem_usage(UTEST_LYCTX, &ctx_usage));
+    assert_int_equal(total, ctx_usage.data_desc_index);
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_XPATH_DESC_INDEX));
+
+    assert_int_equal(LY_EINVAL, lyd_mem_usage(NULL, 1, NULL, NULL, NULL));
+    CHECK_LOG_LASTMSG("Invalid argument usage (lyd_mem_usage()).");
+}
+
 static void
 test_target(void **state)
 {
@@ -502,6 +686,124 @@ test_find_path(void **state)
     lyd_free_all(root);
 }
 
+static void
+test_find_compiled_path(void **state)
+{
+    struct lyd_node *root, *node, *match;
+    struct ly_path *p1, *p2, *p3, *p4;
+    const struct lys_module *mod;
+
+    mod = ly_ctx_get_module_implemented(UTEST_LYCTX, "c");
+    assert_non_null(mod);
+
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, mod, "cont", 0, &root));
+    assert_int_equal(LY_SUCCESS, lyd_new_path(root, NULL, "/c:cont/nexthop[gateway='10.0.0.1']", NULL, 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_new_path(root, NULL, "/c:cont/nexthop[gateway='2100::1']", NULL, 0, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_new_path(root, NULL, "/c:cont/pref[.='fc00::/64']", NULL, 0, NULL));
+
+    assert_int_equal(LY_SUCCESS, lyd_compile_path(UTEST_LYCTX, NULL, "/c:cont/nexthop[gateway='10.0.0.1']", 0, &p1));
+    assert_int_equal(LY_SUCCESS, lyd_compile_path(UTEST_LYCTX, NULL, "/c:cont/pref[.='fc00::/64']", 0, &p2));
+    assert_int_equal(LY_SUCCESS, lyd_compile_path(NULL, root->schema, "nexthop[gateway='2100::1']/gateway", 0, &p3));
+    assert_int_equal(LY_SUCCESS, lyd_compile_path(UTEST_LYCTX, NULL, "/c:cont/nexthop[gateway='10.0.0.2']/gateway", 0, &p4));
+
+    /* the paths can be used repeatedly */
+    assert_int_equal(LY_SUCCESS, lyd_find_compiled_path(root, p1, &match));
+    assert_ptr_equal(node, match);
+    assert_int_equal(LY_SUCCESS, lyd_find_compiled_path(lyd_child(root), p1, &match));
+    assert_ptr_equal(node, match);
+    assert_int_equal(LY_SUCCESS, lyd_find_compiled_path(root, p2, &match));
+    assert_string_equal("fc00::/64", lyd_get_value(match));
+    assert_int_equal(LY_SUCCESS, lyd_find_compiled_path(root, p3, &match));
+    assert_string_equal("2100::1", lyd_get_value(match));
+    assert_int_equal(LY_EINCOMPLETE, lyd_find_compiled_path(root, p4, &match));
+    assert_ptr_equal(root, match);
+
+    /* changed data */
+    lyd_free_tree(node);
+    assert_int_equal(LY_EINCOMPLETE, lyd_find_compiled_path(root, p1, &match));
+    assert_int_equal(LY_SUCCESS, lyd_new_path(root, NULL, "/c:cont/nexthop[gateway='10.0.0.2']", NULL, 0, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_find_compiled_path(root, p4, &match));
+    assert_string_equal("10.0.0.2", lyd_get_value(match));
+
+    lyd_free_compiled_path(p1);
+    lyd_free_compiled_path(p2);
+    lyd_free_compiled_path(p3);
+    lyd_free_compiled_path(p4);
+
+    /* errors */
+    assert_int_equal(LY_EVALID, lyd_compile_path(UTEST_LYCTX, NULL, "c:cont", 0, &p1));
+    CHECK_LOG_CTX("XPath \"c:cont\" was expected to be absolute.", NULL, 0);
+    assert_null(p1);
+    assert_int_equal(LY_EVALID, lyd_compile_path(UTEST_LYCTX, NULL, "/c:cont/none", 0, &p1));
+    CHECK_LOG_CTX("Not found node \"none\" in path.", "/c:cont", 0);
+
+    lyd_free_all(root);
+}
+
+static void
+test_compiled_path_bind(void **state)
+{
+    const char *schema;
+    struct lyd_node *root, *list, *node, *match;
+    struct ly_path *p1, *p2;
+    const uint8_t id_bin[4] = {5, 0, 0, 0};
+
+    schema = "module d {namespace urn:tests:d;prefix d;yang-version 1.1;"
+            "list port {key \"slot id\"; leaf slot {type string;} leaf id {type uint32;} leaf enabled {type boolean;}}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+
+    assert_int_equal(LY_SUCCESS, lyd_compile_path(UTEST_LYCTX, NULL, "/d:port[slot=$slot][id=$id]/enabled", 0, &p1));
+
+    /* unbound variables */
+    assert_int_equal(LY_EINVAL, lyd_new_compiled_path(NULL, p1, "true", 0, &root));
+    CHECK_LOG_CTX("Variable \"slot\" of the compiled path not bound.", NULL, 0);
+    assert_int_equal(LY_SUCCESS, lyd_compiled_path_bind_val(p1, "slot", "eth", 24, LY_VALUE_JSON));
+    assert_int_equal(LY_EINVAL, lyd_new_compiled_path(NULL, p1, "true", 0, &root));
+    CHECK_LOG_CTX("Variable \"id\" of the compiled path not bound.", NULL, 0);
+
+    /* native binary value */
+    assert_int_equal(LY_SUCCESS, lyd_compiled_path_bind_val(p1, "id", id_bin, 32, LY_VALUE_LYB));
+    assert_int_equal(LY_SUCCESS, lyd_new_compiled_path(NULL, p1, "true", 0, &root));
+    assert_int_equal(LY_SUCCESS, lyd_find_path(root, "/d:port[slot='eth'][id='5']/enabled", 0, &node));
+    assert_string_equal("true", lyd_get_value(node));
+    assert_int_equal(LY_SUCCESS, lyd_find_compiled_path(root, p1, &match));
+    assert_ptr_equal(node, match);
+    assert_int_equal(LY_EEXIST, lyd_new_compiled_path(root, p1, "false", 0, NULL));
+    CHECK_LOG_CTX("Path \"/d:port/enabled\" already exists.", "/d:port[slot='eth'][id='5']/enabled", 0);
+
+    /* rebound value */
+    assert_int_equal(LY_SUCCESS, lyd_compiled_path_bind_val(p1, "id", "6", 8, LY_VALUE_JSON));
+    assert_int_equal(LY_ENOTFOUND, lyd_find_compiled_path(root, p1, &match));
+    assert_int_equal(LY_SUCCESS, lyd_new_compiled_path(root, p1, "false", 0, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_find_compiled_path(root, p1, &match));
+    assert_string_equal("false", lyd_get_value(match));
+    assert_string_equal("6", lyd_get_value(lyd_child(lyd_parent(match))->next));
+
+    /* stored value */
+    list = lyd_parent(node);
+    assert_int_equal(LY_SUCCESS, lyd_compiled_path_bind(p1, "id", &((struct lyd_node_term *)lyd_child(list)->next)->value));
+    assert_int_equal(LY_SUCCESS, lyd_find_compiled_path(root, p1, &match));
+    assert_ptr_equal(node, match);
+
+    /* errors */
+    assert_int_equal(LY_ENOTFOUND, lyd_compiled_path_bind_val(p1, "name", "eth", 24, LY_VALUE_JSON));
+    CHECK_LOG_CTX("Variable \"name\" not used in the path.", NULL, 0);
+    assert_int_equal(LY_EVALID, lyd_compiled_path_bind_val(p1, "id", "x", 8, LY_VALUE_JSON));
+    CHECK_LOG_CTX("Invalid type uint32 value \"x\".", "/d:port/id", 0);
+    assert_int_equal(LY_SUCCESS, lyd_find_compiled_path(root, p1, &match));
+    assert_ptr_equal(node, match);
+
+    /* variables mixed with values */
+    assert_int_equal(LY_SUCCESS, lyd_compile_path(UTEST_LYCTX, NULL, "/d:port[slot='eth'][id=$id]", 0, &p2));
+    assert_int_equal(LY_SUCCESS, lyd_compiled_path_bind_val(p2, "id", "6", 8, LY_VALUE_JSON));
+    assert_int_equal(LY_SUCCESS, lyd_find_compiled_path(root, p2, &match));
+    assert_string_equal("false", lyd_get_value(lyd_child(match)->next->next));
+
+    lyd_free_compiled_path(p1);
+    lyd_free_compiled_path(p2);
+    lyd_free_all(root);
+}
+
 static void
 test_data_hash(void **state)
 {
@@ -540,6 +842,54 @@ test_data_hash(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_digest(void **state)
+{
+    struct lyd_node *tree1, *tree2, *node;
+    uint64_t d1, d2;
+    const char *data;
+
+    data = "<l2 xmlns=\"urn:tests:a\"><c><x>a</x><d>1</d><d>2</d></c></l2>";
+    CHECK_PARSE_LYD(data, LYD_PARSE_ONLY, 0, tree1);
+    CHECK_PARSE_LYD(data, LYD_PARSE_ONLY, 0, tree2);
+
+    /* equal subtrees */
+    assert_int_equal(LY_SUCCESS, lyd_digest(tree1, &d1));
+    assert_int_equal(LY_SUCCESS, lyd_digest(tree2, &d2));
+    assert_true(d1 == d2);
+    assert_int_equal(LY_SUCCESS, lyd_compare_single(tree1, tree2, LYD_COMPARE_FULL_RECURSION | LYD_COMPARE_DIGEST));
+
+    /* value change */
+    node = lyd_child(lyd_child(tree2));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "b"));
+    assert_int_equal(LY_SUCCESS, lyd_digest(tree2, &d2));
+    assert_true(d1 != d2);
+    assert_int_equal(LY_ENOT, lyd_compare_single(tree1, tree2, LYD_COMPARE_FULL_RECURSION | LYD_COMPARE_DIGEST));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "a"));
+    assert_int_equal(LY_SUCCESS, lyd_digest(tree2, &d2));
+    assert_true(d1 == d2);
+
+    /* removed node */
+    node = lyd_child(lyd_child(tree2))->next->next;
+    lyd_free_tree(node);
+    assert_int_equal(LY_SUCCESS, lyd_digest(tree2, &d2));
+    assert_true(d1 != d2);
+
+    /* new node */
+    assert_int_equal(LY_SUCCESS, lyd_new_term(lyd_child(tree2), NULL, "d", "2", 0, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_digest(tree2, &d2));
+    assert_true(d1 == d2);
+
+    /* duplicate does not inherit the cached digest */
+    assert_int_equal(LY_SUCCESS, lyd_dup_single(tree1, NULL, LYD_DUP_RECURSIVE, &node));
+    assert_int_equal(LY_SUCCESS, lyd_digest(node, &d2));
+    assert_true(d1 == d2);
+    lyd_free_tree(node);
+
+    lyd_free_all(tree1);
+    lyd_free_all(tree2);
+}
+
 static void
 test_lyxp_vars(void **UNUSED(state))
 {
@@ -842,11 +1192,17 @@ main(void)
         UTEST(test_compare, setup),
         UTEST(test_compare_diff_ctx, setup),
         UTEST(test_dup, setup),
+        UTEST(test_snapshot, setup),
+        UTEST(test_freeze, setup),
+        UTEST(test_mem_usage, setup),
         UTEST(test_target, setup),
         UTEST(test_list_pos, setup),
         UTEST(test_first_sibling, setup),
         UTEST(test_find_path, setup),
+        UTEST(test_find_compiled_path, setup),
+        UTEST(test_compiled_path_bind, setup),
         UTEST(test_data_hash, setup),
+        UTEST(test_digest, setup),
         UTEST(test_lyxp_vars),
         UTEST(test_data_leafref_nodes),
         UTEST(test_data_leafref_nodes2),
@@ -0,0 +1,147 @@
+/**
+ * @file test_tree_data_mt.c
+ * @brief Multi-threaded unit tests for concurrent reading of a single data tree
+ *
+ * Copyright (c) 2024 CESNET, z.s.p.o.
+ *
+ * This source code is licensed under BSD 3-Clause License (the "License").
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://opensource.org/licenses/BSD-3-Clause
+ */
+#define _UTEST_MAIN_
+#include "utests.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libyang.h"
+#include "ly_common.h"
+
+#define THREAD_COUNT 8
+#define ROUND_COUNT 20
+#define ITER_COUNT 10
+#define LIST_COUNT 50
+
+/**
+ * @brief Data shared by all the reader threads.
+ */
+struct mt_arg {
+    const struct lyd_node *tree;    /**< tree read concurrently, its canonical values are generated on demand */
+    const struct lyd_node *copy;    /**< equal tree with all the canonical values generated */
+    const char *xml;                /**< expected XML print of the tree */
+    const char *json;               /**< expected JSON print of the tree */
+    ATOMIC_T errors;                /**< number of failed checks */
+};
+
+static void *
+mt_reader(void *arg)
+{
+    struct mt_arg *a = arg;
+    struct ly_set *set;
+    const struct lyd_node *n1, *n2;
+    struct lyd_node *node;
+    uint64_t d1, d2;
+    char *str, path[64];
+    uint32_t i;
+
+    for (i = 0; i < ITER_COUNT; ++i) {
+        /* print */
+        if (lyd_print_mem(&str, a->tree, LYD_XML, LYD_PRINT_SIBLINGS) || strcmp(str, a->xml)) {
+            ATOMIC_INC_RELAXED(a->errors);
+        }
+        free(str);
+        if (lyd_print_mem(&str, a->tree, LYD_JSON, LYD_PRINT_SIBLINGS) || strcmp(str, a->json)) {
+            ATOMIC_INC_RELAXED(a->errors);
+        }
+        free(str);
+
+        /* query */
+        if (lyd_find_xpath(a->tree, "/a:l[bin='AAEC']", &set) || (set->count != LIST_COUNT)) {
+            ATOMIC_INC_RELAXED(a->errors);
+        }
+        ly_set_free(set, NULL);
+        sprintf(path, "/a:l[k='key%u']/addr", (i * 7) % LIST_COUNT);
+        if (lyd_find_path(a->tree, path, 0, &node) || strcmp(lyd_get_value(node), "10.0.0.1")) {
+            ATOMIC_INC_RELAXED(a->errors);
+        }
+
+        /* compare */
+        if (lyd_compare_siblings(a->tree, a->copy, LYD_COMPARE_FULL_RECURSION)) {
+            ATOMIC_INC_RELAXED(a->errors);
+        }
+
+        /* cached digests */
+        for (n1 = a->tree, n2 = a->copy; n1 && n2; n1 = n1->next, n2 = n2->next) {
+            if (lyd_digest(n1, &d1) || lyd_digest(n2, &d2) || (d1 != d2)) {
+                ATOMIC_INC_RELAXED(a->errors);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void
+test_concurrent_read(void **state)
+{
+    const char *schema;
+    char *data, *ptr;
+    struct lyd_node *tree, *copy;
+    struct mt_arg arg = {0};
+    pthread_t threads[THREAD_COUNT];
+    uint32_t i, r;
+
+    schema = "module a {namespace urn:tests:a;prefix a;yang-version 1.1;"
+            "import ietf-inet-types {prefix inet;}"
+            "list l {key k; leaf k {type string;} leaf bin {type binary;} leaf bits {type bits {bit a; bit b; bit c;}}"
+            "leaf addr {type inet:ipv4-address;} leaf u {type union {type binary; type string;}}}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+
+    /* most of the values get their canonical form generated only when first needed */
+    data = malloc(LIST_COUNT * 192);
+    assert_non_null(data);
+    ptr = data;
+    for (i = 0; i < LIST_COUNT; ++i) {
+        ptr += sprintf(ptr, "<l xmlns=\"urn:tests:a\"><k>key%u</k><bin>AAEC</bin><bits> c  a </bits>"
+                "<addr>10.0.0.1</addr><u>AAEC</u></l>", i);
+    }
+
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, LYD_PARSE_REF_INPUT, LYD_VALIDATE_PRESENT, LY_SUCCESS, copy);
+    assert_int_equal(LY_SUCCESS, lyd_print_mem((char **)&arg.xml, copy, LYD_XML, LYD_PRINT_SIBLINGS));
+    assert_int_equal(LY_SUCCESS, lyd_print_mem((char **)&arg.json, copy, LYD_JSON, LYD_PRINT_SIBLINGS));
+    arg.copy = copy;
+
+    for (r = 0; r < ROUND_COUNT; ++r) {
+        CHECK_PARSE_LYD_PARAM(data, LYD_XML, LYD_PARSE_REF_INPUT, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+        arg.tree = tree;
+
+        for (i = 0; i < THREAD_COUNT; ++i) {
+            assert_int_equal(0, pthread_create(&threads[i], NULL, mt_reader, &arg));
+        }
+        for (i = 0; i < THREAD_COUNT; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+
+        assert_int_equal(0, ATOMIC_LOAD_RELAXED(arg.errors));
+        lyd_free_all(tree);
+    }
+
+    lyd_free_all(copy);
+    free((char *)arg.xml);
+    free((char *)arg.json);
+    free(data);
+}
+
+int
+main(void)
+{
+    const struct CMUnitTest tests[] = {
+        UTEST(test_concurrent_read),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
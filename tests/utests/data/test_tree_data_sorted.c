@@ -939,6 +939,63 @@ test_insert_multiple_keys(void **state)
     lyd_free_all(cont);
 }
 
+static void
+test_insert_multiple_key_types(void **state)
+{
+    const char *schema;
+    struct lys_module *mod;
+    struct lyd_node *cont, *node, *prev, *iter;
+    char k1[8], k2[8], k4[8];
+    uint32_t i, count;
+
+    schema = "module a {namespace urn:tests:a;prefix a;yang-version 1.1;revision 2014-05-08;"
+            "container cn { list lst {key \"k1 k2 k3 k4\";"
+            "leaf k1 {type int8;} leaf k2 {type string;} leaf k3 {type enumeration {enum z {value -1;} enum a;}}"
+            "leaf k4 {type int64;}}"
+            "list lst2 {key \"k1 k2\"; leaf k1 {type boolean;} leaf k2 {type union {type uint8; type string;}}}}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, &mod);
+
+    assert_int_equal(lyd_new_inner(NULL, mod, "cn", 0, &cont), LY_SUCCESS);
+    for (i = 0; i < 200; ++i) {
+        sprintf(k1, "%d", (int)((i * 7) % 11) - 5);
+        sprintf(k2, "%c%s", 'a' + (i * 3) % 5, (i % 2) ? "x" : "");
+        sprintf(k4, "%d", (int)((i * 13) % 17) - 8);
+        assert_int_equal(lyd_new_list(cont, mod, "lst", 0, NULL, k1, k2, (i % 3) ? "a" : "z", k4), LY_SUCCESS);
+        if (i < 40) {
+            sprintf(k2, "%s%" PRIu32, (i % 4) ? "" : "s", (i * 17) % 40);
+            assert_int_equal(lyd_new_list(cont, mod, "lst2", 0, NULL, (i % 2) ? "true" : "false", k2), LY_SUCCESS);
+        }
+    }
+
+    /* remove some instances */
+    node = lyd_child(cont);
+    for (i = 0; node; ++i) {
+        iter = node->next;
+        if (!(i % 5)) {
+            lyd_free_tree(node);
+        }
+        node = iter;
+    }
+
+    /* sort check */
+    prev = lyd_child(cont);
+    count = 1;
+    LY_LIST_FOR(prev->next, iter) {
+        if (iter->schema == prev->schema) {
+            assert_true(lyds_compare_single(prev, iter) <= 0);
+        }
+        prev = iter;
+        ++count;
+    }
+    assert_int_equal(count, 240 - 48);
+
+    /* negative values first */
+    node = lyd_child(cont);
+    assert_string_equal(lyd_get_value(lyd_child(node)), "-5");
+
+    lyd_free_all(cont);
+}
+
 static void
 test_merge_siblings(void **state)
 {
@@ -1166,6 +1223,101 @@ test_parse_ordered_data(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_parse_many_nodes(void **state)
+{
+    const char *schema;
+    char *data, *end, buf[16];
+    struct lys_module *mod;
+    struct lyd_node *tree, *iter, *prev, *node;
+    uint32_t i, j, count;
+
+    schema = "module a {namespace urn:tests:a;prefix a;yang-version 1.1;revision 2014-05-08;"
+            "container cn {leaf-list ll {type uint32;} list lst {key \"k\"; leaf k {type uint32;}}}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, &mod);
+
+    data = malloc(300 * 64);
+    assert_non_null(data);
+
+    for (j = 0; j < 2; ++j) {
+        /* the first data are sorted, the second are not */
+        end = data + sprintf(data, "<cn xmlns=\"urn:tests:a\">");
+        for (i = 0; i < 300; ++i) {
+            end += sprintf(end, "<ll>%" PRIu32 "</ll>", j ? (i * 37) % 300 : i);
+        }
+        for (i = 0; i < 300; ++i) {
+            end += sprintf(end, "<lst><k>%" PRIu32 "</k></lst>", j ? (i * 71) % 300 : i);
+        }
+        strcpy(end, "</cn>");
+        CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+
+        /* leaders have the BST */
+        node = lyd_child(tree);
+        assert_string_equal(node->meta->name, META_NAME);
+        assert_non_null(get_rbt(node->meta));
+        assert_string_equal(lyd_get_value(node), "0");
+
+        /* the BST is usable for inserting and removing */
+        assert_int_equal(lyd_new_term(tree, NULL, "ll", "1000", 0, NULL), LY_SUCCESS);
+        assert_int_equal(lyd_new_list(tree, NULL, "lst", 0, NULL, "1000"), LY_SUCCESS);
+        for (i = 0; i < 300; i += 3) {
+            sprintf(buf, "%" PRIu32, i);
+            assert_int_equal(lyd_find_sibling_val(lyd_child(tree), lyd_child(tree)->schema, buf, 0, &iter), LY_SUCCESS);
+            lyd_free_tree(iter);
+        }
+
+        /* sort check */
+        node = lyd_child(tree);
+        prev = node;
+        count = 1;
+        LY_LIST_FOR(node->next, iter) {
+            if (iter->schema == prev->schema) {
+                assert_true(lyds_compare_single(prev, iter) < 0);
+            }
+            prev = iter;
+            ++count;
+        }
+        assert_int_equal(count, 200 + 1 + 300 + 1);
+
+        lyd_free_all(tree);
+    }
+
+    free(data);
+}
+
+static void
+test_parse_unsorted_hashed(void **state)
+{
+    const char *schema, *data;
+    struct lyd_node *tree, *node;
+    struct ly_set *set;
+    uint32_t i;
+
+    schema = "module a {namespace urn:tests:a;prefix a;yang-version 1.1;revision 2014-05-08;"
+            "container c {leaf-list ll {type string;} leaf a {type string;} leaf b {type string;}"
+            "leaf d {type string;}}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+
+    /* the parent has a children HT and the first instance changes when sorting */
+    data = "{\"a:c\":{\"ll\":[\"z\",\"y\",\"a\"],\"a\":\"1\",\"b\":\"2\",\"d\":\"3\"}}";
+    for (i = 0; i < 2; ++i) {
+        CHECK_PARSE_LYD_PARAM(data, LYD_JSON, i ? LYD_PARSE_ONLY : 0, i ? 0 : LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+        assert_non_null(((struct lyd_node_inner *)tree)->children_ht);
+
+        node = lyd_child(tree);
+        assert_string_equal(lyd_get_value(node), "a");
+        assert_int_equal(lyd_find_sibling_val(node, node->schema, NULL, 0, &node), LY_SUCCESS);
+        assert_string_equal(lyd_get_value(node), "a");
+
+        assert_int_equal(lyd_find_xpath(tree, "/a:c/ll", &set), LY_SUCCESS);
+        assert_int_equal(set->count, 3);
+        ly_set_free(set, NULL);
+
+        lyd_free_all(tree);
+        CHECK_LOG_CTX(NULL, NULL, 0);
+    }
+}
+
 static void
 test_print_data(void **state)
 {
@@ -1673,10 +1825,13 @@ main(void)
         UTEST(test_no_metadata_remains),
         UTEST(test_free_meta_single),
         UTEST(test_insert_multiple_keys),
+        UTEST(test_insert_multiple_key_types),
         UTEST(test_merge_siblings),
         UTEST(test_merge_siblings_destruct),
         UTEST(test_parse_data),
         UTEST(test_parse_ordered_data),
+        UTEST(test_parse_many_nodes),
+        UTEST(test_parse_unsorted_hashed),
         UTEST(test_print_data),
         UTEST(test_manipulation_of_many_nodes),
         UTEST(test_lyds_free_metadata),
@@ -15,6 +15,7 @@
 #include "utests.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "context.h"
@@ -1217,6 +1218,104 @@ test_must(void **state)
     CHECK_LOG_CTX_APPTAG("l leaf is not left", "/i:cont/l3", 0, "not-left");
 }
 
+static void
+test_must_abs_path(void **state)
+{
+    struct lyd_node *tree, *node;
+    char *data, *ptr;
+    uint32_t i;
+    const char *schema =
+            "module m {\n"
+            "    namespace urn:tests:m;\n"
+            "    prefix m;\n"
+            "    yang-version 1.1;\n"
+            "\n"
+            "    container limits {\n"
+            "        leaf max {\n"
+            "            type uint32;\n"
+            "        }\n"
+            "        leaf-list allowed {\n"
+            "            type string;\n"
+            "        }\n"
+            "    }\n"
+            "    leaf mode {\n"
+            "        type string;\n"
+            "    }\n"
+            "    list item {\n"
+            "        key name;\n"
+            "        must \"count(/m:item) <= /m:limits/m:max\";\n"
+            "        leaf name {\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf v {\n"
+            "            must \". <= /m:limits/m:max\";\n"
+            "            type uint32;\n"
+            "        }\n"
+            "        leaf t {\n"
+            "            must \"/m:limits/m:allowed = current() and /m:limits/m:allowed[. = current()]\";\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf x {\n"
+            "            when \"/m:mode = 'on'\";\n"
+            "            type string;\n"
+            "        }\n"
+            "    }\n"
+            "}";
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+
+    /* the absolute paths are evaluated only once, the results must be the same */
+    data = malloc(100 * 96 + 256);
+    assert_non_null(data);
+    ptr = data;
+    ptr += sprintf(ptr, "<limits xmlns=\"urn:tests:m\"><max>100</max><allowed>a</allowed><allowed>b</allowed></limits>"
+            "<mode xmlns=\"urn:tests:m\">on</mode>");
+    for (i = 0; i < 100; ++i) {
+        ptr += sprintf(ptr, "<item xmlns=\"urn:tests:m\"><name>i%u</name><v>%u</v><t>%s</t><x>x</x></item>", i, i,
+                (i % 2) ? "a" : "b");
+    }
+    LYD_TREE_CREATE(data, tree);
+
+    /* all the when conditions are true */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/m:item[name='i99']/x", 0, &node));
+
+    /* too many items */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/m:limits/max", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "99"));
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX("Must condition \"count(/m:item) <= /m:limits/m:max\" not satisfied.", "/m:item[name='i0']", 0);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/m:item[name='i99']", 0, &node));
+    lyd_free_tree(node);
+    assert_int_equal(LY_SUCCESS, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+
+    /* value too big */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/m:item[name='i10']/v", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "100"));
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX("Must condition \". <= /m:limits/m:max\" not satisfied.", "/m:item[name='i10']/v", 0);
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "10"));
+    assert_int_equal(LY_SUCCESS, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+
+    /* value not allowed */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/m:item[name='i50']/t", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "c"));
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX("Must condition \"/m:limits/m:allowed = current() and /m:limits/m:allowed[. = current()]\" "
+            "not satisfied.", "/m:item[name='i50']/t", 0);
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "a"));
+    assert_int_equal(LY_SUCCESS, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+
+    /* all the nodes with false when are auto-deleted */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/m:mode", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "off"));
+    assert_int_equal(LY_SUCCESS, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    assert_int_equal(LY_EINCOMPLETE, lyd_find_path(tree, "/m:item[name='i0']/x", 0, &node));
+    assert_int_equal(LY_EINCOMPLETE, lyd_find_path(tree, "/m:item[name='i98']/x", 0, &node));
+
+    lyd_free_all(tree);
+    free(data);
+}
+
 static void
 test_multi_error(void **state)
 {
@@ -1649,6 +1748,7 @@ main(void)
         UTEST(test_defaults),
         UTEST(test_state),
         UTEST(test_must),
+        UTEST(test_must_abs_path),
         UTEST(test_multi_error),
         UTEST(test_action),
         UTEST(test_rpc),
@@ -2263,6 +2263,76 @@ test_compiled_print(void **state)
     free(mem);
 }
 
+static void
+test_find_child(void **state)
+{
+    const char *str;
+    struct lys_module *mod, *mod2;
+    const struct lysc_node *cont, *snode;
+
+    str = "module a {yang-version 1.1; namespace urn:a; prefix a;"
+            "container c {"
+            "  leaf l1 {type string;}"
+            "  choice ch {"
+            "    case ca {leaf l2 {type string;}}"
+            "    leaf l3 {type string;}"
+            "  }"
+            "  action act {"
+            "    input {leaf v {type string;}}"
+            "    output {leaf v {type uint8;}}"
+            "  }"
+            "  notification n;"
+            "}"
+            "rpc r {input {leaf in {type string;}}}"
+            "}";
+    assert_int_equal(lys_parse_mem(UTEST_LYCTX, str, LYS_IN_YANG, &mod), LY_SUCCESS);
+
+    /* top-level */
+    cont = lys_find_child(NULL, NULL, mod, NULL, 0, "c", 0, 0);
+    assert_ptr_equal(cont, mod->compiled->data);
+    snode = lys_find_child(NULL, NULL, mod, NULL, 0, "r", 0, 0);
+    assert_ptr_equal(snode, mod->compiled->rpcs);
+    assert_null(lys_find_child(NULL, NULL, mod, NULL, 0, "l1", 0, 0));
+
+    /* choice and case are transparent */
+    snode = lys_find_child(NULL, cont, mod, NULL, 0, "l2", 0, 0);
+    assert_non_null(snode);
+    assert_string_equal(snode->parent->name, "ca");
+    snode = lys_find_child(NULL, cont, mod, NULL, 0, "l3", 0, 0);
+    assert_non_null(snode);
+    assert_int_equal(snode->parent->nodetype, LYS_CASE);
+    assert_null(lys_find_child(NULL, cont, mod, NULL, 0, "ch", 0, 0));
+    assert_non_null(lys_find_child(NULL, cont, mod, NULL, 0, "ch", 0, LYS_GETNEXT_WITHCHOICE));
+    assert_non_null(lys_find_child(NULL, cont, NULL, "a", 0, "l1x", 2, 0));
+
+    /* actions and notifications */
+    snode = lys_find_child(NULL, cont, mod, NULL, 0, "act", 0, 0);
+    assert_ptr_equal(snode, lysc_node_actions(cont));
+    assert_ptr_equal(lys_find_child(NULL, cont, mod, NULL, 0, "n", 0, 0), lysc_node_notifs(cont));
+
+    /* input and output */
+    snode = lys_find_child(NULL, &lysc_node_actions(cont)->node, mod, NULL, 0, "v", 0, 0);
+    assert_non_null(snode);
+    assert_int_equal(snode->parent->nodetype, LYS_INPUT);
+    snode = lys_find_child(NULL, &lysc_node_actions(cont)->node, mod, NULL, 0, "v", 0, LYS_GETNEXT_OUTPUT);
+    assert_non_null(snode);
+    assert_int_equal(snode->parent->nodetype, LYS_OUTPUT);
+
+    /* augment with the same node name, found after recompilation */
+    str = "module b {namespace urn:b; prefix b; import a {prefix a;}"
+            "augment /a:c {leaf l1 {type uint8;}}"
+            "}";
+    assert_int_equal(lys_parse_mem(UTEST_LYCTX, str, LYS_IN_YANG, &mod2), LY_SUCCESS);
+    cont = lys_find_child(NULL, NULL, mod, NULL, 0, "c", 0, 0);
+    assert_ptr_equal(cont, mod->compiled->data);
+    snode = lys_find_child(NULL, cont, mod2, NULL, 0, "l1", 0, 0);
+    assert_non_null(snode);
+    assert_ptr_equal(snode->module, mod2);
+    snode = lys_find_child(NULL, cont, mod, NULL, 0, "l1", 0, 0);
+    assert_non_null(snode);
+    assert_ptr_equal(snode->module, mod);
+}
+
 static void
 test_obsolete(void **state)
 {
@@ -2346,6 +2416,7 @@ main(void)
         UTEST(test_lysc_backlinks),
         UTEST(test_compiled_print),
         UTEST(test_obsolete),
+        UTEST(test_find_child),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -22,8 +22,10 @@
 #include <assert.h>
 #include <errno.h>
 #include <getopt.h>
+#include <inttypes.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <strings.h>
 
@@ -36,7 +38,7 @@
 static void
 cmd_data_help_header(void)
 {
-    printf("Usage: data [-emn] [-t TYPE]\n"
+    printf("Usage: data [-emMn] [-t TYPE]\n"
             "            [-F FORMAT] [-f FORMAT] [-d DEFAULTS] [-o OUTFILE] <data1> ...\n"
             "       data [-n] -t (rpc | notif | reply) [-O FILE]\n"
             "            [-F FORMAT] [-f FORMAT] [-d DEFAULTS] [-o OUTFILE] <data1> ...\n"
@@ -130,6 +132,9 @@ cmd_data_help(void)
             "  -m, --merge   Merge input data files into a single tree and validate at\n"
             "                once.The option has effect only for 'data' and 'config' TYPEs.\n"
             "                In case of using -x option, the data are always merged.\n"
+            "  -M, --mem-usage\n"
+            "                Print the memory used by the data tree(s) and the context, with\n"
+            "                the totals of the modules and the largest schema node consumers.\n"
             "  -n, --not-strict\n"
             "                Do not require strict data parsing (silently skip unknown data),\n"
             "                has no effect for schemas.\n"
@@ -164,6 +169,7 @@ cmd_data_opt(struct yl_opt *yo, const char *cmdline, char ***posv, int *posc)
         {"in-format",       required_argument, NULL, 'F'},
         {"help",            no_argument,       NULL, 'h'},
         {"merge",           no_argument,       NULL, 'm'},
+        {"mem-usage",       no_argument,       NULL, 'M'},
         {"output",          required_argument, NULL, 'o'},
         {"operational",     required_argument, NULL, 'O'},
         {"reply-rpc",       required_argument, NULL, 'R'},
@@ -236,6 +242,9 @@ cmd_data_opt(struct yl_opt *yo, const char *cmdline, char ***posv, int *posc)
         case 'm': /* --merge */
             yo->data_merge = 1;
             break;
+        case 'M': /* --mem-usage */
+            yo->data_mem_usage = 1;
+            break;
         case 'n': /* --not-strict */
             yo->data_parse_options &= ~LYD_PARSE_STRICT;
             break;
@@ -426,6 +435,69 @@ evaluate_xpath(const struct lyd_node *tree, const char *xpath)
     return 0;
 }
 
+/**
+ * @brief Print the memory used by a data tree and its context.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] tree Data tree.
+ * @param[in] path Name of the data input.
+ * @return 0 on success.
+ */
+static int
+print_mem_usage(const struct ly_ctx *ctx, const struct lyd_node *tree, const char *path)
+{
+    struct lyd_mem_usage usage;
+    struct lyd_mem_usage_schema *schemas = NULL;
+    struct ly_ctx_mem_usage ctx_usage;
+    const struct lys_module *mod;
+    uint64_t size, total;
+    uint32_t u, v, idx = 0;
+
+    if (lyd_mem_usage(tree, 1, &usage, &schemas, &v) || ly_ctx_mem_usage(ctx, &ctx_usage)) {
+        YLMSG_E("Learning memory usage failed.");
+        free(schemas);
+        return -1;
+    }
+
+    total = usage.nodes + usage.values + usage.meta + usage.hash_tables + usage.lyds + usage.leafref_links;
+    printf("Memory usage of \"%s\" (%" PRIu64 " nodes):\n", path, usage.node_count);
+    printf("  %-20s %" PRIu64 "\n", "nodes", usage.nodes);
+    printf("  %-20s %" PRIu64 "\n", "values", usage.values);
+    printf("  %-20s %" PRIu64 "\n", "metadata", usage.meta);
+    printf("  %-20s %" PRIu64 "\n", "hash tables", usage.hash_tables);
+    printf("  %-20s %" PRIu64 "\n", "sorting trees", usage.lyds);
+    printf("  %-20s %" PRIu64 "\n", "leafref links", usage.leafref_links);
+    printf("  %-20s %" PRIu64 "\n", "total", total);
+
+    printf("Modules:\n");
+    while ((mod = ly_ctx_get_module_iter(ctx, &idx))) {
+        size = 0;
+        for (u = 0; u < v; ++u) {
+            if (schemas[u].schema && (schemas[u].schema->module == mod)) {
+                size += schemas[u].size;
+            }
+        }
+        if (size) {
+            printf("  %-20s %" PRIu64 "\n", mod->name, size);
+        }
+    }
+
+    printf("Largest schema nodes:\n");
+    for (u = 0; (u < v) && (u < YL_MEM_USAGE_TOP_COUNT); ++u) {
+        printf("  %s:%s %" PRIu64 " (%" PRIu64 " instances)\n", schemas[u].schema ? schemas[u].schema->module->name : "",
+                schemas[u].schema ? schemas[u].schema->name : "<opaque>", schemas[u].size, schemas[u].count);
+    }
+
+    printf("Context:\n");
+    printf("  %-20s %" PRIu64 "\n", "compiled modules", ctx_usage.compiled);
+    printf("  %-20s %" PRIu64 "\n", "dictionary", ctx_usage.dict);
+    printf("  %-20s %" PRIu64 "\n", "data dictionary", ctx_usage.data_dict);
+    printf("  %-20s %" PRIu64 "\n", "leafref links", ctx_usage.leafref_links);
+
+    free(schemas);
+    return 0;
+}
+
 /**
  * @brief Checking that a parent data node exists in the datastore for the nested-notification and action.
  *
@@ -645,6 +717,11 @@ cmd_data_process(struct ly_ctx *ctx, struct yl_opt *yo)
             }
         }
 
+        if (!yo->data_merge && yo->data_mem_usage && print_mem_usage(ctx, tree, input_f->path)) {
+            ret = LY_EOTHER;
+            goto cleanup;
+        }
+
         /* next iter */
         lyd_free_all(tree);
         tree = NULL;
@@ -663,6 +740,11 @@ cmd_data_process(struct ly_ctx *ctx, struct yl_opt *yo)
             lyd_print_all(yo->out, merged_tree, yo->data_out_format, yo->data_print_options);
         }
 
+        if (yo->data_mem_usage && print_mem_usage(ctx, merged_tree, "merged data")) {
+            ret = LY_EOTHER;
+            goto cleanup;
+        }
+
         for (u = 0; u < yo->data_xpath.count; ++u) {
             xpath = (const char *)yo->data_xpath.objs[u];
 
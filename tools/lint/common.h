@@ -38,6 +38,11 @@
  */
 #define YL_DEFAULT_DATA_VALIDATE_OPTIONS LYD_VALIDATE_MULTI_ERROR
 
+/**
+ * @brief Number of the largest schema node consumers printed by --mem-usage.
+ */
+#define YL_MEM_USAGE_TOP_COUNT 10
+
 /**
  * @brief log error message
  */
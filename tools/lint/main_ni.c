@@ -202,6 +202,10 @@ help(int shortout)
     printf("  -m, --merge   Merge input data files into a single tree and validate at\n"
             "                once. The option has effect only for 'data' and 'config' TYPEs.\n\n");
 
+    printf("  -M, --mem-usage\n"
+            "                Print the memory used by the data tree(s) and the context, with\n"
+            "                the totals of the modules and the largest schema node consumers.\n\n");
+
     printf("  -y, --yang-library\n"
             "                Load and implement internal \"ietf-yang-library\" YANG module.\n"
             "                Note that this module includes definitions of mandatory state\n"
@@ -502,6 +506,7 @@ process_args(int argc, char *argv[], struct yl_opt *yo, struct ly_ctx **ctx)
         {"operational",       required_argument, NULL, 'O'},
         {"reply-rpc",         required_argument, NULL, 'R'},
         {"merge",             no_argument,       NULL, 'm'},
+        {"mem-usage",         no_argument,       NULL, 'M'},
         {"yang-library",      no_argument,       NULL, 'y'},
         {"yang-library-file", required_argument, NULL, 'Y'},
         {"extended-leafref",  no_argument,       NULL, 'X'},
@@ -517,7 +522,7 @@ process_args(int argc, char *argv[], struct yl_opt *yo, struct ly_ctx **ctx)
     yo->line_length = 0;
 
     opterr = 0;
-    while ((opt = getopt_long(argc, argv, "hvVQf:I:p:DF:iP:qs:neE:At:d:lL:o:O:R:myY:XJx:G:", options, &opt_index)) != -1) {
+    while ((opt = getopt_long(argc, argv, "hvVQf:I:p:DF:iP:qs:neE:At:d:lL:o:O:R:mMyY:XJx:G:", options, &opt_index)) != -1) {
         switch (opt) {
         case 'h': /* --help */
             help(0);
@@ -688,6 +693,10 @@ process_args(int argc, char *argv[], struct yl_opt *yo, struct ly_ctx **ctx)
             yo->data_merge = 1;
             break;
 
+        case 'M': /* --mem-usage */
+            yo->data_mem_usage = 1;
+            break;
+
         case 'y': /* --yang-library */
             yo->ctx_options &= ~LY_CTX_NO_YANGLIBRARY;
             break;
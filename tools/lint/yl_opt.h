@@ -119,6 +119,9 @@ struct yl_opt {
     /* flag for --merge option */
     uint8_t data_merge;
 
+    /* flag for --mem-usage option */
+    uint8_t data_mem_usage;
+
     /* value of --format in case of data format */
     LYD_FORMAT data_out_format;
 